@@ -0,0 +1,128 @@
+#include "AsyncFrameProcessor.h"
+
+#include <android/log.h>
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "FrameTracer.h"
+#include "RuntimeThreadScope.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+constexpr auto TAG = "VisionCameraOld";
+
+// the AsyncFrameProcessor of the Frame Processor that is running on this thread
+thread_local AsyncFrameProcessor* currentAsyncProcessor = nullptr;
+
+} // namespace
+
+AsyncFrameProcessor::AsyncFrameProcessor(std::shared_ptr<reanimated::WorkletRuntime> workletRuntime,
+                                         size_t maxInFlight,
+                                         std::shared_ptr<VisionCameraOldScheduler> scheduler,
+                                         std::shared_ptr<FrameProcessorStats> stats,
+                                         std::function<void(jsi::Runtime&)> installPlugins):
+  workletRuntime_(std::move(workletRuntime)),
+  scheduler_(std::move(scheduler)),
+  stats_(std::move(stats)),
+  installPlugins_(std::move(installPlugins)),
+  limiter_(maxInFlight) { }
+
+bool AsyncFrameProcessor::tryReserve() {
+  if (!limiter_.tryAcquire()) {
+    stats_->recordAsyncTaskSkipped();
+    return false;
+  }
+  return true;
+}
+
+void AsyncFrameProcessor::cancelReservation() {
+  limiter_.release();
+}
+
+void AsyncFrameProcessor::run(std::shared_ptr<FrameHostObjectBase> frame, std::shared_ptr<reanimated::ShareableWorklet> worklet) {
+  auto self = shared_from_this();
+  scheduler_->schedule(TaskLane::Plugin, [self, frame, worklet]() {
+    TraceScope trace("runAsync", frame->descriptor.timestamp);
+    try {
+      auto& runtime = self->workletRuntime_->getJSIRuntime();
+      RuntimeThreadScope runtimeScope(runtime);
+      self->installPlugins_(runtime);
+      auto hostObject = jsi::Object::createFromHostObject(runtime, frame);
+      self->workletRuntime_->runGuarded(worklet, hostObject);
+    } catch (const jsi::JSError& error) {
+      __android_log_print(ANDROID_LOG_ERROR, TAG, "runAsync() worklet threw an error! %s", error.getMessage().c_str());
+    } catch (const std::exception& exception) {
+      __android_log_print(ANDROID_LOG_ERROR, TAG, "runAsync() worklet threw a C++ error! %s", exception.what());
+    }
+    trace.end();
+
+    try {
+      // release the reference runAsync() took. Unless the worklet retained the Frame, this closes it.
+      frame->decrementRefCount();
+    } catch (const std::exception& exception) {
+      __android_log_print(ANDROID_LOG_ERROR, TAG, "runAsync() could not release the Frame! %s", exception.what());
+    }
+    self->stats_->recordAsyncTaskRun();
+    self->limiter_.release();
+  });
+}
+
+AsyncFrameProcessor::Scope::Scope(AsyncFrameProcessor* asyncProcessor): previous_(currentAsyncProcessor) {
+  currentAsyncProcessor = asyncProcessor;
+}
+
+AsyncFrameProcessor::Scope::~Scope() {
+  currentAsyncProcessor = previous_;
+}
+
+void AsyncFrameProcessor::installJSIBindings(jsi::Runtime& runtime) {
+  // __runAsync(frame: Frame, createWorklet: () => ShareableRef): boolean
+  auto runAsync = [](jsi::Runtime& runtime,
+                     const jsi::Value& thisValue,
+                     const jsi::Value* arguments,
+                     size_t count) -> jsi::Value {
+    auto asyncProcessor = currentAsyncProcessor;
+    if (asyncProcessor == nullptr) {
+      throw jsi::JSError(runtime, "runAsync() can only be called inside a Frame Processor, and requires the `frameProcessorMaxAsyncTasks` prop!");
+    }
+    if (count < 2 || !arguments[0].isObject() || !arguments[1].isObject()) {
+      throw jsi::JSError(runtime, "runAsync(): Expected a Frame and a worklet!");
+    }
+    auto frame = std::dynamic_pointer_cast<FrameHostObjectBase>(arguments[0].asObject(runtime).asHostObject(runtime));
+    if (frame == nullptr || !frame->descriptor.isValid) {
+      throw jsi::JSError(runtime, "runAsync() must be called with a valid Frame!");
+    }
+
+    // skipping is cheap: the worklet is only converted into a shareable if it will actually run.
+    if (!asyncProcessor->tryReserve()) {
+      return jsi::Value(false);
+    }
+    try {
+      auto shareable = arguments[1].asObject(runtime).asFunction(runtime).call(runtime);
+      auto worklet = reanimated::extractShareableOrThrow<reanimated::ShareableWorklet>(runtime, shareable,
+                                                                                       "runAsync() must be called with a worklet!");
+      frame->incrementRefCount();
+      asyncProcessor->run(std::move(frame), std::move(worklet));
+    } catch (const std::runtime_error& error) {
+      asyncProcessor->cancelReservation();
+      throw jsi::JSError(runtime, error.what());
+    } catch (...) {
+      asyncProcessor->cancelReservation();
+      throw;
+    }
+    return jsi::Value(true);
+  };
+  runtime.global().setProperty(runtime, "__runAsync", jsi::Function::createFromHostFunction(runtime,
+                                                                                          jsi::PropNameID::forAscii(runtime, "__runAsync"),
+                                                                                          2, // frame, createWorklet
+                                                                                          runAsync));
+}
+
+} // namespace vision
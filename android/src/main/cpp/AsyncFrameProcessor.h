@@ -0,0 +1,77 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <functional>
+#include <memory>
+
+#include "WorkletRuntime.h"
+
+#include "FrameHostObjectBase.h"
+#include "FrameProcessorStats.h"
+#include "InFlightLimiter.h"
+#include "VisionCameraOldScheduler.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Runs the worklets a Frame Processor hands off with `runAsync(frame, worklet)` on a background worklet runtime,
+ * so the Frame Processor itself can keep up with the Camera while heavy work runs at whatever rate it can sustain.
+ *
+ * The worklets run one after another on the TaskScheduler's Plugin lane, the only thread that enters the background runtime,
+ * which is also where `installPlugins` installs the plugins into it before the first worklet.
+ * At most `maxInFlight` of them are queued or running at once, runAsync() skips new ones beyond that.
+ * The Frame is retained until its worklet ran.
+ */
+class AsyncFrameProcessor : public std::enable_shared_from_this<AsyncFrameProcessor> {
+ public:
+  AsyncFrameProcessor(std::shared_ptr<reanimated::WorkletRuntime> workletRuntime,
+                      size_t maxInFlight,
+                      std::shared_ptr<VisionCameraOldScheduler> scheduler,
+                      std::shared_ptr<FrameProcessorStats> stats,
+                      std::function<void(jsi::Runtime&)> installPlugins);
+
+  /**
+   * Reserves room for a task, returns false (and counts it as skipped) if `maxInFlight` tasks are in flight already.
+   */
+  bool tryReserve();
+  /**
+   * Runs `worklet` with `frame` on the background runtime. Must only be called after tryReserve() returned true.
+   */
+  void run(std::shared_ptr<FrameHostObjectBase> frame, std::shared_ptr<reanimated::ShareableWorklet> worklet);
+  /**
+   * Gives back the room of a task that will not be run after all.
+   */
+  void cancelReservation();
+
+  /**
+   * Installs `__runAsync(frame, createWorklet)` into a Frame Processor runtime. It only works while a Frame Processor
+   * that has an AsyncFrameProcessor runs, see Scope.
+   */
+  static void installJSIBindings(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+  /**
+   * Makes `asyncProcessor` the one runAsync() uses on the current thread, while the Scope lives.
+   */
+  class Scope {
+   public:
+    explicit Scope(AsyncFrameProcessor* asyncProcessor);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    AsyncFrameProcessor* previous_;
+  };
+
+ private:
+  std::shared_ptr<reanimated::WorkletRuntime> workletRuntime_;
+  std::shared_ptr<VisionCameraOldScheduler> scheduler_;
+  std::shared_ptr<FrameProcessorStats> stats_;
+  std::function<void(jsi::Runtime&)> installPlugins_;
+  InFlightLimiter limiter_;
+};
+
+} // namespace vision
@@ -8,9 +8,18 @@
 #include <fbjni/fbjni.h>
 #include <jsi/jsi.h>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <regex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "FrameRetentionMonitor.h"
+#include "FrameTracer.h"
 
 namespace vision {
 
@@ -27,32 +36,352 @@ void CameraViewOld::registerNatives() {
     registerHybrid({
         makeNativeMethod("initHybrid", CameraViewOld::initHybrid),
         makeNativeMethod("frameProcessorCallback", CameraViewOld::frameProcessorCallback),
+        makeNativeMethod("configureFrameQueue", CameraViewOld::configureFrameQueue),
+        makeNativeMethod("configureFrameRate", CameraViewOld::configureFrameRate),
+        makeNativeMethod("configureChangeDetection", CameraViewOld::configureChangeDetection),
+        makeNativeMethod("configureFrameRetention", CameraViewOld::configureFrameRetention),
+    });
+}
+
+QueuedFrame::~QueuedFrame() {
+  // Frames are destroyed on the Camera thread (dropped), the Frame Processor thread (processed) or while re-configuring,
+  // all of which are attached to the JVM.
+  if (image) {
+    image->close();
+  }
+}
+
+CameraViewOld::~CameraViewOld() {
+  jni::ThreadScope::WithClassLoader([&] {
+    stopFrameReplay();
+    stopFrameProcessorThread();
+  });
+  auto recorder = std::atomic_exchange(&recorder_, std::shared_ptr<FrameRecorder>());
+  if (recorder != nullptr) {
+    recorder->stop();
+  }
+}
+
+void CameraViewOld::configureFrameQueue(jint depth, jint policy, jint timeoutMs) {
+  FrameQueueConfig config;
+  config.depth = static_cast<size_t>(std::max(depth, 1));
+  config.policy = static_cast<FrameDropPolicy>(std::clamp(policy, 0, static_cast<jint>(FrameDropPolicy::BlockWithTimeout)));
+  config.timeout = std::chrono::milliseconds(std::max(timeoutMs, 0));
+
+  startFrameQueue(config);
+  __android_log_print(ANDROID_LOG_INFO, TAG, "Frame Queue configured with depth %zu and policy %i.", config.depth, policy);
+}
+
+void CameraViewOld::startFrameQueue(const FrameQueueConfig& config) {
+  std::unique_lock lock(frameProcessorThreadMutex_);
+  stopFrameProcessorThreadLocked();
+
+  auto queue = std::make_shared<FrameQueue<QueuedFrame>>(config);
+  std::atomic_store(&frameQueue_, queue);
+  frameProcessorThread_ = std::thread([this, queue]() {
+    jni::ThreadScope::WithClassLoader([&] { runFrameProcessorThread(queue); });
+  });
+}
+
+void CameraViewOld::stopFrameProcessorThread() {
+  std::unique_lock lock(frameProcessorThreadMutex_);
+  stopFrameProcessorThreadLocked();
+}
+
+void CameraViewOld::stopFrameProcessorThreadLocked() {
+  auto queue = std::atomic_exchange(&frameQueue_, std::shared_ptr<FrameQueue<QueuedFrame>>());
+  if (queue == nullptr) {
+    return;
+  }
+  queue->close();
+  if (frameProcessorThread_.joinable()) {
+    frameProcessorThread_.join();
+  }
+  // closes all Frames that were still waiting
+  queue->drain([](std::unique_ptr<QueuedFrame>) { });
+}
+
+void CameraViewOld::runFrameProcessorThread(const std::shared_ptr<FrameQueue<QueuedFrame>>& queue) {
+  FrameTracer::shared().setThreadName("Frame Processor");
+  // only exists while the Frame Processor runs on more than one worklet runtime, and is only touched by this thread.
+  std::unique_ptr<FrameWorkerPool<DispatchedFrame>> workers;
+  while (!queue->isClosed()) {
+    auto frame = queue->pop(std::chrono::milliseconds(100));
+    if (frame != nullptr) {
+      dispatchFrame(std::move(frame), workers);
+    }
+    FrameRetentionMonitor::shared().check();
+  }
+  // waits for the Frames that are still being processed
+  workers = nullptr;
+}
+
+void CameraViewOld::dispatchFrame(std::unique_ptr<QueuedFrame> frame, std::unique_ptr<FrameWorkerPool<DispatchedFrame>>& workers) {
+  // hold on to the Frame Processor, so it can be swapped while this Frame is processed.
+  auto frameProcessor = std::atomic_load(&frameProcessor_);
+  if (frameProcessor == nullptr || frameProcessor->instances.empty()) {
+    return;
+  }
+  auto sequence = sequencer_.next();
+
+  auto instancesCount = frameProcessor->instances.size();
+  if (instancesCount == 1) {
+    if (workers != nullptr) {
+      // the previous Frame Processor ran in parallel, let its Frames finish first.
+      workers = nullptr;
+      rateController_.setParallelism(1);
+    }
+    processFrame(*frame, *frameProcessor, 0, sequence);
+    // `frame` goes out of scope here, which closes the ImageProxy if the Frame Processor didn't take it over.
+    return;
+  }
+
+  if (workers == nullptr || workers->size() != instancesCount || workers->getPolicy() != frameProcessor->dispatchPolicy) {
+    workers = nullptr;
+    auto process = [this](size_t worker, std::unique_ptr<DispatchedFrame> dispatched) {
+      processFrame(*dispatched->frame, *dispatched->frameProcessor, worker, dispatched->sequence);
+    };
+    // the workers close Frames and call Java plugins, so they are attached to the JVM once.
+    workers = std::make_unique<FrameWorkerPool<DispatchedFrame>>(instancesCount, frameProcessor->dispatchPolicy, process,
+                                                                 [](const std::function<void()>& loop) { jni::ThreadScope::WithClassLoader(loop); });
+    rateController_.setParallelism(instancesCount);
+  }
+  // waits until one of the workers is idle, meanwhile new Frames wait in the FrameQueue.
+  workers->dispatch(std::make_unique<DispatchedFrame>(DispatchedFrame { std::move(frame), frameProcessor, sequence }));
+}
+
+FrameQueueStats CameraViewOld::getFrameQueueStats() const {
+  auto queue = std::atomic_load(&frameQueue_);
+  return queue != nullptr ? queue->getStats() : FrameQueueStats();
+}
+
+void CameraViewOld::startFrameRecording(const std::string& path) {
+  auto recorder = std::make_shared<FrameRecorder>(path);
+  auto previous = std::atomic_exchange(&recorder_, recorder);
+  if (previous != nullptr) {
+    previous->stop();
+  }
+  __android_log_print(ANDROID_LOG_INFO, TAG, "Recording Frames to \"%s\"...", path.c_str());
+}
+
+FrameRecorderStats CameraViewOld::stopFrameRecording() {
+  auto recorder = std::atomic_exchange(&recorder_, std::shared_ptr<FrameRecorder>());
+  if (recorder == nullptr) {
+    throw std::runtime_error("Cannot stop the Frame recording, no Frames are being recorded!");
+  }
+  recorder->stop();
+  return recorder->getStats();
+}
+
+void CameraViewOld::startFrameReplay(const std::string& path, const FrameReplayOptions& options) {
+  auto recording = FrameRecording::open(path);
+  stopFrameReplay();
+
+  std::unique_lock lock(replayMutex_);
+  // The Camera only pushes into the queue while it is not replaying, so the new queue has a single producer again: the replay.
+  isReplaying_.store(true, std::memory_order_seq_cst);
+  auto queue = std::atomic_load(&frameQueue_);
+  startFrameQueue(queue != nullptr ? queue->getConfig() : FrameQueueConfig());
+
+  auto replay = std::make_shared<FrameReplay>(recording, options);
+  replay_ = replay;
+  replayThread_ = std::thread([this, replay]() {
+    jni::ThreadScope::WithClassLoader([&] { runFrameReplay(*replay); });
+  });
+  __android_log_print(ANDROID_LOG_INFO, TAG, "Replaying %zu Frames from \"%s\"...", recording->size(), path.c_str());
+}
+
+void CameraViewOld::stopFrameReplay() {
+  std::unique_lock lock(replayMutex_);
+  if (replay_ == nullptr) {
+    return;
+  }
+  replay_->stop();
+  if (replayThread_.joinable()) {
+    replayThread_.join();
+  }
+  replay_ = nullptr;
+}
+
+void CameraViewOld::runFrameReplay(FrameReplay& replay) {
+  FrameTracer::shared().setThreadName("Frame Replay");
+  replay.run([&](const FrameDescriptor& descriptor) {
+    auto queue = std::atomic_load(&frameQueue_);
+    if (queue == nullptr) {
+      return;
+    }
+    if (replay.getOptions().speed == ReplaySpeed::Maximum) {
+      // don't let the queue drop anything, the Frame Processor should see every recorded Frame.
+      while (!queue->isEmpty() && !queue->isClosed() && !replay.isStopped()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+      }
+    }
+    stats_->recordFrameDelivered();
+    auto frame = std::make_unique<QueuedFrame>(replay.getRecording(), descriptor, FrameTracer::now());
+    queue->push(std::move(frame), [this](std::unique_ptr<QueuedFrame>) {
+      stats_->recordFrameDropped();
     });
+  });
+  // the Camera's Frames are processed again
+  isReplaying_.store(false, std::memory_order_seq_cst);
 }
 
-void CameraViewOld::frameProcessorCallback(const alias_ref<JImageProxy::javaobject>& frame) {
-  if (frameProcessor_ == nullptr) {
+void CameraViewOld::configureFrameRate(jint mode, jdouble fixedFps, jdouble latencyBudgetMs) {
+  FrameRateConfig config;
+  config.mode = static_cast<FrameRateMode>(std::clamp(mode, 0, static_cast<jint>(FrameRateMode::LatencyBudget)));
+  config.fixedFps = fixedFps;
+  config.latencyBudget = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::milli>(latencyBudgetMs));
+  rateController_.configure(config);
+}
+
+void CameraViewOld::configureChangeDetection(jdouble threshold) {
+  changeDetector_.setThreshold(threshold);
+}
+
+void CameraViewOld::configureFrameRetention(jint maxRetainedFrames) {
+  // configured in place, Frames that are retained already keep their slots.
+  retentionBudget_->setMaxRetainedFrames(static_cast<size_t>(std::max(maxRetainedFrames, 0)));
+}
+
+void CameraViewOld::reportFrameRateDecision(const FrameRateDecision& decision) {
+  static const auto onFrameRateDecisionMethod =
+      javaClassStatic()->getMethod<void(jint, jdouble, jdouble, jdouble, jdouble, jdouble, jdouble)>("onFrameRateDecision");
+  auto toMilliseconds = [](std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  onFrameRateDecisionMethod(javaPart_.get(),
+                            static_cast<jint>(decision.mode),
+                            decision.fps,
+                            decision.previousFps,
+                            decision.suggestedFps,
+                            decision.cameraFps,
+                            toMilliseconds(decision.averageExecutionTime),
+                            toMilliseconds(decision.averageLatency));
+}
+
+void CameraViewOld::frameProcessorCallback(const alias_ref<JImageProxy::javaobject>& frame,
+                                           jint width,
+                                           jint height,
+                                           jint format,
+                                           jlong timestamp,
+                                           jint planesCount,
+                                           const alias_ref<JArrayClass<JByteBuffer::javaobject>>& planeBuffers,
+                                           const alias_ref<JArrayInt>& planeStrides,
+                                           jlong analyzerTimestamp) {
+  // System.nanoTime() and steady_clock both use CLOCK_MONOTONIC, so the analyzer's entry time can be recorded as a span.
+  if (FrameTracer::shared().isEnabled()) {
+    FrameTracer::shared().record("analyzer", analyzerTimestamp, FrameTracer::now(), timestamp);
+  }
+  TraceScope trace("frameProcessorCallback", timestamp);
+
+  // The Frame is owned by native code from here on, it is closed once the QueuedFrame is destroyed.
+  auto queue = std::atomic_load(&frameQueue_);
+  if (std::atomic_load(&frameProcessor_) == nullptr || queue == nullptr) {
     __android_log_write(ANDROID_LOG_WARN, TAG, "Called Frame Processor callback, but `frameProcessor` is null!");
+    frame->close();
     return;
   }
+  if (isReplaying_.load(std::memory_order_seq_cst)) {
+    // replayed Frames take the Camera's place
+    frame->close();
+    return;
+  }
+  stats_->recordFrameDelivered();
+  if (!rateController_.shouldProcess(timestamp)) {
+    stats_->recordFrameThrottled();
+    frame->close();
+    return;
+  }
+
+  // Fill the descriptor once so the Frame's getters never have to call back into Java.
+  FrameDescriptor descriptor;
+  descriptor.width = width;
+  descriptor.height = height;
+  descriptor.pixelFormat = JImageProxy::toPixelFormat(format);
+  descriptor.timestamp = timestamp;
+  descriptor.planesCount = std::min(static_cast<size_t>(planesCount), FrameDescriptor::kMaxPlanes);
+
+  // strides are packed as [rowStride0, pixelStride0, rowStride1, pixelStride1, ...]
+  jint strides[FrameDescriptor::kMaxPlanes * 2];
+  planeStrides->getRegion(0, static_cast<jsize>(descriptor.planesCount * 2), strides);
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    auto buffer = planeBuffers->getElement(i);
+    descriptor.planes[i].data = buffer->getDirectBytes();
+    descriptor.planes[i].size = buffer->getDirectSize();
+    descriptor.planes[i].rowStride = strides[i * 2];
+    descriptor.planes[i].pixelStride = strides[i * 2 + 1];
+  }
+  descriptor.isValid = true;
+
+  if (changeDetector_.isEnabled()) {
+    TraceScope changeTrace("changeDetection", timestamp);
+    if (!changeDetector_.hasChanged(descriptor)) {
+      stats_->recordFrameUnchanged();
+      frame->close();
+      return;
+    }
+  }
+
+  auto recorder = std::atomic_load(&recorder_);
+  if (recorder != nullptr) {
+    recorder->record(descriptor);
+  }
+
+  // dropped Frames are simply destroyed, which closes them on this (the Camera's) thread.
+  queue->push(std::make_unique<QueuedFrame>(frame, descriptor, analyzerTimestamp), [this](std::unique_ptr<QueuedFrame>) {
+    stats_->recordFrameDropped();
+  });
+}
+
+void CameraViewOld::processFrame(QueuedFrame& frame, const FrameProcessor& frameProcessor, size_t instance, uint64_t sequence) {
+  auto analyzerTimestamp = frame.analyzerTimestamp;
+  auto timestamp = frame.descriptor.timestamp;
+  auto start = std::chrono::steady_clock::now();
+  TFrameCommit commit;
+  runAndReportErrors([&]() { commit = frameProcessor.instances[instance](frame); });
+  auto executionTime = std::chrono::steady_clock::now() - start;
+
+  if (commit != nullptr) {
+    TraceScope waitTrace("waitForTurn", timestamp);
+    sequencer_.waitForTurn(sequence);
+    waitTrace.end();
+    runAndReportErrors(commit);
+    commit = nullptr;
+  }
+  sequencer_.complete(sequence);
+
+  auto end = std::chrono::steady_clock::now();
+  // System.nanoTime() and steady_clock both use CLOCK_MONOTONIC
+  auto latency = end.time_since_epoch() - std::chrono::nanoseconds(analyzerTimestamp);
+  stats_->recordExecutionTime(executionTime);
+  stats_->recordLatency(latency);
+
+  auto decision = rateController_.recordFrame(executionTime, latency);
+  if (decision.has_value()) {
+    reportFrameRateDecision(*decision);
+  }
+}
 
+void CameraViewOld::runAndReportErrors(const std::function<void()>& function) {
   try {
-    frameProcessor_(frame);
+    function();
   } catch (const jsi::JSError& error) {
     // TODO: jsi::JSErrors cannot be caught on Hermes. They crash the entire app.
+    stats_->recordFrameProcessorError();
     auto stack = std::regex_replace(error.getStack(), std::regex("\n"), "\n    ");
     __android_log_print(ANDROID_LOG_ERROR, TAG, "Frame Processor threw an error! %s\nIn: %s", error.getMessage().c_str(), stack.c_str());
   } catch (const std::exception& exception) {
+    stats_->recordFrameProcessorError();
     __android_log_print(ANDROID_LOG_ERROR, TAG, "Frame Processor threw a C++ error! %s", exception.what());
   }
 }
 
-void CameraViewOld::setFrameProcessor(const TFrameProcessor&& frameProcessor) {
-  frameProcessor_ = frameProcessor;
+void CameraViewOld::setFrameProcessor(FrameProcessor frameProcessor) {
+  std::atomic_store(&frameProcessor_, std::shared_ptr<const FrameProcessor>(std::make_shared<FrameProcessor>(std::move(frameProcessor))));
 }
 
 void vision::CameraViewOld::unsetFrameProcessor() {
-  frameProcessor_ = nullptr;
+  std::atomic_store(&frameProcessor_, std::shared_ptr<const FrameProcessor>());
 }
 
 } // namespace vision
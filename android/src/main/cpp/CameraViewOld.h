@@ -6,15 +6,77 @@
 
 #include <jni.h>
 #include <fbjni/fbjni.h>
+#include <fbjni/ByteBuffer.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "FrameChangeDetector.h"
+#include "FrameDescriptor.h"
+#include "FrameDispatcher.h"
+#include "FrameProcessorStats.h"
+#include "FrameQueue.h"
+#include "FrameRateController.h"
+#include "FrameRecording.h"
+#include "FrameRetentionBudget.h"
+#include "FrameSequencer.h"
+#include "FrameWorkerPool.h"
 #include "java-bindings/JImageProxy.h"
 
 namespace vision {
 
 using namespace facebook;
-using TFrameProcessor = std::function<void(jni::alias_ref<JImageProxy::javaobject>)>;
+
+/**
+ * A Frame waiting in the FrameQueue. The ImageProxy is closed once this is destroyed, no matter if the Frame
+ * has been processed or dropped - unless the Frame Processor took over the `image`.
+ *
+ * Replayed Frames have no `image`, their planes point into the `recording` instead.
+ */
+struct QueuedFrame {
+  jni::global_ref<JImageProxy> image;
+  std::shared_ptr<FrameRecording> recording;
+  FrameDescriptor descriptor;
+  // when the analyzer received the Frame, steady_clock nanoseconds
+  int64_t analyzerTimestamp;
+
+  QueuedFrame(jni::alias_ref<JImageProxy::javaobject> image, const FrameDescriptor& descriptor, int64_t analyzerTimestamp):
+    image(jni::make_global(image)), descriptor(descriptor), analyzerTimestamp(analyzerTimestamp) { }
+  QueuedFrame(std::shared_ptr<FrameRecording> recording, const FrameDescriptor& descriptor, int64_t analyzerTimestamp):
+    recording(std::move(recording)), descriptor(descriptor), analyzerTimestamp(analyzerTimestamp) { }
+  ~QueuedFrame();
+};
+
+// runs once all earlier Frames are done, see FrameProcessor::isInOrder
+using TFrameCommit = std::function<void()>;
+// processes a Frame on one worklet runtime, and returns what has to run in Frame order (or nullptr)
+using TFrameProcessor = std::function<TFrameCommit(QueuedFrame& frame)>;
+
+/**
+ * A Frame Processor, set up on one or more worklet runtimes. With more than one, Frames are processed in parallel,
+ * each runtime on its own thread and with one Frame at a time.
+ */
+struct FrameProcessor {
+  // one per worklet runtime
+  std::vector<TFrameProcessor> instances;
+  FrameDispatchPolicy dispatchPolicy = FrameDispatchPolicy::LeastLoaded;
+  // whether the commits returned by the instances run in the order the Frames arrived in
+  bool isInOrder = false;
+};
+
+/**
+ * A Frame on its way to one of the Frame Processor's worker threads, with the Frame Processor it was dispatched to.
+ */
+struct DispatchedFrame {
+  std::unique_ptr<QueuedFrame> frame;
+  std::shared_ptr<const FrameProcessor> frameProcessor;
+  uint64_t sequence;
+};
 
 class CameraViewOld : public jni::HybridClass<CameraViewOld> {
  public:
@@ -23,20 +85,86 @@ class CameraViewOld : public jni::HybridClass<CameraViewOld> {
   static jni::local_ref<jhybriddata> initHybrid(jni::alias_ref<jhybridobject> jThis);
   static void registerNatives();
 
-  // TODO: Use template<> to avoid heap allocation for std::function<>
-  void setFrameProcessor(const TFrameProcessor&& frameProcessor);
+  /**
+   * Replaces the Frame Processor. Safe to call from any thread, it never blocks the Camera or the Frame Processor thread:
+   * a Frame that is already being processed finishes on the Frame Processor it started with, which is destroyed afterwards.
+   */
+  void setFrameProcessor(FrameProcessor frameProcessor);
   void unsetFrameProcessor();
 
+  FrameQueueStats getFrameQueueStats() const;
+  std::shared_ptr<FrameProcessorStats> getFrameProcessorStats() const { return stats_; }
+  std::shared_ptr<FrameRetentionBudget> getFrameRetentionBudget() const { return retentionBudget_; }
+
+  /**
+   * Records every Frame that is passed to the Frame Processor into the file at `path`, until stopFrameRecording() is called.
+   */
+  void startFrameRecording(const std::string& path);
+  FrameRecorderStats stopFrameRecording();
+  /**
+   * Feeds the Frames recorded at `path` through the Frame Processor pipeline instead of the Camera's Frames,
+   * until all Frames have been replayed or stopFrameReplay() is called.
+   */
+  void startFrameReplay(const std::string& path, const FrameReplayOptions& options);
+  void stopFrameReplay();
+
+  ~CameraViewOld();
+
  private:
   friend HybridBase;
   jni::global_ref<CameraViewOld::javaobject> javaPart_;
-  TFrameProcessor frameProcessor_;
+  // accessed with std::atomic_load/atomic_store. Each Frame processes on a snapshot, the previous Frame Processor
+  // is destroyed once the last Frame holding it is done.
+  std::shared_ptr<const FrameProcessor> frameProcessor_;
+  // accessed with std::atomic_load/atomic_store, it is replaced when the queue is re-configured.
+  std::shared_ptr<FrameQueue<QueuedFrame>> frameQueue_;
+  // serializes (re-)starting and stopping the Frame Processor thread, which happens on the UI thread (configureFrameQueue)
+  // and the JS thread (startFrameReplay). Always taken after replayMutex_.
+  std::mutex frameProcessorThreadMutex_;
+  std::thread frameProcessorThread_;
+  std::shared_ptr<FrameProcessorStats> stats_ = std::make_shared<FrameProcessorStats>();
+  // numbers the Frames that are passed to the Frame Processor, so in-order commits can wait for earlier Frames
+  FrameSequencer sequencer_;
+  // decides which of the Camera's Frames are processed (`frameProcessorFps`)
+  FrameRateController rateController_;
+  // skips Frames that did not change since the last processed one (`frameProcessorChangeThreshold`)
+  FrameChangeDetector changeDetector_;
+  // the Frames that can be retained past their Frame Processor call (`frameProcessorMaxRetainedFrames`), shared with the Frames.
+  std::shared_ptr<FrameRetentionBudget> retentionBudget_ = std::make_shared<FrameRetentionBudget>();
+  // accessed with std::atomic_load/atomic_store, the Camera thread records while JS starts and stops the recording.
+  std::shared_ptr<FrameRecorder> recorder_;
+  // while true, the Camera's Frames are closed right away and only replayed Frames enter the FrameQueue.
+  std::atomic<bool> isReplaying_ { false };
+  std::mutex replayMutex_;
+  std::shared_ptr<FrameReplay> replay_;
+  std::thread replayThread_;
+
+  void configureFrameQueue(jint depth, jint policy, jint timeoutMs);
+  void startFrameQueue(const FrameQueueConfig& config);
+  void runFrameReplay(FrameReplay& replay); // NOLINT(runtime/references)
+  void configureFrameRate(jint mode, jdouble fixedFps, jdouble latencyBudgetMs);
+  void reportFrameRateDecision(const FrameRateDecision& decision);
+  void configureChangeDetection(jdouble threshold);
+  void configureFrameRetention(jint maxRetainedFrames);
+  void stopFrameProcessorThread();
+  void stopFrameProcessorThreadLocked();
+  void runFrameProcessorThread(const std::shared_ptr<FrameQueue<QueuedFrame>>& queue);
+  void processFrame(QueuedFrame& frame, const FrameProcessor& frameProcessor, size_t instance, uint64_t sequence); // NOLINT(runtime/references)
+  void dispatchFrame(std::unique_ptr<QueuedFrame> frame, std::unique_ptr<FrameWorkerPool<DispatchedFrame>>& workers); // NOLINT(runtime/references)
+  void runAndReportErrors(const std::function<void()>& function);
 
-  void frameProcessorCallback(const jni::alias_ref<JImageProxy::javaobject>& frame);
+  void frameProcessorCallback(const jni::alias_ref<JImageProxy::javaobject>& frame,
+                              jint width,
+                              jint height,
+                              jint format,
+                              jlong timestamp,
+                              jint planesCount,
+                              const jni::alias_ref<jni::JArrayClass<jni::JByteBuffer::javaobject>>& planeBuffers,
+                              const jni::alias_ref<jni::JArrayInt>& planeStrides,
+                              jlong analyzerTimestamp);
 
   explicit CameraViewOld(jni::alias_ref<CameraViewOld::jhybridobject> jThis) :
-    javaPart_(jni::make_global(jThis)),
-    frameProcessor_(nullptr)
+    javaPart_(jni::make_global(jThis))
   {}
 };
 
@@ -6,94 +6,66 @@
 #include <android/log.h>
 #include <fbjni/fbjni.h>
 #include <jni.h>
-#include <vector>
-#include <string>
+#include <memory>
+#include <utility>
+
+#include "java-bindings/JCroppedImageProxy.h"
 
 namespace vision {
 
 using namespace facebook;
 
-FrameHostObjectOld::FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image): frame(make_global(image)) { }
-
-FrameHostObjectOld::~FrameHostObjectOld() {
-  // Hermes' Garbage Collector (Hades GC) calls destructors on a separate Thread
-  // which might not be attached to JNI. Ensure that we use the JNI class loader when
-  // deallocating the `frame` HybridClass, because otherwise JNI cannot call the Java
-  // destroy() function.
-  jni::ThreadScope::WithClassLoader([&] { frame.reset(); });
-}
+FrameHostObjectOld::FrameHostObjectOld(jni::global_ref<JImageProxy>&& image, const FrameDescriptor& descriptor):
+  FrameHostObjectBase(descriptor), frame(std::move(image)) { }
 
-std::vector<jsi::PropNameID> FrameHostObjectOld::getPropertyNames(jsi::Runtime& rt) {
-  std::vector<jsi::PropNameID> result;
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("toString")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("isValid")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("width")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("height")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("bytesPerRow")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("planesCount")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("close")));
-  return result;
-}
+FrameHostObjectOld::FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image, const FrameDescriptor& descriptor):
+  FrameHostObjectBase(descriptor), frame(make_global(image)) { }
 
-jsi::Value FrameHostObjectOld::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
-  auto name = propNameId.utf8(runtime);
+FrameHostObjectOld::FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image, const FrameDescriptor& descriptor, bool isOwned):
+  FrameHostObjectBase(descriptor, isOwned), frame(make_global(image)), isOwned_(isOwned) { }
 
-  if (name == "toString") {
-    auto toString = [this] (jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {
-      if (!this->frame) {
-        return jsi::String::createFromUtf8(runtime, "[closed frame]");
-      }
-      auto width = this->frame->getWidth();
-      auto height = this->frame->getHeight();
-      auto str = std::to_string(width) + " x " + std::to_string(height) + " Frame";
-      return jsi::String::createFromUtf8(runtime, str);
-    };
-    return jsi::Function::createFromHostFunction(runtime, jsi::PropNameID::forUtf8(runtime, "toString"), 0, toString);
-  }
-  if (name == "close") {
-    auto close = [this] (jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {
-      if (!this->frame) {
-        throw jsi::JSError(runtime, "Trying to close an already closed frame! Did you call frame.close() twice?");
-      }
-      this->close();
-      return jsi::Value::undefined();
-    };
-    return jsi::Function::createFromHostFunction(runtime, jsi::PropNameID::forUtf8(runtime, "close"), 0, close);
-  }
+std::shared_ptr<FrameHostObjectOld> FrameHostObjectOld::wrapUnowned(jni::alias_ref<JImageProxy::javaobject> image) {
+  return std::shared_ptr<FrameHostObjectOld>(new FrameHostObjectOld(image, image->getFrameDescriptor(), false));
+}
 
-  if (name == "isValid") {
-    return jsi::Value(this->frame && this->frame->getIsValid());
+jni::local_ref<JImageProxy::javaobject> FrameHostObjectOld::getPluginImage(FrameHostObjectBase& frame) {
+  auto& source = static_cast<FrameHostObjectOld&>(frame.getSourceFrame());
+  if (&source == &frame) {
+    return jni::make_local(source.frame);
   }
-  if (name == "width") {
-    this->assertIsFrameStrong(runtime, name);
-    return jsi::Value(this->frame->getWidth());
-  }
-  if (name == "height") {
-    this->assertIsFrameStrong(runtime, name);
-    return jsi::Value(this->frame->getHeight());
-  }
-  if (name == "bytesPerRow") {
-    this->assertIsFrameStrong(runtime, name);
-    return jsi::Value(this->frame->getBytesPerRow());
-  }
-  if (name == "planesCount") {
-    this->assertIsFrameStrong(runtime, name);
-    return jsi::Value(this->frame->getPlanesCount());
-  }
-
-  return jsi::Value::undefined();
+  auto rect = frame.getSourceRect();
+  return JCroppedImageProxy::create(source.frame, rect.x, rect.y, rect.width, rect.height);
 }
 
-void FrameHostObjectOld::assertIsFrameStrong(jsi::Runtime& runtime, const std::string& accessedPropName) const {
-  if (!this->frame) {
-    auto message = "Cannot get `" + accessedPropName + "`, frame is already closed!";
-    throw jsi::JSError(runtime, message.c_str());
-  }
+FrameHostObjectOld::~FrameHostObjectOld() {
+  // Hermes' Garbage Collector (Hades GC) calls destructors on a separate Thread
+  // which might not be attached to JNI. Ensure that we use the JNI class loader when
+  // deallocating the `frame` HybridClass, because otherwise JNI cannot call the Java
+  // destroy() function.
+  jni::ThreadScope::WithClassLoader([&] {
+    if (frame && isOwned_ && descriptor.isValid) {
+      // The Frame was still retained when it got garbage collected, close it so the Camera gets its buffer back.
+      __android_log_write(ANDROID_LOG_WARN, TAG, "A Frame was garbage collected without being released, "
+                                                 "did you forget to call decrementRefCount()?");
+      frame->close();
+    }
+    frame.reset();
+  });
 }
 
 void FrameHostObjectOld::close() {
-  if (this->frame) {
-    this->frame->close();
+  if (this->descriptor.isValid) {
+    this->invalidate();
+    // the last reference might be released from any thread, e.g. by background work.
+    if (this->frame) {
+      jni::ThreadScope::WithClassLoader([&] {
+        if (isOwned_) {
+          this->frame->close();
+        }
+        this->frame.reset();
+      });
+    }
+    this->recording.reset();
   }
 }
 
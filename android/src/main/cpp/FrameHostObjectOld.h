@@ -7,33 +7,51 @@
 #include <jsi/jsi.h>
 #include <jni.h>
 #include <fbjni/fbjni.h>
-#include <vector>
-#include <string>
 
+#include <memory>
+
+#include "FrameDescriptor.h"
+#include "FrameHostObjectBase.h"
+#include "FrameRecording.h"
 #include "java-bindings/JImageProxy.h"
 
 namespace vision {
 
 using namespace facebook;
 
-class JSI_EXPORT FrameHostObjectOld : public jsi::HostObject {
+class JSI_EXPORT FrameHostObjectOld : public FrameHostObjectBase {
  public:
-  explicit FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image);
+  explicit FrameHostObjectOld(jni::global_ref<JImageProxy>&& image, const FrameDescriptor& descriptor);
+  explicit FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image, const FrameDescriptor& descriptor);
+  /**
+   * Wraps an ImageProxy that a plugin returned, e.g. the Frame it was called with or a Frame it created.
+   * The plugin keeps owning it: the wrapper is not tracked by the FrameRetentionMonitor and never closes the ImageProxy.
+   */
+  static std::shared_ptr<FrameHostObjectOld> wrapUnowned(jni::alias_ref<JImageProxy::javaobject> image);
+  /**
+   * The ImageProxy a Java plugin sees for the given Frame. A crop gets an ImageProxy of its own that shares the source Frame's
+   * image and has the crop as its crop rect (like CameraX' viewport), so concurrent plugin calls never modify a shared ImageProxy.
+   * The source Frame must not be a replayed Frame.
+   */
+  static jni::local_ref<JImageProxy::javaobject> getPluginImage(FrameHostObjectBase& frame); // NOLINT(runtime/references)
   ~FrameHostObjectOld();
 
  public:
-  jsi::Value get(jsi::Runtime &, const jsi::PropNameID &name) override;
-  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &rt) override;
-
-  void close();
+  void close() override;
 
  public:
+  // null for replayed Frames
   jni::global_ref<JImageProxy> frame;
+  // the recording a replayed Frame's planes point into
+  std::shared_ptr<FrameRecording> recording;
 
  private:
-  static auto constexpr TAG = "VisionCameraOld";
+  FrameHostObjectOld(jni::alias_ref<JImageProxy::javaobject> image, const FrameDescriptor& descriptor, bool isOwned);
 
-  void assertIsFrameStrong(jsi::Runtime& runtime, const std::string& accessedPropName) const; // NOLINT(runtime/references)
+ private:
+  // false if someone else closes the ImageProxy, see wrapUnowned()
+  bool isOwned_ = true;
+  static auto constexpr TAG = "VisionCameraOld";
 };
 
 } // namespace vision
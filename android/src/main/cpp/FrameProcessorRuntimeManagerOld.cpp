@@ -5,16 +5,34 @@
 #include "FrameProcessorRuntimeManagerOld.h"
 #include <android/log.h>
 #include <jni.h>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <utility>
 #include <string>
 
+#include "BufferPoolBindings.h"
 #include "CameraViewOld.h"
 #include "FrameHostObjectOld.h"
+#include "FrameProcessorPluginRegistryNative.h"
+#include "FrameProcessorStatsBindings.h"
+#include "FrameRecording.h"
+#include "FrameRetentionMonitor.h"
+#include "FrameTracer.h"
+#include "FrameTracerBindings.h"
 #include "JSIJNIConversion.h"
+#include "ParallelPluginRunner.h"
+#include "RuntimeThreadScope.h"
 #include "VisionCameraOldScheduler.h"
 #include "java-bindings/JImageProxy.h"
 #include "java-bindings/JFrameProcessorPlugin.h"
 
+#if VISION_CAMERA_BENCHMARKS
+#include "benchmarks/JSIJNIConversionBenchmark.h"
+#endif
+
 namespace vision {
 
 // type aliases
@@ -22,6 +40,136 @@ using TSelf = local_ref<HybridClass<vision::FrameProcessorRuntimeManagerOld>::jh
 using TJSCallInvokerHolder = jni::alias_ref<facebook::react::CallInvokerHolder::javaobject>;
 using TAndroidScheduler = jni::alias_ref<VisionCameraOldScheduler::javaobject>;
 
+namespace {
+
+/**
+ * A call of a Java plugin in runParallel(): the arguments are converted on the Frame Processor thread, the plugin
+ * is called on a worker (attached to the JVM), and its result is converted back on the Frame Processor thread.
+ */
+class JavaParallelPluginCall : public ParallelPluginCall {
+ public:
+  JavaParallelPluginCall(global_ref<JFrameProcessorPlugin::javaobject> plugin,
+                         global_ref<JImageProxy::javaobject> frame,
+                         global_ref<JArrayClass<jobject>> params):
+    plugin_(std::move(plugin)), frame_(std::move(frame)), params_(std::move(params)) { }
+
+  void run() override {
+    try {
+      result_ = make_global(plugin_->callback(frame_, params_));
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+  }
+
+  jsi::Value getResult(jsi::Runtime& runtime) override {
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    return JSIJNIConversion::convertJNIObjectToJSIValue(runtime, make_local(result_));
+  }
+
+ private:
+  global_ref<JFrameProcessorPlugin::javaobject> plugin_;
+  global_ref<JImageProxy::javaobject> frame_;
+  // global refs, local refs can't be used on the worker thread.
+  global_ref<JArrayClass<jobject>> params_;
+  global_ref<jobject> result_;
+  std::exception_ptr error_;
+};
+
+void addParallelPlugin(const global_ref<JFrameProcessorPlugin::javaobject>& plugin) {
+  auto name = plugin->getName();
+  ParallelPluginRunner::shared().addPlatformPlugin(name, [plugin, name](jsi::Runtime& runtime,
+                                                                        FrameHostObjectBase& frame,
+                                                                        const jsi::Value* arguments,
+                                                                        size_t count) -> std::unique_ptr<ParallelPluginCall> {
+    auto& source = static_cast<FrameHostObjectOld&>(frame.getSourceFrame());
+    if (!source.frame) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin __" + name + " cannot be called with a replayed Frame, "
+                                  "only C++ Frame Processor Plugins can process replayed Frames!");
+    }
+
+    TraceScope argumentsTrace("convertArguments", frame.descriptor.timestamp);
+    auto params = JArrayClass<jobject>::newArray(count);
+    for (size_t i = 0; i < count; i++) {
+      params->setElement(i, JSIJNIConversion::convertJSIValueToJNIObject(runtime, arguments[i]));
+    }
+    return std::make_unique<JavaParallelPluginCall>(plugin, make_global(FrameHostObjectOld::getPluginImage(frame)), make_global(params));
+  });
+}
+
+/**
+ * Creates the `__<name>` function of a Java plugin, which converts the arguments, calls the plugin and converts its result.
+ */
+jsi::Function createPluginFunction(jsi::Runtime& runtime, const global_ref<JFrameProcessorPlugin::javaobject>& pluginGlobal) { // NOLINT(runtime/references)
+  // name is always prefixed with two underscores (__)
+  auto name = "__" + pluginGlobal->getName();
+  auto traceName = FrameTracer::shared().intern("plugin " + name);
+
+  auto callback = [pluginGlobal, name, traceName](jsi::Runtime& runtime,
+                                 const jsi::Value& thisValue,
+                                 const jsi::Value* arguments,
+                                 size_t count) -> jsi::Value {
+    // Unbox object and get typed HostObject
+    auto boxedHostObject = arguments[0].asObject(runtime).asHostObject(runtime);
+    auto frameHostObject = dynamic_cast<FrameHostObjectBase*>(boxedHostObject.get());
+    if (frameHostObject == nullptr) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + " must be called with a Frame as its first argument!");
+    }
+    if (!frameHostObject->descriptor.isValid) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + " was called with a Frame that has already been released!");
+    }
+    // a crop shares its source Frame's ImageProxy
+    auto& source = static_cast<FrameHostObjectOld&>(frameHostObject->getSourceFrame());
+    if (!source.frame) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + " cannot be called with a replayed Frame, "
+                                  "only C++ Frame Processor Plugins can process replayed Frames!");
+    }
+
+    auto timestamp = frameHostObject->descriptor.timestamp;
+    auto stats = source.stats.get();
+
+    // parse params - we are offset by `1` because the frame is the first parameter.
+    TraceScope argumentsTrace("convertArguments", timestamp);
+    PluginStageScope argumentsStage(stats, PluginStage::ArgumentsConversion);
+    auto params = JArrayClass<jobject>::newArray(count - 1);
+    for (size_t i = 1; i < count; i++) {
+      params->setElement(i - 1, JSIJNIConversion::convertJSIValueToJNIObject(runtime, arguments[i]));
+    }
+    argumentsStage.end();
+    argumentsTrace.end();
+
+    auto image = FrameHostObjectOld::getPluginImage(*frameHostObject);
+
+    // call implemented virtual method
+    TraceScope pluginTrace(traceName, timestamp);
+    PluginStageScope callStage(stats, PluginStage::Call);
+    jni::local_ref<jobject> result;
+    try {
+      result = pluginGlobal->callback(image, params);
+    } catch (...) {
+      if (stats != nullptr) {
+        stats->recordPluginError();
+      }
+      throw;
+    }
+    callStage.end();
+    pluginTrace.end();
+
+    // convert result from JNI to JSI value
+    TraceScope resultTrace("convertResult", timestamp);
+    PluginStageScope resultStage(stats, PluginStage::ResultConversion);
+    return JSIJNIConversion::convertJNIObjectToJSIValue(runtime, result);
+  };
+
+  return jsi::Function::createFromHostFunction(runtime,
+                                               jsi::PropNameID::forAscii(runtime, name),
+                                               1, // frame
+                                               callback);
+}
+
+} // namespace
+
 // JNI binding
 void vision::FrameProcessorRuntimeManagerOld::registerNatives() {
   registerHybrid({
@@ -66,14 +214,21 @@ void vision::FrameProcessorRuntimeManagerOld::initializeRuntime() {
 }
 
 global_ref<CameraViewOld::javaobject> FrameProcessorRuntimeManagerOld::findCameraViewOldById(int viewId) {
-  static const auto findCameraViewOldByIdMethod = javaPart_->getClass()->getMethod<CameraViewOld(jint)>("findCameraViewOldById");
-  auto weakCameraViewOld = findCameraViewOldByIdMethod(javaPart_.get(), viewId);
-  return make_global(weakCameraViewOld);
-}
+  auto cached = cameraViews_.find(viewId);
+  if (cached != cameraViews_.end()) {
+    auto cameraView = cached->second.lockLocal();
+    if (cameraView) {
+      return make_global(cameraView);
+    }
+    // the view has been garbage collected
+    cameraViews_.erase(cached);
+  }
 
-void FrameProcessorRuntimeManagerOld::registerPlugins() {
-  static const auto registerPluginsMethod = javaPart_->getClass()->getMethod<void()>("registerPlugins");
-  registerPluginsMethod(javaPart_.get());
+  static const auto findCameraViewOldByIdMethod = javaPart_->getClass()->getMethod<CameraViewOld(jint)>("findCameraViewOldById");
+  auto cameraView = findCameraViewOldByIdMethod(javaPart_.get(), viewId);
+  // weak, so the cache doesn't keep unmounted views alive. React never reuses a viewTag.
+  cameraViews_[viewId] = make_weak(cameraView);
+  return make_global(cameraView);
 }
 
 void FrameProcessorRuntimeManagerOld::logErrorToJS(const std::string& message) {
@@ -98,19 +253,58 @@ void FrameProcessorRuntimeManagerOld::logErrorToJS(const std::string& message) {
 void FrameProcessorRuntimeManagerOld::setFrameProcessor(jsi::Runtime& rnRuntime,
                                                      int viewTag,
                                                      const jsi::Value& frameProcessor,
-                                                     const jsi::Value& workletRuntimeValue) {
+                                                     const jsi::Value& workletRuntimeValue,
+                                                     const jsi::Value& options) {
   __android_log_write(ANDROID_LOG_INFO, TAG,
                       "Setting new Frame Processor...");
 
-  workletRuntime_ = reanimated::extractWorkletRuntime(rnRuntime, workletRuntimeValue);
-  jsi::Runtime &visionRuntime = workletRuntime_->getJSIRuntime();
-  visionRuntime.global().setProperty(visionRuntime, "_FRAME_PROCESSOR", jsi::Value(true));
-
-  registerPlugins();
-
+  // either a single runtime, or an array of runtimes to process Frames on in parallel.
+  workletRuntimes_.clear();
+  auto workletRuntimeObject = workletRuntimeValue.asObject(rnRuntime);
+  if (workletRuntimeObject.isArray(rnRuntime)) {
+    auto array = workletRuntimeObject.asArray(rnRuntime);
+    for (size_t i = 0; i < array.size(rnRuntime); i++) {
+      workletRuntimes_.push_back(reanimated::extractWorkletRuntime(rnRuntime, array.getValueAtIndex(rnRuntime, i)));
+    }
+  } else {
+    workletRuntimes_.push_back(reanimated::extractWorkletRuntime(rnRuntime, workletRuntimeValue));
+  }
+  if (workletRuntimes_.empty()) {
+    throw jsi::JSError(rnRuntime, "Camera::setFrameProcessor: At least one worklet runtime is required!");
+  }
   // find camera view
   auto cameraView = findCameraViewOldById(viewTag);
-  __android_log_write(ANDROID_LOG_INFO, TAG, "Found CameraViewOld!");
+
+  FrameProcessor processor;
+  std::shared_ptr<AsyncFrameProcessor> asyncProcessor;
+  if (options.isObject()) {
+    auto optionsObject = options.asObject(rnRuntime);
+    auto dispatch = optionsObject.getProperty(rnRuntime, "dispatch");
+    if (dispatch.isString()) {
+      auto name = dispatch.asString(rnRuntime).utf8(rnRuntime);
+      if (name == "round-robin") {
+        processor.dispatchPolicy = FrameDispatchPolicy::RoundRobin;
+      } else if (name == "least-loaded") {
+        processor.dispatchPolicy = FrameDispatchPolicy::LeastLoaded;
+      } else {
+        throw jsi::JSError(rnRuntime, "Camera::setFrameProcessor: Unknown dispatch \"" + name + "\"! Expected round-robin or least-loaded.");
+      }
+    }
+    auto inOrder = optionsObject.getProperty(rnRuntime, "inOrder");
+    processor.isInOrder = inOrder.isBool() && inOrder.getBool();
+
+    // runAsync() hands work off to a background runtime, if the Camera allows any async tasks.
+    auto maxAsyncTasks = optionsObject.getProperty(rnRuntime, "maxAsyncTasks");
+    auto asyncRuntimeValue = optionsObject.getProperty(rnRuntime, "asyncRuntime");
+    if (maxAsyncTasks.isNumber() && maxAsyncTasks.asNumber() >= 1 && asyncRuntimeValue.isObject()) {
+      auto asyncRuntime = reanimated::extractWorkletRuntime(rnRuntime, asyncRuntimeValue);
+      asyncProcessor = std::make_shared<AsyncFrameProcessor>(asyncRuntime,
+                                                             static_cast<size_t>(maxAsyncTasks.asNumber()),
+                                                             scheduler_,
+                                                             cameraView->cthis()->getFrameProcessorStats(),
+                                                             createPluginInstaller());
+    }
+  }
 
   // convert jsi::Function to a ShareableValue (can be shared across runtimes)
   __android_log_write(ANDROID_LOG_INFO, TAG,
@@ -118,19 +312,66 @@ void FrameProcessorRuntimeManagerOld::setFrameProcessor(jsi::Runtime& rnRuntime,
   auto shareableWorklet = reanimated::extractShareableOrThrow<reanimated::ShareableWorklet>(rnRuntime, frameProcessor);
   __android_log_write(ANDROID_LOG_INFO, TAG, "Successfully created worklet!");
 
-  scheduler_->scheduleOnUI([=]() {
-      // cast worklet to a jsi::Function for the new runtime
-      // assign lambda to frame processor
-      cameraView->cthis()->setFrameProcessor([=](jni::alias_ref<JImageProxy::javaobject> frame) {
-          // create HostObject which holds the Frame (JImageProxy)
-          auto frameHostObject = std::make_shared<FrameHostObjectOld>(frame);
-          jsi::Runtime &runtime = workletRuntime_->getJSIRuntime();
-          auto hostObject = jsi::Object::createFromHostObject(runtime, frameHostObject);
-          workletRuntime_->runGuarded(shareableWorklet, hostObject);
-      });
-
-      __android_log_write(ANDROID_LOG_INFO, TAG, "Frame Processor set!");
-  });
+  for (const auto& workletRuntime : workletRuntimes_) {
+    processor.instances.push_back(createFrameProcessor(workletRuntime,
+                                                       shareableWorklet,
+                                                       asyncProcessor,
+                                                       cameraView->cthis()->getFrameProcessorStats(),
+                                                       cameraView->cthis()->getFrameRetentionBudget(),
+                                                       processor.isInOrder));
+  }
+
+  // The swap is atomic, so it happens right here on the JS thread - in order with unsetFrameProcessor().
+  // The Frame Processor owns its runtimes, a later setFrameProcessor() with other runtimes doesn't affect it.
+  // Nothing here touches the worklet runtimes, each instance installs the plugins on its runtime's thread before its first Frame.
+  cameraView->cthis()->setFrameProcessor(std::move(processor));
+
+  __android_log_print(ANDROID_LOG_INFO, TAG, "Frame Processor set on %zu runtime(s)!", workletRuntimes_.size());
+}
+
+TFrameProcessor FrameProcessorRuntimeManagerOld::createFrameProcessor(const std::shared_ptr<reanimated::WorkletRuntime>& workletRuntime,
+                                                                      const std::shared_ptr<reanimated::ShareableWorklet>& shareableWorklet,
+                                                                      const std::shared_ptr<AsyncFrameProcessor>& asyncProcessor,
+                                                                      const std::shared_ptr<FrameProcessorStats>& stats,
+                                                                      const std::shared_ptr<FrameRetentionBudget>& retentionBudget,
+                                                                      bool isInOrder) {
+  auto pluginInstaller = createPluginInstaller();
+  return [workletRuntime, shareableWorklet, asyncProcessor, stats, retentionBudget, isInOrder, pluginInstaller](QueuedFrame& frame) -> TFrameCommit {
+      jsi::Runtime &runtime = workletRuntime->getJSIRuntime();
+      RuntimeThreadScope runtimeScope(runtime);
+      pluginInstaller(runtime);
+
+      // create HostObject which takes over the Frame (JImageProxy), it is closed once the last reference is released.
+      auto timestamp = frame.descriptor.timestamp;
+      TraceScope createTrace("createHostObject", timestamp);
+      auto frameHostObject = std::make_shared<FrameHostObjectOld>(std::move(frame.image), frame.descriptor);
+      frameHostObject->recording = std::move(frame.recording);
+      frameHostObject->stats = stats;
+      frameHostObject->retentionBudget = retentionBudget;
+      auto hostObject = jsi::Object::createFromHostObject(runtime, frameHostObject);
+      createTrace.end();
+      jsi::Value result;
+      try {
+        TraceScope trace("runGuarded", timestamp);
+        AsyncFrameProcessor::Scope asyncScope(asyncProcessor.get());
+        result = workletRuntime->runGuarded(shareableWorklet, hostObject);
+      } catch (...) {
+        frameHostObject->decrementRefCount();
+        throw;
+      }
+
+      // Release the Frame Processor's reference. Unless the worklet retained the Frame, this closes it right away.
+      frameHostObject->decrementRefCount();
+
+      // In order, a function returned by the Frame Processor runs once all earlier Frames are done - still on this runtime's thread.
+      if (!isInOrder || !result.isObject() || !result.getObject(runtime).isFunction(runtime)) {
+        return nullptr;
+      }
+      auto commit = std::make_shared<jsi::Function>(result.getObject(runtime).getFunction(runtime));
+      return [workletRuntime, commit]() {
+        commit->call(workletRuntime->getJSIRuntime());
+      };
+  };
 }
 
 void FrameProcessorRuntimeManagerOld::unsetFrameProcessor(int viewTag) {
@@ -157,6 +398,9 @@ void FrameProcessorRuntimeManagerOld::installJSIBindings() {
 
   auto& jsiRuntime = *runtime_;
 
+  // runParallel() calls Java plugins on the workers
+  ParallelPluginRunner::shared().setWorkerRunner([](const std::function<void()>& loop) { jni::ThreadScope::WithClassLoader(loop); });
+
   auto setFrameProcessor = [this](jsi::Runtime &runtime,
                                   const jsi::Value &thisValue,
                                   const jsi::Value *arguments,
@@ -174,13 +418,14 @@ void FrameProcessorRuntimeManagerOld::installJSIBindings() {
     }
     if (!arguments[2].isObject()) {
       throw jsi::JSError(runtime,
-                         "Camera::setFrameProcessor: Third argument ('workletRuntime') must be an object!");
+                         "Camera::setFrameProcessor: Third argument ('workletRuntime') must be an object or an array!");
     }
 
     double viewTag = arguments[0].asNumber();
     const jsi::Value& frameProcessor = arguments[1];
     const jsi::Value& workletRuntimeValue = arguments[2];
-    this->setFrameProcessor(runtime, static_cast<int>(viewTag), frameProcessor, workletRuntimeValue);
+    auto options = count > 3 ? jsi::Value(runtime, arguments[3]) : jsi::Value::undefined();
+    this->setFrameProcessor(runtime, static_cast<int>(viewTag), frameProcessor, workletRuntimeValue, options);
 
     return jsi::Value::undefined();
   };
@@ -190,7 +435,7 @@ void FrameProcessorRuntimeManagerOld::installJSIBindings() {
                                       jsiRuntime,
                                       jsi::PropNameID::forAscii(jsiRuntime,
                                                                 "setFrameProcessor"),
-                                      2,  // viewTag, frameProcessor
+                                      4,  // viewTag, frameProcessor, workletRuntime(s), options
                                       setFrameProcessor));
 
 
@@ -218,49 +463,218 @@ void FrameProcessorRuntimeManagerOld::installJSIBindings() {
                                       1, // viewTag
                                       unsetFrameProcessor));
 
-  __android_log_write(ANDROID_LOG_INFO, TAG, "Finished installing JSI bindings!");
-}
-
-void FrameProcessorRuntimeManagerOld::registerPlugin(alias_ref<JFrameProcessorPlugin::javaobject> plugin) {
-  // _runtimeManager might never be null, but we can never be too sure.
-  if (!workletRuntime_) {
-    throw std::runtime_error("Tried to register plugin before initializing JS runtime! Call `initializeRuntime()` first.");
-  }
+  auto getFrameProcessorQueueStats = [this](jsi::Runtime &runtime,
+                                            const jsi::Value &thisValue,
+                                            const jsi::Value *arguments,
+                                            size_t count) -> jsi::Value {
+    if (!arguments[0].isNumber()) {
+      throw jsi::JSError(runtime,
+                         "Camera::getFrameProcessorQueueStats: First argument ('viewTag') must be a number!");
+    }
 
-  auto& runtime = workletRuntime_->getJSIRuntime();
+    auto viewTag = arguments[0].asNumber();
+    auto cameraView = findCameraViewOldById(static_cast<int>(viewTag));
+    auto stats = cameraView->cthis()->getFrameQueueStats();
+
+    auto result = jsi::Object(runtime);
+    result.setProperty(runtime, "enqueued", jsi::Value(static_cast<double>(stats.enqueued)));
+    result.setProperty(runtime, "dropped", jsi::Value(static_cast<double>(stats.dropped)));
+    result.setProperty(runtime, "processed", jsi::Value(static_cast<double>(stats.processed)));
+    return result;
+  };
+  jsiRuntime.global().setProperty(jsiRuntime,
+                                  "getFrameProcessorQueueStats",
+                                  jsi::Function::createFromHostFunction(
+                                      jsiRuntime,
+                                      jsi::PropNameID::forAscii(jsiRuntime,
+                                                                "getFrameProcessorQueueStats"),
+                                      1, // viewTag
+                                      getFrameProcessorQueueStats));
 
-  // we need a strong reference on the plugin, make_global does that.
-  auto pluginGlobal = make_global(plugin);
-  // name is always prefixed with two underscores (__)
-  auto name = "__" + pluginGlobal->getName();
+  // startFrameRecording(viewTag: number, path: string)
+  auto startFrameRecording = [this](jsi::Runtime &runtime,
+                                    const jsi::Value &thisValue,
+                                    const jsi::Value *arguments,
+                                    size_t count) -> jsi::Value {
+    if (count < 2 || !arguments[0].isNumber() || !arguments[1].isString()) {
+      throw jsi::JSError(runtime,
+                         "Camera::startFrameRecording: Expected a viewTag (number) and a path (string)!");
+    }
+    auto viewTag = static_cast<int>(arguments[0].asNumber());
+    auto path = arguments[1].asString(runtime).utf8(runtime);
+    try {
+      findCameraViewOldById(viewTag)->cthis()->startFrameRecording(path);
+    } catch (const std::runtime_error& error) {
+      throw jsi::JSError(runtime, error.what());
+    }
+    return jsi::Value::undefined();
+  };
+  jsiRuntime.global().setProperty(jsiRuntime,
+                                  "startFrameRecording",
+                                  jsi::Function::createFromHostFunction(
+                                      jsiRuntime,
+                                      jsi::PropNameID::forAscii(jsiRuntime,
+                                                                "startFrameRecording"),
+                                      2, // viewTag, path
+                                      startFrameRecording));
+
+  // stopFrameRecording(viewTag: number): FrameRecordingStats
+  auto stopFrameRecording = [this](jsi::Runtime &runtime,
+                                   const jsi::Value &thisValue,
+                                   const jsi::Value *arguments,
+                                   size_t count) -> jsi::Value {
+    if (count < 1 || !arguments[0].isNumber()) {
+      throw jsi::JSError(runtime,
+                         "Camera::stopFrameRecording: First argument ('viewTag') must be a number!");
+    }
+    auto viewTag = static_cast<int>(arguments[0].asNumber());
+    FrameRecorderStats stats;
+    try {
+      stats = findCameraViewOldById(viewTag)->cthis()->stopFrameRecording();
+    } catch (const std::runtime_error& error) {
+      throw jsi::JSError(runtime, error.what());
+    }
 
-  __android_log_print(ANDROID_LOG_INFO, TAG, "Installing Frame Processor Plugin \"%s\"...", name.c_str());
+    auto result = jsi::Object(runtime);
+    result.setProperty(runtime, "framesRecorded", jsi::Value(static_cast<double>(stats.framesRecorded)));
+    result.setProperty(runtime, "framesDropped", jsi::Value(static_cast<double>(stats.framesDropped)));
+    result.setProperty(runtime, "bytesWritten", jsi::Value(static_cast<double>(stats.bytesWritten)));
+    return result;
+  };
+  jsiRuntime.global().setProperty(jsiRuntime,
+                                  "stopFrameRecording",
+                                  jsi::Function::createFromHostFunction(
+                                      jsiRuntime,
+                                      jsi::PropNameID::forAscii(jsiRuntime,
+                                                                "stopFrameRecording"),
+                                      1, // viewTag
+                                      stopFrameRecording));
 
-  auto callback = [pluginGlobal](jsi::Runtime& runtime,
-                                 const jsi::Value& thisValue,
-                                 const jsi::Value* arguments,
+  // startFrameReplay(viewTag: number, path: string, options?: { speed?: 'recorded' | 'maximum', loop?: boolean })
+  auto startFrameReplay = [this](jsi::Runtime &runtime,
+                                 const jsi::Value &thisValue,
+                                 const jsi::Value *arguments,
                                  size_t count) -> jsi::Value {
-    // Unbox object and get typed HostObject
-    auto boxedHostObject = arguments[0].asObject(runtime).asHostObject(runtime);
-    auto frameHostObject = static_cast<FrameHostObjectOld*>(boxedHostObject.get());
+    if (count < 2 || !arguments[0].isNumber() || !arguments[1].isString()) {
+      throw jsi::JSError(runtime,
+                         "Camera::startFrameReplay: Expected a viewTag (number) and a path (string)!");
+    }
+    auto viewTag = static_cast<int>(arguments[0].asNumber());
+    auto path = arguments[1].asString(runtime).utf8(runtime);
+
+    FrameReplayOptions options;
+    if (count > 2 && arguments[2].isObject()) {
+      auto optionsObject = arguments[2].asObject(runtime);
+      auto speed = optionsObject.getProperty(runtime, "speed");
+      if (speed.isString()) {
+        auto name = speed.asString(runtime).utf8(runtime);
+        if (name == "recorded") {
+          options.speed = ReplaySpeed::Recorded;
+        } else if (name == "maximum") {
+          options.speed = ReplaySpeed::Maximum;
+        } else {
+          throw jsi::JSError(runtime, "Camera::startFrameReplay: Unknown speed \"" + name + "\"! Expected recorded or maximum.");
+        }
+      }
+      auto loop = optionsObject.getProperty(runtime, "loop");
+      options.loop = loop.isBool() && loop.getBool();
+    }
 
-    // parse params - we are offset by `1` because the frame is the first parameter.
-    auto params = JArrayClass<jobject>::newArray(count - 1);
-    for (size_t i = 1; i < count; i++) {
-      params->setElement(i - 1, JSIJNIConversion::convertJSIValueToJNIObject(runtime, arguments[i]));
+    try {
+      findCameraViewOldById(viewTag)->cthis()->startFrameReplay(path, options);
+    } catch (const std::runtime_error& error) {
+      throw jsi::JSError(runtime, error.what());
+    }
+    return jsi::Value::undefined();
+  };
+  jsiRuntime.global().setProperty(jsiRuntime,
+                                  "startFrameReplay",
+                                  jsi::Function::createFromHostFunction(
+                                      jsiRuntime,
+                                      jsi::PropNameID::forAscii(jsiRuntime,
+                                                                "startFrameReplay"),
+                                      3, // viewTag, path, options
+                                      startFrameReplay));
+
+  // stopFrameReplay(viewTag: number)
+  auto stopFrameReplay = [this](jsi::Runtime &runtime,
+                                const jsi::Value &thisValue,
+                                const jsi::Value *arguments,
+                                size_t count) -> jsi::Value {
+    if (count < 1 || !arguments[0].isNumber()) {
+      throw jsi::JSError(runtime,
+                         "Camera::stopFrameReplay: First argument ('viewTag') must be a number!");
     }
+    auto viewTag = static_cast<int>(arguments[0].asNumber());
+    findCameraViewOldById(viewTag)->cthis()->stopFrameReplay();
+    return jsi::Value::undefined();
+  };
+  jsiRuntime.global().setProperty(jsiRuntime,
+                                  "stopFrameReplay",
+                                  jsi::Function::createFromHostFunction(
+                                      jsiRuntime,
+                                      jsi::PropNameID::forAscii(jsiRuntime,
+                                                                "stopFrameReplay"),
+                                      1, // viewTag
+                                      stopFrameReplay));
 
-    // call implemented virtual method
-    auto result = pluginGlobal->callback(frameHostObject->frame, params);
+  installBufferPoolBindings(jsiRuntime);
+  installFrameTracerBindings(jsiRuntime);
+  installFrameProcessorStatsBindings(jsiRuntime, [this](int viewTag) {
+    auto cameraView = findCameraViewOldById(viewTag);
+    return cameraView->cthis()->getFrameProcessorStats();
+  });
 
-    // convert result from JNI to JSI value
-    return JSIJNIConversion::convertJNIObjectToJSIValue(runtime, result);
+  FrameRetentionMonitor::shared().setListener([](const FrameRetentionReport& report) {
+    __android_log_print(ANDROID_LOG_WARN, TAG,
+                        "Frame %lld has been held for %lld ms (%zu Frames held in total)! "
+                        "The Camera stalls once all of its buffers are held, did you forget to call frame.decrementRefCount()?",
+                        static_cast<long long>(report.timestamp), static_cast<long long>(report.heldFor.count()), report.framesHeld);
+  });
+
+  __android_log_write(ANDROID_LOG_INFO, TAG, "Finished installing JSI bindings!");
+}
+
+void FrameProcessorRuntimeManagerOld::registerPlugin(alias_ref<jclass>, alias_ref<JFrameProcessorPlugin::javaobject> plugin) {
+  // we need a strong reference on the plugin, make_global does that.
+  auto pluginGlobal = make_global(plugin);
+  auto name = pluginGlobal->getName();
+  __android_log_print(ANDROID_LOG_INFO, TAG, "Registering Frame Processor Plugin \"%s\"...", name.c_str());
+
+  FrameProcessorPluginRegistryNative::shared().addPlatformPlugin(name, [pluginGlobal](jsi::Runtime& runtime) {
+    return createPluginFunction(runtime, pluginGlobal);
+  });
+  addParallelPlugin(pluginGlobal);
+}
+
+std::function<void(jsi::Runtime&)> FrameProcessorRuntimeManagerOld::createPluginInstaller() {
+  // only used on the runtime's thread. Empty until the plugins have been installed once.
+  auto installedVersion = std::make_shared<std::optional<uint64_t>>();
+  return [installedVersion](jsi::Runtime& runtime) {
+    // read before installing, so a plugin that is added while installing is picked up by the next call.
+    auto version = FrameProcessorPluginRegistryNative::shared().getVersion();
+    if (*installedVersion == version) {
+      return;
+    }
+    installPlugins(runtime);
+    *installedVersion = version;
   };
+}
 
-  runtime.global().setProperty(runtime, name.c_str(), jsi::Function::createFromHostFunction(runtime,
-                                                                                            jsi::PropNameID::forAscii(runtime, name),
-                                                                                            1, // frame
-                                                                                            callback));
+void FrameProcessorRuntimeManagerOld::installPlugins(jsi::Runtime& visionRuntime) {
+  // plugins are resolved on their first use, this only adds the ones the runtime doesn't know yet.
+  FrameProcessorPluginRegistryNative::shared().installPlugins(visionRuntime);
+  if (FrameProcessorPluginRegistryNative::arePluginsInstalled(visionRuntime)) {
+    return;
+  }
+
+  visionRuntime.global().setProperty(visionRuntime, "_FRAME_PROCESSOR", jsi::Value(true));
+  AsyncFrameProcessor::installJSIBindings(visionRuntime);
+  ParallelPluginRunner::shared().installJSIBindings(visionRuntime);
+#if VISION_CAMERA_BENCHMARKS
+  installJSIJNIConversionBenchmark(visionRuntime);
+#endif
+  FrameProcessorPluginRegistryNative::markPluginsInstalled(visionRuntime);
 }
 
 } // namespace vision
@@ -7,11 +7,15 @@
 #include <fbjni/fbjni.h>
 #include <jsi/jsi.h>
 #include <ReactCommon/CallInvokerHolder.h>
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "WorkletRuntime.h"
 
+#include "AsyncFrameProcessor.h"
 #include "CameraViewOld.h"
 #include "VisionCameraOldScheduler.h"
 #include "java-bindings/JFrameProcessorPlugin.h"
@@ -45,20 +49,42 @@ class FrameProcessorRuntimeManagerOld : public jni::HybridClass<FrameProcessorRu
   jni::global_ref<FrameProcessorRuntimeManagerOld::javaobject> javaPart_;
   jsi::Runtime* runtime_;
   std::shared_ptr<facebook::react::CallInvoker> jsCallInvoker_;
-  std::shared_ptr<reanimated::WorkletRuntime> workletRuntime_;
+  // the runtimes of the last Frame Processor, one per Frame that can be processed in parallel
+  std::vector<std::shared_ptr<reanimated::WorkletRuntime>> workletRuntimes_;
   std::shared_ptr<vision::VisionCameraOldScheduler> scheduler_;
+  // CameraViews by viewTag, so swapping a Frame Processor doesn't look the view up through Java. Only accessed on the JS thread.
+  std::unordered_map<int, jni::weak_ref<CameraViewOld::javaobject>> cameraViews_;
 
   jni::global_ref<CameraViewOld::javaobject> findCameraViewOldById(int viewId);
-  void registerPlugins();
   void initializeRuntime();
   void installJSIBindings();
-  void registerPlugin(alias_ref<JFrameProcessorPlugin::javaobject> plugin);
+  /**
+   * Called by Java whenever a plugin is registered, the plugin reaches every worklet runtime with its next Frame Processor.
+   */
+  static void registerPlugin(alias_ref<jclass>, alias_ref<JFrameProcessorPlugin::javaobject> plugin);
+  /**
+   * Installs all Java and native plugins that the given worklet runtime doesn't have yet, and the bindings plugins rely on.
+   * Must be called on the runtime's own thread, inside a RuntimeThreadScope.
+   */
+  static void installPlugins(jsi::Runtime& runtime); // NOLINT(runtime/references)
+  /**
+   * Returns a function that calls installPlugins() for the runtime it is called with, but only the first time and whenever
+   * plugins have been added since. Every runtime needs its own.
+   */
+  static std::function<void(jsi::Runtime&)> createPluginInstaller();
   void logErrorToJS(const std::string& message);
 
   void setFrameProcessor(jsi::Runtime& runtime,                 // NOLINT(runtime/references)
                          int viewTag,
                          const jsi::Value& frameProcessor,
-                         const jsi::Value& workletRuntimeValue);
+                         const jsi::Value& workletRuntimeValue,
+                         const jsi::Value& options);
+  static TFrameProcessor createFrameProcessor(const std::shared_ptr<reanimated::WorkletRuntime>& workletRuntime,
+                                              const std::shared_ptr<reanimated::ShareableWorklet>& shareableWorklet,
+                                              const std::shared_ptr<AsyncFrameProcessor>& asyncProcessor,
+                                              const std::shared_ptr<FrameProcessorStats>& stats,
+                                              const std::shared_ptr<FrameRetentionBudget>& retentionBudget,
+                                              bool isInOrder);
   void unsetFrameProcessor(int viewTag);
 };
 
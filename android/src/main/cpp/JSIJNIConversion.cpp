@@ -7,20 +7,24 @@
 #include <jsi/jsi.h>
 #include <jni.h>
 #include <fbjni/fbjni.h>
+#include <fbjni/ByteBuffer.h>
 #include <android/log.h>
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <memory>
 
-#include <react/jni/NativeMap.h>
+#include <react/jni/ReadableNativeArray.h>
 #include <react/jni/ReadableNativeMap.h>
+#include <react/jni/WritableNativeArray.h>
 #include <react/jni/WritableNativeMap.h>
 
-#include <jsi/JSIDynamic.h>
-#include <folly/dynamic.h>
-
+#include "BufferPoolBindings.h"
 #include "FrameHostObjectOld.h"
+#include "PropNameIDCache.h"
+#include "TypedArrays.h"
 #include "java-bindings/JImageProxy.h"
 #include "java-bindings/JArrayList.h"
 #include "java-bindings/JHashMap.h"
@@ -29,6 +33,440 @@ namespace vision {
 
 using namespace facebook;
 
+namespace {
+
+/**
+ * The conversion to use for a Java class.
+ */
+enum class JavaType {
+  Boolean,
+  Double,
+  Integer,
+  // any other java.lang.Number (Float, Long, Short, Byte)
+  Number,
+  String,
+  ReadableNativeArray,
+  ReadableNativeMap,
+  ReadableArray,
+  ReadableMap,
+  ArrayList,
+  List,
+  Map,
+  ImageProxy,
+  ByteBuffer,
+  ByteArray,
+  ShortArray,
+  IntArray,
+  FloatArray,
+  DoubleArray,
+  Unknown,
+};
+
+JavaType classify(jni::alias_ref<jni::JClass> clazz) {
+  // most specific types first, e.g. WritableNativeMap is a ReadableNativeMap which is a ReadableMap.
+  if (jni::JBoolean::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::Boolean;
+  if (jni::JDouble::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::Double;
+  if (jni::JInteger::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::Integer;
+  if (jni::JNumber::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::Number;
+  if (jni::JString::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::String;
+  if (react::ReadableNativeArray::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ReadableNativeArray;
+  if (react::ReadableNativeMap::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ReadableNativeMap;
+  if (react::ReadableArray::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ReadableArray;
+  if (react::ReadableMap::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ReadableMap;
+  if (JArrayList<jobject>::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ArrayList;
+  if (jni::JList<jobject>::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::List;
+  if (jni::JMap<jobject, jobject>::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::Map;
+  if (JImageProxy::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ImageProxy;
+  if (jni::JByteBuffer::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ByteBuffer;
+  if (jni::JArrayByte::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ByteArray;
+  if (jni::JArrayShort::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::ShortArray;
+  if (jni::JArrayInt::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::IntArray;
+  if (jni::JArrayFloat::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::FloatArray;
+  if (jni::JArrayDouble::javaClassStatic()->isAssignableFrom(clazz)) return JavaType::DoubleArray;
+  return JavaType::Unknown;
+}
+
+/**
+ * Caches the JavaType of every class we have seen, so converting an object costs one `getClass()` and a few
+ * `IsSameObject` comparisons instead of a chain of `isInstanceOf` checks.
+ *
+ * Plugin results only ever contain a handful of classes, so this is a small append-only list that can be read without locking.
+ * The cached classes are global references that are never deleted, classes are not unloaded while the app is running anyways.
+ */
+class JavaTypeCache {
+ public:
+  static constexpr size_t kCapacity = 32;
+
+  JavaType resolve(jni::alias_ref<jni::JClass> clazz) {
+    JNIEnv* env = jni::Environment::current();
+    size_t count = count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+      if (env->IsSameObject(entries_[i].clazz, clazz.get())) {
+        return entries_[i].type;
+      }
+    }
+
+    auto type = classify(clazz);
+    std::unique_lock lock(mutex_);
+    count = count_.load(std::memory_order_relaxed);
+    if (count < kCapacity) {
+      entries_[count] = { static_cast<jclass>(env->NewGlobalRef(clazz.get())), type };
+      count_.store(count + 1, std::memory_order_release);
+    }
+    return type;
+  }
+
+ private:
+  struct Entry {
+    jclass clazz;
+    JavaType type;
+  };
+
+  Entry entries_[kCapacity];
+  std::atomic<size_t> count_ { 0 };
+  std::mutex mutex_;
+};
+
+JavaTypeCache& getJavaTypeCache() {
+  // never destroyed, see above.
+  static auto cache = new JavaTypeCache();
+  return *cache;
+}
+
+/**
+ * A jsi::MutableBuffer that points directly into the memory of a direct ByteBuffer (zero-copy).
+ * It holds a global reference to the ByteBuffer, so the memory stays alive until the JS ArrayBuffer is garbage collected.
+ */
+class DirectByteBufferContents : public jsi::MutableBuffer {
+ public:
+  DirectByteBufferContents(jni::alias_ref<jni::JByteBuffer> buffer, uint8_t* data, size_t size):
+    buffer_(jni::make_global(buffer)), data_(data), size_(size) { }
+
+  ~DirectByteBufferContents() override {
+    // the ArrayBuffer might be collected on a thread that is not attached to the JVM yet.
+    jni::ThreadScope scope;
+    buffer_.reset();
+  }
+
+  size_t size() const override { return size_; }
+  uint8_t* data() override { return data_; }
+
+ private:
+  jni::global_ref<jni::JByteBuffer> buffer_;
+  uint8_t* data_;
+  size_t size_;
+};
+
+/**
+ * Copies a Java primitive array (e.g. `float[]`) into a pooled buffer with a single JNI call and wraps it in a JS typed array.
+ * Java arrays can be moved by the GC, so unlike direct ByteBuffers they can not be exposed zero-copy.
+ */
+template <typename JArray>
+jsi::Value convertPrimitiveArrayToTypedArray(jsi::Runtime& runtime, const jni::alias_ref<jobject>& object, // NOLINT(runtime/references)
+                                             const char* typedArrayName) {
+  using Element = typename jni::jtype_traits<typename JArray::javaobject>::entry_type;
+
+  auto array = jni::static_ref_cast<typename JArray::javaobject>(object);
+  auto length = array->size();
+  auto buffer = PooledMutableBuffer::acquire(length * sizeof(Element));
+  array->getRegion(0, static_cast<jsize>(length), reinterpret_cast<Element*>(buffer->data()));
+  return createTypedArray(runtime, typedArrayName, jsi::ArrayBuffer(runtime, buffer));
+}
+
+/**
+ * Converts the remaining bytes (`position()` until `limit()`) of a ByteBuffer to a JS ArrayBuffer.
+ * Direct ByteBuffers are exposed zero-copy, heap ByteBuffers are copied.
+ */
+jsi::Value convertByteBufferToArrayBuffer(jsi::Runtime& runtime, const jni::alias_ref<jobject>& object) { // NOLINT(runtime/references)
+  static const auto positionFunc = jni::JByteBuffer::javaClassStatic()->getMethod<jint()>("position");
+  static const auto remainingFunc = jni::JByteBuffer::javaClassStatic()->getMethod<jint()>("remaining");
+
+  auto byteBuffer = jni::static_ref_cast<jni::JByteBuffer>(object);
+  auto position = static_cast<size_t>(positionFunc(byteBuffer));
+  auto remaining = static_cast<size_t>(remainingFunc(byteBuffer));
+
+  if (byteBuffer->isDirect()) {
+    auto data = byteBuffer->getDirectBytes() + position;
+    auto contents = std::make_shared<DirectByteBufferContents>(byteBuffer, data, remaining);
+    return jsi::ArrayBuffer(runtime, contents);
+  }
+
+  static const auto hasArrayFunc = jni::JByteBuffer::javaClassStatic()->getMethod<jboolean()>("hasArray");
+  static const auto arrayFunc = jni::JByteBuffer::javaClassStatic()->getMethod<jbyteArray()>("array");
+  static const auto arrayOffsetFunc = jni::JByteBuffer::javaClassStatic()->getMethod<jint()>("arrayOffset");
+  if (!hasArrayFunc(byteBuffer)) {
+    throw std::runtime_error("Received a ByteBuffer that is neither direct nor backed by an accessible array! Cannot convert to jsi::Value.");
+  }
+  auto array = arrayFunc(byteBuffer);
+  auto offset = static_cast<size_t>(arrayOffsetFunc(byteBuffer)) + position;
+  auto buffer = PooledMutableBuffer::acquire(remaining);
+  array->getRegion(static_cast<jsize>(offset), static_cast<jsize>(remaining), reinterpret_cast<jbyte*>(buffer->data()));
+  return jsi::ArrayBuffer(runtime, buffer);
+}
+
+jsi::Value convertJNIObjectToJSIValue(jsi::Runtime& runtime, const jni::alias_ref<jobject>& object, // NOLINT(runtime/references)
+                                      PropNameIDCache& keys) { // NOLINT(runtime/references)
+  if (object == nullptr) {
+    // null
+
+    return jsi::Value::undefined();
+  }
+
+  switch (getJavaTypeCache().resolve(object->getClass())) {
+    case JavaType::Boolean: {
+      // Boolean
+
+      static const auto getBooleanFunc = jni::JBoolean::javaClassStatic()->getMethod<jboolean()>("booleanValue");
+      auto boolean = getBooleanFunc(object.get());
+      return jsi::Value(boolean == true);
+    }
+    case JavaType::Double: {
+      // Double
+
+      static const auto getDoubleFunc = jni::JDouble::javaClassStatic()->getMethod<jdouble()>("doubleValue");
+      return jsi::Value(getDoubleFunc(object.get()));
+    }
+    case JavaType::Integer: {
+      // Integer
+
+      static const auto getIntegerFunc = jni::JInteger::javaClassStatic()->getMethod<jint()>("intValue");
+      return jsi::Value(getIntegerFunc(object.get()));
+    }
+    case JavaType::Number: {
+      // Float, Long, Short, Byte
+
+      static const auto getNumberFunc = jni::JNumber::javaClassStatic()->getMethod<jdouble()>("doubleValue");
+      return jsi::Value(getNumberFunc(object.get()));
+    }
+    case JavaType::String: {
+      // String
+
+      return jsi::String::createFromUtf8(runtime, jni::static_ref_cast<jstring>(object)->toStdString());
+    }
+    case JavaType::ReadableNativeArray: {
+      // ReadableNativeArray (and WritableNativeArray), all elements are boxed in native code at once instead of calling toArrayList().
+
+      auto array = jni::static_ref_cast<react::ReadableNativeArray::javaobject>(object);
+      auto values = array->cthis()->importArray();
+      auto size = values->size();
+
+      auto result = jsi::Array(runtime, size);
+      for (size_t i = 0; i < size; i++) {
+        result.setValueAtIndex(runtime, i, convertJNIObjectToJSIValue(runtime, values->getElement(i), keys));
+      }
+      return result;
+    }
+    case JavaType::ReadableNativeMap: {
+      // ReadableNativeMap (and WritableNativeMap), all keys and values are boxed in native code at once instead of calling toHashMap().
+
+      auto map = jni::static_ref_cast<react::ReadableNativeMap::javaobject>(object);
+      // importValues() returns the values in the order of the keys importKeys() returned, so the keys have to come first.
+      auto mapKeys = map->cthis()->importKeys();
+      auto values = map->cthis()->importValues();
+      auto size = mapKeys->size();
+
+      auto result = jsi::Object(runtime);
+      for (size_t i = 0; i < size; i++) {
+        auto key = keys.get(runtime, mapKeys->getElement(i)->toStdString());
+        result.setProperty(runtime, key, convertJNIObjectToJSIValue(runtime, values->getElement(i), keys));
+      }
+      return result;
+    }
+    case JavaType::ReadableArray: {
+      // any other ReadableArray, e.g. JavaOnlyArray
+
+      static const auto toArrayListFunc = react::ReadableArray::javaClassStatic()->getMethod<JArrayList<jobject>()>("toArrayList");
+
+      // call recursive, this time ArrayList<E>
+      auto array = toArrayListFunc(object.get());
+      return convertJNIObjectToJSIValue(runtime, array, keys);
+    }
+    case JavaType::ReadableMap: {
+      // any other ReadableMap, e.g. JavaOnlyMap
+
+      static const auto toHashMapFunc = react::ReadableMap::javaClassStatic()->getMethod<JHashMap<jstring, jobject>()>("toHashMap");
+
+      // call recursive, this time HashMap<K, V>
+      auto hashMap = toHashMapFunc(object.get());
+      return convertJNIObjectToJSIValue(runtime, hashMap, keys);
+    }
+    case JavaType::ArrayList: {
+      // ArrayList<E>, random access is a single JNI call per element.
+
+      static const auto getFunc = JArrayList<jobject>::javaClassStatic()->getMethod<jobject(jint)>("get");
+      auto arrayList = jni::static_ref_cast<JArrayList<jobject>>(object);
+      auto size = arrayList->size();
+
+      auto result = jsi::Array(runtime, size);
+      for (size_t i = 0; i < size; i++) {
+        auto item = getFunc(arrayList.get(), static_cast<jint>(i));
+        result.setValueAtIndex(runtime, i, convertJNIObjectToJSIValue(runtime, item, keys));
+      }
+      return result;
+    }
+    case JavaType::List: {
+      // List<E>
+
+      auto list = jni::static_ref_cast<jni::JList<jobject>>(object);
+      auto result = jsi::Array(runtime, list->size());
+      size_t i = 0;
+      for (const auto& item : *list) {
+        result.setValueAtIndex(runtime, i, convertJNIObjectToJSIValue(runtime, item, keys));
+        i++;
+      }
+      return result;
+    }
+    case JavaType::Map: {
+      // Map<K, V>
+
+      auto map = jni::static_ref_cast<jni::JMap<jobject, jobject>>(object);
+      auto result = jsi::Object(runtime);
+      for (const auto& entry : *map) {
+        auto key = keys.get(runtime, entry.first->toString());
+        result.setProperty(runtime, key, convertJNIObjectToJSIValue(runtime, entry.second, keys));
+      }
+      return result;
+    }
+    case JavaType::ImageProxy: {
+      // ImageProxy
+
+      auto frame = jni::static_ref_cast<JImageProxy>(object);
+
+      // box into HostObject. The plugin owns the ImageProxy (it might be the Camera's Frame), so the HostObject never closes it.
+      auto hostObject = FrameHostObjectOld::wrapUnowned(frame);
+      return jsi::Object::createFromHostObject(runtime, hostObject);
+    }
+    case JavaType::ByteBuffer: {
+      // ByteBuffer
+
+      return convertByteBufferToArrayBuffer(runtime, object);
+    }
+    case JavaType::ByteArray: {
+      // byte[] (read as unsigned, e.g. masks or pixel data)
+
+      return convertPrimitiveArrayToTypedArray<jni::JArrayByte>(runtime, object, "Uint8Array");
+    }
+    case JavaType::ShortArray: {
+      // short[]
+
+      return convertPrimitiveArrayToTypedArray<jni::JArrayShort>(runtime, object, "Int16Array");
+    }
+    case JavaType::IntArray: {
+      // int[]
+
+      return convertPrimitiveArrayToTypedArray<jni::JArrayInt>(runtime, object, "Int32Array");
+    }
+    case JavaType::FloatArray: {
+      // float[]
+
+      return convertPrimitiveArrayToTypedArray<jni::JArrayFloat>(runtime, object, "Float32Array");
+    }
+    case JavaType::DoubleArray: {
+      // double[]
+
+      return convertPrimitiveArrayToTypedArray<jni::JArrayDouble>(runtime, object, "Float64Array");
+    }
+    case JavaType::Unknown:
+    default:
+      break;
+  }
+
+  auto type = object->getClass()->toString();
+  auto message = "Received unknown JNI type \"" + type + "\"! Cannot convert to jsi::Value.";
+  __android_log_write(ANDROID_LOG_ERROR, "VisionCameraOld", message.c_str());
+  throw std::runtime_error(message);
+}
+
+/**
+ * Wraps `size` bytes at `data` in a direct ByteBuffer in native byte order, without copying them.
+ */
+jobject createDirectByteBuffer(uint8_t* data, size_t size) {
+  auto byteBuffer = jni::JByteBuffer::wrapBytes(data, size);
+  byteBuffer->order(jni::JByteOrder::nativeOrder());
+  return byteBuffer.release();
+}
+
+jni::local_ref<react::WritableNativeArray::javaobject> createNativeArray(jsi::Runtime& runtime, const jsi::Array& array); // NOLINT(runtime/references)
+jni::local_ref<react::WritableNativeMap::javaobject> createNativeMap(jsi::Runtime& runtime, const jsi::Object& object); // NOLINT(runtime/references)
+
+/**
+ * Creates an empty WritableNativeArray or WritableNativeMap through its Java constructor, which also creates its native part.
+ */
+template <typename T>
+jni::local_ref<typename T::javaobject> createWritable() {
+  static const auto constructor = T::javaClassStatic()->template getConstructor<typename T::javaobject()>();
+  return T::javaClassStatic()->newObject(constructor);
+}
+
+/**
+ * Builds a WritableNativeArray element by element from the JS values, nested arrays and objects are built the same way and moved in.
+ * Like jsi::dynamicFromValue, numbers are doubles and Functions can not be converted.
+ */
+jni::local_ref<react::WritableNativeArray::javaobject> createNativeArray(jsi::Runtime& runtime, const jsi::Array& array) {
+  auto result = createWritable<react::WritableNativeArray>();
+  auto nativeArray = result->cthis();
+  auto size = array.size(runtime);
+  for (size_t i = 0; i < size; i++) {
+    auto value = array.getValueAtIndex(runtime, i);
+    if (value.isNull() || value.isUndefined()) {
+      nativeArray->pushNull();
+    } else if (value.isBool()) {
+      nativeArray->pushBoolean(value.getBool());
+    } else if (value.isNumber()) {
+      nativeArray->pushDouble(value.getNumber());
+    } else if (value.isString()) {
+      nativeArray->pushString(jni::make_jstring(value.getString(runtime).utf8(runtime)).get());
+    } else {
+      auto object = value.getObject(runtime);
+      if (object.isFunction(runtime)) {
+        throw std::runtime_error("Cannot convert a JS Function inside an array to a JNI value!");
+      } else if (object.isArray(runtime)) {
+        nativeArray->pushNativeArray(createNativeArray(runtime, object.getArray(runtime))->cthis());
+      } else {
+        nativeArray->pushNativeMap(createNativeMap(runtime, object)->cthis());
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Builds a WritableNativeMap property by property from the JS object, nested arrays and objects are built the same way and moved in.
+ * Like jsi::dynamicFromValue, numbers are doubles and Functions can not be converted.
+ */
+jni::local_ref<react::WritableNativeMap::javaobject> createNativeMap(jsi::Runtime& runtime, const jsi::Object& object) {
+  auto result = createWritable<react::WritableNativeMap>();
+  auto nativeMap = result->cthis();
+  auto names = object.getPropertyNames(runtime);
+  auto size = names.size(runtime);
+  for (size_t i = 0; i < size; i++) {
+    auto key = names.getValueAtIndex(runtime, i).getString(runtime);
+    auto value = object.getProperty(runtime, key);
+    auto name = key.utf8(runtime);
+    if (value.isNull() || value.isUndefined()) {
+      nativeMap->putNull(std::move(name));
+    } else if (value.isBool()) {
+      nativeMap->putBoolean(std::move(name), value.getBool());
+    } else if (value.isNumber()) {
+      nativeMap->putDouble(std::move(name), value.getNumber());
+    } else if (value.isString()) {
+      nativeMap->putString(std::move(name), jni::make_jstring(value.getString(runtime).utf8(runtime)));
+    } else {
+      auto child = value.getObject(runtime);
+      if (child.isFunction(runtime)) {
+        throw std::runtime_error("Cannot convert the JS Function \"" + name + "\" to a JNI value!");
+      } else if (child.isArray(runtime)) {
+        nativeMap->putNativeArray(std::move(name), createNativeArray(runtime, child.getArray(runtime))->cthis());
+      } else {
+        nativeMap->putNativeMap(std::move(name), createNativeMap(runtime, child)->cthis());
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
 jobject JSIJNIConversion::convertJSIValueToJNIObject(jsi::Runtime &runtime, const jsi::Value &value) {
   if (value.isBool()) {
     // jsi::Bool
@@ -56,23 +494,38 @@ jobject JSIJNIConversion::convertJSIValueToJNIObject(jsi::Runtime &runtime, cons
   } else if (value.isObject()) {
     // jsi::Object
 
-    auto object = value.asObject(runtime);
+    auto object = value.getObject(runtime);
 
     if (object.isArray(runtime)) {
       // jsi::Array
 
-      auto dynamic = jsi::dynamicFromValue(runtime, value);
-      auto nativeArray = react::ReadableNativeArray::newObjectCxxArgs(std::move(dynamic));
-      return nativeArray.release();
+      return createNativeArray(runtime, object.getArray(runtime)).release();
+
+    } else if (object.isArrayBuffer(runtime)) {
+      // jsi::ArrayBuffer
+
+      // zero-copy, the ByteBuffer points into the JS memory.
+      auto arrayBuffer = object.getArrayBuffer(runtime);
+      return createDirectByteBuffer(arrayBuffer.data(runtime), arrayBuffer.size(runtime));
+
+    } else if (isArrayBufferView(runtime, object)) {
+      // Typed array (e.g. Float32Array) or DataView
+
+      // zero-copy, the ByteBuffer only covers the view's range of the underlying ArrayBuffer.
+      auto range = getArrayBufferViewRange(runtime, object);
+      return createDirectByteBuffer(range.data, range.size);
 
     } else if (object.isHostObject(runtime)) {
       // jsi::HostObject
 
       auto boxedHostObject = object.getHostObject(runtime);
-      auto hostObject = dynamic_cast<FrameHostObjectOld*>(boxedHostObject.get());
+      auto hostObject = dynamic_cast<FrameHostObjectBase*>(boxedHostObject.get());
       if (hostObject != nullptr) {
-        // return jni local_ref to the JImageProxy
-        return hostObject->frame.get();
+        if (!static_cast<FrameHostObjectOld&>(hostObject->getSourceFrame()).frame) {
+          throw std::runtime_error("Cannot convert a replayed Frame to a JNI value, only Camera Frames can be passed to Java!");
+        }
+        // return jni local_ref to the JImageProxy, for a crop that is a CroppedImageProxy covering only the crop.
+        return FrameHostObjectOld::getPluginImage(*hostObject).release();
       } else {
         // it's different kind of HostObject. We don't support it.
         throw std::runtime_error("Received an unknown HostObject! Cannot convert to a JNI value.");
@@ -87,9 +540,7 @@ jobject JSIJNIConversion::convertJSIValueToJNIObject(jsi::Runtime &runtime, cons
     } else {
       // jsi::Object
 
-      auto dynamic = jsi::dynamicFromValue(runtime, value);
-      auto map = react::ReadableNativeMap::createWithContents(std::move(dynamic));
-      return map.release();
+      return createNativeMap(runtime, object).release();
 
     }
   } else {
@@ -103,97 +554,8 @@ jobject JSIJNIConversion::convertJSIValueToJNIObject(jsi::Runtime &runtime, cons
 }
 
 jsi::Value JSIJNIConversion::convertJNIObjectToJSIValue(jsi::Runtime &runtime, const jni::local_ref<jobject>& object) {
-  if (object == nullptr) {
-    // null
-
-    return jsi::Value::undefined();
-
-  } else if (object->isInstanceOf(jni::JBoolean::javaClassStatic())) {
-    // Boolean
-
-    static const auto getBooleanFunc = jni::findClassLocal("java/lang/Boolean")->getMethod<jboolean()>("booleanValue");
-    auto boolean = getBooleanFunc(object.get());
-    return jsi::Value(boolean == true);
-
-  } else if (object->isInstanceOf(jni::JDouble::javaClassStatic())) {
-    // Double
-
-    static const auto getDoubleFunc = jni::findClassLocal("java/lang/Double")->getMethod<jdouble()>("doubleValue");
-    auto d = getDoubleFunc(object.get());
-    return jsi::Value(d);
-
-  } else if (object->isInstanceOf(jni::JInteger::javaClassStatic())) {
-    // Integer
-
-    static const auto getIntegerFunc = jni::findClassLocal("java/lang/Integer")->getMethod<jint()>("intValue");
-    auto i = getIntegerFunc(object.get());
-    return jsi::Value(i);
-
-  } else if (object->isInstanceOf(jni::JString::javaClassStatic())) {
-    // String
-
-    return jsi::String::createFromUtf8(runtime, object->toString());
-
-  } else if (object->isInstanceOf(JArrayList<jobject>::javaClassStatic())) {
-    // ArrayList<E>
-
-    auto arrayList = static_ref_cast<JArrayList<jobject>>(object);
-    auto size = arrayList->size();
-
-    auto result = jsi::Array(runtime, size);
-    size_t i = 0;
-    for (const auto& item : *arrayList) {
-      result.setValueAtIndex(runtime, i, convertJNIObjectToJSIValue(runtime, item));
-      i++;
-    }
-    return result;
-
-  } else if (object->isInstanceOf(react::ReadableArray::javaClassStatic())) {
-    // ReadableArray
-
-    static const auto toArrayListFunc = react::ReadableArray::javaClassLocal()->getMethod<JArrayList<jobject>()>("toArrayList");
-
-    // call recursive, this time ArrayList<E>
-    auto array = toArrayListFunc(object.get());
-    return convertJNIObjectToJSIValue(runtime, array);
-
-  } else if (object->isInstanceOf(JHashMap<jstring, jobject>::javaClassStatic())) {
-    // HashMap<K, V>
-
-    auto map = static_ref_cast<JHashMap<jstring, jobject>>(object);
-
-    auto result = jsi::Object(runtime);
-    for (const auto& entry : *map) {
-      auto key = entry.first->toString();
-      auto value = entry.second;
-      auto jsiValue = convertJNIObjectToJSIValue(runtime, value);
-      result.setProperty(runtime, key.c_str(), jsiValue);
-    }
-    return result;
-
-  } else if (object->isInstanceOf(react::ReadableMap::javaClassStatic())) {
-    // ReadableMap
-
-    static const auto toHashMapFunc = react::ReadableMap::javaClassLocal()->getMethod<JHashMap<jstring, jobject>()>("toHashMap");
-
-    // call recursive, this time HashMap<K, V>
-    auto hashMap = toHashMapFunc(object.get());
-    return convertJNIObjectToJSIValue(runtime, hashMap);
-
-  } else if (object->isInstanceOf(JImageProxy::javaClassStatic())) {
-    // ImageProxy
-
-    auto frame = static_ref_cast<JImageProxy>(object);
-
-    // box into HostObject
-    auto hostObject = std::make_shared<FrameHostObjectOld>(frame);
-    return jsi::Object::createFromHostObject(runtime, hostObject);
-  }
-
-  auto type = object->getClass()->toString();
-  auto message = "Received unknown JNI type \"" + type + "\"! Cannot convert to jsi::Value.";
-  __android_log_write(ANDROID_LOG_ERROR, "VisionCameraOld", message.c_str());
-  throw std::runtime_error(message);
+  auto keys = PropNameIDCache::forRuntime(runtime);
+  return vision::convertJNIObjectToJSIValue(runtime, object, *keys);
 }
 
 } // namespace vision
@@ -14,8 +14,20 @@ namespace JSIJNIConversion {
 
 using namespace facebook;
 
+/**
+ * Converts a JS value to a Java object in a single pass, arrays and objects are built directly as WritableNativeArray and
+ * WritableNativeMap (which are ReadableNativeArray and ReadableNativeMap).
+ * ArrayBuffers and typed arrays are wrapped zero-copy in a direct ByteBuffer (native byte order), which is only valid
+ * while the JS value is alive.
+ */
 jobject convertJSIValueToJNIObject(jsi::Runtime& runtime, const jsi::Value& value); // NOLINT(runtime/references)
 
+/**
+ * Converts a Java object to a JS value in a single pass. ReadableNativeArray/ReadableNativeMap are boxed by their native part
+ * in one call instead of being copied to an ArrayList/HashMap in Java, and object keys are interned per Runtime.
+ * Primitive arrays are copied into JS typed arrays (e.g. `float[]` -> `Float32Array`), direct ByteBuffers are exposed zero-copy
+ * as an ArrayBuffer.
+ */
 jsi::Value convertJNIObjectToJSIValue(jsi::Runtime& runtime, const jni::local_ref<jobject>& object); // NOLINT(runtime/references)
 
 } // namespace JSIJNIConversion
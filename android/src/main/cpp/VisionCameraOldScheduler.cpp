@@ -4,7 +4,7 @@
 
 #include "VisionCameraOldScheduler.h"
 #include <fbjni/fbjni.h>
-#include <fbjni/NativeRunnable.h>
+#include <functional>
 #include <utility>
 
 namespace vision {
@@ -13,14 +13,22 @@ using namespace facebook;
 
 using TSelf = jni::local_ref<VisionCameraOldScheduler::jhybriddata>;
 
+VisionCameraOldScheduler::VisionCameraOldScheduler(jni::alias_ref<VisionCameraOldScheduler::jhybridobject> jThis):
+  javaPart_(jni::make_global(jThis)),
+  // the workers are attached to the JVM once, so tasks can call into Java.
+  scheduler_([](const std::function<void()>& loop) { jni::ThreadScope::WithClassLoader(loop); }) {}
+
 TSelf VisionCameraOldScheduler::initHybrid(jni::alias_ref<jhybridobject> jThis) {
   return makeCxxInstance(jThis);
 }
 
 void VisionCameraOldScheduler::scheduleOnUI(std::function<void()> job) {
-  static const auto method = javaPart_->getClass()->getMethod<void(jni::JRunnable::javaobject)>("scheduleOnUI");
-  auto jrunnable = jni::JNativeRunnable::newObjectCxxArgs(std::move(job));
-  method(javaPart_.get(), jrunnable.get());
+  // Frame Processor work never queues behind CameraX's or other Java tasks on the shared executor.
+  scheduler_.schedule(TaskLane::Frame, std::move(job));
+}
+
+void VisionCameraOldScheduler::schedule(TaskLane lane, std::function<void()> job) {
+  scheduler_.schedule(lane, std::move(job));
 }
 
 void VisionCameraOldScheduler::registerNatives() {
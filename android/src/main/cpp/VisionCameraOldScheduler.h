@@ -7,6 +7,10 @@
 #include <jni.h>
 #include <fbjni/fbjni.h>
 
+#include <functional>
+
+#include "TaskScheduler.h"
+
 namespace vision {
 
 using namespace facebook;
@@ -19,13 +23,17 @@ class VisionCameraOldScheduler : public jni::HybridClass<VisionCameraOldSchedule
 
   // schedules the given job to be run on the VisionCameraOld FP Thread at some future point in time
   void scheduleOnUI(std::function<void()> job);
+  /**
+   * Schedules the given job on one of VisionCamera's own worker threads, without going through Java.
+   */
+  void schedule(TaskLane lane, std::function<void()> job);
 
  private:
   friend HybridBase;
   jni::global_ref<VisionCameraOldScheduler::javaobject> javaPart_;
+  TaskScheduler scheduler_;
 
-  explicit VisionCameraOldScheduler(jni::alias_ref<VisionCameraOldScheduler::jhybridobject> jThis):
-    javaPart_(jni::make_global(jThis)) {}
+  explicit VisionCameraOldScheduler(jni::alias_ref<VisionCameraOldScheduler::jhybridobject> jThis);
 };
 
 } // namespace vision
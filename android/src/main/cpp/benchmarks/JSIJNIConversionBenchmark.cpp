@@ -0,0 +1,177 @@
+#include "JSIJNIConversionBenchmark.h"
+
+#include <jsi/jsi.h>
+#include <jni.h>
+#include <fbjni/fbjni.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <react/jni/ReadableNativeArray.h>
+#include <react/jni/ReadableNativeMap.h>
+
+#include <jsi/JSIDynamic.h>
+#include <folly/dynamic.h>
+
+#include "../JSIJNIConversion.h"
+#include "../java-bindings/JArrayList.h"
+#include "../java-bindings/JHashMap.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+constexpr size_t kBoxesCount = 100;
+
+/**
+ * The conversion before the direct converter, kept as the baseline: every object goes through a chain of `isInstanceOf`
+ * checks, ReadableArray/ReadableMap are copied into an ArrayList/HashMap in Java first, and every key is a new PropNameID.
+ */
+jsi::Value convertJNIObjectToJSIValueLegacy(jsi::Runtime& runtime, const jni::local_ref<jobject>& object) { // NOLINT(runtime/references)
+  if (object == nullptr) {
+    return jsi::Value::undefined();
+  } else if (object->isInstanceOf(jni::JBoolean::javaClassStatic())) {
+    static const auto getBooleanFunc = jni::findClassLocal("java/lang/Boolean")->getMethod<jboolean()>("booleanValue");
+    return jsi::Value(getBooleanFunc(object.get()) == true);
+  } else if (object->isInstanceOf(jni::JDouble::javaClassStatic())) {
+    static const auto getDoubleFunc = jni::findClassLocal("java/lang/Double")->getMethod<jdouble()>("doubleValue");
+    return jsi::Value(getDoubleFunc(object.get()));
+  } else if (object->isInstanceOf(jni::JInteger::javaClassStatic())) {
+    static const auto getIntegerFunc = jni::findClassLocal("java/lang/Integer")->getMethod<jint()>("intValue");
+    return jsi::Value(getIntegerFunc(object.get()));
+  } else if (object->isInstanceOf(jni::JString::javaClassStatic())) {
+    return jsi::String::createFromUtf8(runtime, object->toString());
+  } else if (object->isInstanceOf(JArrayList<jobject>::javaClassStatic())) {
+    auto arrayList = jni::static_ref_cast<JArrayList<jobject>>(object);
+    auto result = jsi::Array(runtime, arrayList->size());
+    size_t i = 0;
+    for (const auto& item : *arrayList) {
+      result.setValueAtIndex(runtime, i++, convertJNIObjectToJSIValueLegacy(runtime, item));
+    }
+    return result;
+  } else if (object->isInstanceOf(react::ReadableArray::javaClassStatic())) {
+    static const auto toArrayListFunc = react::ReadableArray::javaClassLocal()->getMethod<JArrayList<jobject>()>("toArrayList");
+    return convertJNIObjectToJSIValueLegacy(runtime, toArrayListFunc(object.get()));
+  } else if (object->isInstanceOf(JHashMap<jstring, jobject>::javaClassStatic())) {
+    auto map = jni::static_ref_cast<JHashMap<jstring, jobject>>(object);
+    auto result = jsi::Object(runtime);
+    for (const auto& entry : *map) {
+      auto key = entry.first->toString();
+      result.setProperty(runtime, key.c_str(), convertJNIObjectToJSIValueLegacy(runtime, entry.second));
+    }
+    return result;
+  } else if (object->isInstanceOf(react::ReadableMap::javaClassStatic())) {
+    static const auto toHashMapFunc = react::ReadableMap::javaClassLocal()->getMethod<JHashMap<jstring, jobject>()>("toHashMap");
+    return convertJNIObjectToJSIValueLegacy(runtime, toHashMapFunc(object.get()));
+  }
+  throw std::runtime_error("Received unknown JNI type \"" + object->getClass()->toString() + "\"!");
+}
+
+folly::dynamic createBox(size_t i) {
+  return folly::dynamic::object
+    ("x", 0.1 * i)
+    ("y", 0.2 * i)
+    ("width", 64.0)
+    ("height", 48.0)
+    ("confidence", 0.87)
+    ("label", "person");
+}
+
+/**
+ * `[{ x, y, width, height, confidence, label }, ...]` as a ReadableNativeArray of ReadableNativeMaps (built with WritableNativeArray/Map).
+ */
+jni::local_ref<jobject> createNativeArrayPayload() {
+  auto boxes = folly::dynamic::array();
+  for (size_t i = 0; i < kBoxesCount; i++) {
+    boxes.push_back(createBox(i));
+  }
+  return jni::static_ref_cast<jobject>(react::ReadableNativeArray::newObjectCxxArgs(std::move(boxes)));
+}
+
+/**
+ * The same payload as an `ArrayList<HashMap<String, Object>>`, the other common way to return results.
+ */
+jni::local_ref<jobject> createArrayListPayload() {
+  static const auto addFunc = JArrayList<jobject>::javaClassStatic()->getMethod<jboolean(jobject)>("add");
+  static const auto putFunc = JHashMap<jstring, jobject>::javaClassStatic()->getMethod<jobject(jobject, jobject)>("put");
+
+  auto list = JArrayList<jobject>::newInstance();
+  for (size_t i = 0; i < kBoxesCount; i++) {
+    auto box = JHashMap<jstring, jobject>::newInstance();
+    for (const auto& item : createBox(i).items()) {
+      auto key = jni::make_jstring(item.first.getString());
+      if (item.second.isString()) {
+        putFunc(box.get(), key.get(), jni::make_jstring(item.second.getString()).get());
+      } else {
+        putFunc(box.get(), key.get(), jni::JDouble::valueOf(item.second.asDouble()).get());
+      }
+    }
+    addFunc(list.get(), box.get());
+  }
+  return jni::static_ref_cast<jobject>(list);
+}
+
+template <typename Func>
+double measure(int iterations, Func&& func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    func();
+  }
+  auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  return duration.count() / iterations;
+}
+
+} // namespace
+
+void installJSIJNIConversionBenchmark(jsi::Runtime& runtime) {
+  auto benchmark = [](jsi::Runtime& runtime,
+                      const jsi::Value& thisValue,
+                      const jsi::Value* arguments,
+                      size_t count) -> jsi::Value {
+    int iterations = count > 0 && arguments[0].isNumber() ? static_cast<int>(arguments[0].asNumber()) : 100;
+    if (iterations <= 0) {
+      throw jsi::JSError(runtime, "__benchmarkJSIJNIConversion: `iterations` must be greater than 0!");
+    }
+
+    auto nativeArray = createNativeArrayPayload();
+    auto arrayList = createArrayListPayload();
+    // the same payload as a JS value, to measure the other direction.
+    auto jsPayload = JSIJNIConversion::convertJNIObjectToJSIValue(runtime, nativeArray);
+
+    auto result = jsi::Object(runtime);
+    result.setProperty(runtime, "iterations", iterations);
+    result.setProperty(runtime, "legacyNativeArrayMs", measure(iterations, [&]() {
+      convertJNIObjectToJSIValueLegacy(runtime, nativeArray);
+    }));
+    result.setProperty(runtime, "directNativeArrayMs", measure(iterations, [&]() {
+      JSIJNIConversion::convertJNIObjectToJSIValue(runtime, nativeArray);
+    }));
+    result.setProperty(runtime, "legacyArrayListMs", measure(iterations, [&]() {
+      convertJNIObjectToJSIValueLegacy(runtime, arrayList);
+    }));
+    result.setProperty(runtime, "directArrayListMs", measure(iterations, [&]() {
+      JSIJNIConversion::convertJNIObjectToJSIValue(runtime, arrayList);
+    }));
+    result.setProperty(runtime, "legacyJsToJavaMs", measure(iterations, [&]() {
+      // the previous JS -> Java conversion: all values go into a folly::dynamic first, which the ReadableNativeArray then takes over.
+      react::ReadableNativeArray::newObjectCxxArgs(jsi::dynamicFromValue(runtime, jsPayload));
+    }));
+    result.setProperty(runtime, "directJsToJavaMs", measure(iterations, [&]() {
+      jni::adopt_local(JSIJNIConversion::convertJSIValueToJNIObject(runtime, jsPayload));
+    }));
+    return result;
+  };
+
+  runtime.global().setProperty(runtime,
+                               "__benchmarkJSIJNIConversion",
+                               jsi::Function::createFromHostFunction(runtime,
+                                                                     jsi::PropNameID::forAscii(runtime, "__benchmarkJSIJNIConversion"),
+                                                                     1, // iterations
+                                                                     benchmark));
+}
+
+} // namespace vision
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Installs `__benchmarkJSIJNIConversion(iterations)` into the given Runtime, which converts a typical Frame Processor Plugin
+ * result (an array of 100 detection boxes) with the previous conversion (through Java's `toArrayList()`/`toHashMap()`) and
+ * with the current one, and the same payload from JS to Java through `jsi::dynamicFromValue` and with the direct conversion.
+ * Returns the average time per conversion in milliseconds.
+ *
+ * Only built with `-DVISION_CAMERA_BENCHMARKS=ON`.
+ */
+void installJSIJNIConversionBenchmark(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+} // namespace vision
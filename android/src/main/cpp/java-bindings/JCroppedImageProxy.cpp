@@ -0,0 +1,15 @@
+#include "JCroppedImageProxy.h"
+
+#include <jni.h>
+#include <fbjni/fbjni.h>
+
+namespace vision {
+
+using namespace facebook;
+using namespace jni;
+
+local_ref<JImageProxy::javaobject> JCroppedImageProxy::create(alias_ref<JImageProxy::javaobject> image, int x, int y, int width, int height) {
+  return static_ref_cast<JImageProxy::javaobject>(newInstance(image, x, y, width, height));
+}
+
+} // namespace vision
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <jni.h>
+#include <fbjni/fbjni.h>
+
+#include "JImageProxy.h"
+
+namespace vision {
+
+using namespace facebook;
+using namespace jni;
+
+/**
+ * An ImageProxy that shares the image of another one, but has its own crop rect (see CroppedImageProxy.java).
+ */
+struct JCroppedImageProxy : public JavaClass<JCroppedImageProxy, JImageProxy> {
+  static constexpr auto kJavaDescriptor = "Lcom/mrousavy/old/camera/frameprocessor/CroppedImageProxy;";
+
+ public:
+  /**
+   * Wraps the given image with the crop rect `x`, `y`, `width`, `height`, without modifying the image itself.
+   */
+  static local_ref<JImageProxy::javaobject> create(alias_ref<JImageProxy::javaobject> image, int x, int y, int width, int height);
+};
+
+} // namespace vision
@@ -6,6 +6,8 @@
 
 #include <jni.h>
 #include <fbjni/fbjni.h>
+#include <fbjni/ByteBuffer.h>
+#include <algorithm>
 
 namespace vision {
 
@@ -22,27 +24,22 @@ int JImageProxy::getHeight() const {
   return getWidthMethod(self());
 }
 
-alias_ref<JClass> getUtilsClass() {
-  static const auto ImageProxyUtilsClass = findClassStatic("com/mrousavy/old/camera/frameprocessor/ImageProxyUtils");
-  return ImageProxyUtilsClass;
+int JImageProxy::getFormat() const {
+  static const auto getFormatMethod = javaClassStatic()->getMethod<jint()>("getFormat");
+  return getFormatMethod(self());
 }
 
-bool JImageProxy::getIsValid() const {
-  auto utilsClass = getUtilsClass();
-  static const auto isImageProxyValidMethod = utilsClass->getStaticMethod<jboolean(JImageProxy::javaobject)>("isImageProxyValid");
-  return isImageProxyValidMethod(utilsClass, self());
+int64_t JImageProxy::getTimestamp() const {
+  static const auto imageInfoClass = findClassStatic("androidx/camera/core/ImageInfo");
+  static const auto getImageInfoMethod = javaClassStatic()->getMethod<jobject()>("getImageInfo");
+  static const auto getTimestampMethod = imageInfoClass->getMethod<jlong()>("getTimestamp");
+  auto imageInfo = getImageInfoMethod(self());
+  return getTimestampMethod(imageInfo.get());
 }
 
-int JImageProxy::getPlanesCount() const {
-  auto utilsClass = getUtilsClass();
-  static const auto getPlanesCountMethod = utilsClass->getStaticMethod<jint(JImageProxy::javaobject)>("getPlanesCount");
-  return getPlanesCountMethod(utilsClass, self());
-}
-
-int JImageProxy::getBytesPerRow() const {
-  auto utilsClass = getUtilsClass();
-  static const auto getBytesPerRowMethod = utilsClass->getStaticMethod<jint(JImageProxy::javaobject)>("getBytesPerRow");
-  return getBytesPerRowMethod(utilsClass, self());
+local_ref<JArrayClass<JPlaneProxy::javaobject>> JImageProxy::getPlanes() const {
+  static const auto getPlanesMethod = javaClassStatic()->getMethod<JArrayClass<JPlaneProxy::javaobject>::javaobject()>("getPlanes");
+  return getPlanesMethod(self());
 }
 
 void JImageProxy::close() {
@@ -50,4 +47,37 @@ void JImageProxy::close() {
   closeMethod(self());
 }
 
+FrameDescriptor JImageProxy::getFrameDescriptor() const {
+  FrameDescriptor descriptor;
+  descriptor.width = getWidth();
+  descriptor.height = getHeight();
+  descriptor.pixelFormat = toPixelFormat(getFormat());
+  descriptor.timestamp = getTimestamp();
+
+  auto planes = getPlanes();
+  descriptor.planesCount = std::min(planes->size(), FrameDescriptor::kMaxPlanes);
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    auto plane = planes->getElement(i);
+    auto buffer = plane->getBuffer();
+    descriptor.planes[i].data = buffer->getDirectBytes();
+    descriptor.planes[i].size = buffer->getDirectSize();
+    descriptor.planes[i].rowStride = plane->getRowStride();
+    descriptor.planes[i].pixelStride = plane->getPixelStride();
+  }
+  descriptor.isValid = true;
+  return descriptor;
+}
+
+PixelFormat JImageProxy::toPixelFormat(int imageFormat) {
+  // see android.graphics.ImageFormat and android.graphics.PixelFormat
+  switch (imageFormat) {
+    case 0x23: // ImageFormat.YUV_420_888
+      return PixelFormat::YUV_420_888;
+    case 0x1: // PixelFormat.RGBA_8888
+      return PixelFormat::RGBA_8888;
+    default:
+      return PixelFormat::Unknown;
+  }
+}
+
 } // namespace vision
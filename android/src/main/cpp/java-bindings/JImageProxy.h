@@ -7,6 +7,9 @@
 #include <jni.h>
 #include <fbjni/fbjni.h>
 
+#include "FrameDescriptor.h"
+#include "JPlaneProxy.h"
+
 namespace vision {
 
 using namespace facebook;
@@ -18,10 +21,22 @@ struct JImageProxy : public JavaClass<JImageProxy> {
  public:
   int getWidth() const;
   int getHeight() const;
-  bool getIsValid() const;
-  int getPlanesCount() const;
-  int getBytesPerRow() const;
+  int getFormat() const;
+  int64_t getTimestamp() const;
+  local_ref<JArrayClass<JPlaneProxy::javaobject>> getPlanes() const;
   void close();
+
+  /**
+   * Creates a FrameDescriptor by querying all properties of this ImageProxy.
+   * This calls into Java for every property and plane, so prefer the descriptor the Camera passes
+   * to `frameProcessorCallback` and only use this for ImageProxies that come from elsewhere (e.g. Plugins).
+   */
+  FrameDescriptor getFrameDescriptor() const;
+
+  /**
+   * Converts an `android.graphics.ImageFormat` to a PixelFormat.
+   */
+  static PixelFormat toPixelFormat(int imageFormat);
 };
 
 } // namespace vision
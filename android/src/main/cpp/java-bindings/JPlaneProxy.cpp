@@ -0,0 +1,27 @@
+#include "JPlaneProxy.h"
+
+#include <jni.h>
+#include <fbjni/fbjni.h>
+#include <fbjni/ByteBuffer.h>
+
+namespace vision {
+
+using namespace facebook;
+using namespace jni;
+
+local_ref<JByteBuffer> JPlaneProxy::getBuffer() const {
+  static const auto getBufferMethod = javaClassStatic()->getMethod<JByteBuffer::javaobject()>("getBuffer");
+  return getBufferMethod(self());
+}
+
+int JPlaneProxy::getRowStride() const {
+  static const auto getRowStrideMethod = javaClassStatic()->getMethod<jint()>("getRowStride");
+  return getRowStrideMethod(self());
+}
+
+int JPlaneProxy::getPixelStride() const {
+  static const auto getPixelStrideMethod = javaClassStatic()->getMethod<jint()>("getPixelStride");
+  return getPixelStrideMethod(self());
+}
+
+} // namespace vision
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <jni.h>
+#include <fbjni/fbjni.h>
+#include <fbjni/ByteBuffer.h>
+
+namespace vision {
+
+using namespace facebook;
+using namespace jni;
+
+struct JPlaneProxy : public JavaClass<JPlaneProxy> {
+  static constexpr auto kJavaDescriptor = "Landroidx/camera/core/ImageProxy$PlaneProxy;";
+
+ public:
+  /**
+   * Get the direct ByteBuffer containing this plane's pixels. The memory is owned by the ImageProxy.
+   */
+  local_ref<JByteBuffer> getBuffer() const;
+  int getRowStride() const;
+  int getPixelStride() const;
+};
+
+} // namespace vision
@@ -42,6 +42,20 @@ fun CameraViewOld.invokeOnFrameProcessorPerformanceSuggestionAvailable(currentFp
   reactContext.getJSModule(RCTEventEmitter::class.java).receiveEvent(id, "cameraPerformanceSuggestionAvailable", event)
 }
 
+fun CameraViewOld.invokeOnFrameProcessorFpsChanged(fps: Double, previousFps: Double, cameraFps: Double,
+                                                   averageExecutionTime: Double, averageLatency: Double) {
+  Log.i(CameraViewOld.TAG, "invokeOnFrameProcessorFpsChanged(fps: $fps, previousFps: $previousFps)")
+
+  val event = Arguments.createMap()
+  event.putDouble("frameProcessorFps", fps)
+  event.putDouble("previousFrameProcessorFps", previousFps)
+  event.putDouble("cameraFps", cameraFps)
+  event.putDouble("averageExecutionTime", averageExecutionTime)
+  event.putDouble("averageLatency", averageLatency)
+  val reactContext = context as ReactContext
+  reactContext.getJSModule(RCTEventEmitter::class.java).receiveEvent(id, "cameraFrameProcessorFpsChanged", event)
+}
+
 fun CameraViewOld.invokeOnViewReady() {
   val event = Arguments.createMap()
   val reactContext = context as ReactContext
@@ -11,6 +11,7 @@ import android.util.Range
 import android.view.*
 import android.view.View.OnTouchListener
 import android.widget.FrameLayout
+import androidx.annotation.Keep
 import androidx.camera.camera2.interop.Camera2Interop
 import androidx.camera.core.*
 import androidx.camera.core.impl.*
@@ -25,15 +26,14 @@ import com.facebook.jni.HybridData
 import com.facebook.proguard.annotations.DoNotStrip
 import com.facebook.react.bridge.*
 import com.facebook.react.uimanager.events.RCTEventEmitter
-import com.mrousavy.old.camera.frameprocessor.FrameProcessorPerformanceDataCollector
 import com.mrousavy.old.camera.frameprocessor.FrameProcessorRuntimeManagerOld
 import com.mrousavy.old.camera.utils.*
 import kotlinx.coroutines.*
 import kotlinx.coroutines.guava.await
 import java.lang.IllegalArgumentException
+import java.nio.ByteBuffer
 import java.util.concurrent.ExecutorService
 import java.util.concurrent.Executors
-import kotlin.math.floor
 import kotlin.math.max
 import kotlin.math.min
 
@@ -72,7 +72,8 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
     const val TAG = "CameraViewOld"
     const val TAG_PERF = "CameraViewOld.performance"
 
-    private val propsThatRequireSessionReconfiguration = arrayListOf("cameraId", "format", "fps", "hdr", "lowLightBoost", "photo", "video", "enableFrameProcessor")
+    private val propsThatRequireSessionReconfiguration = arrayListOf("cameraId", "format", "fps", "hdr", "lowLightBoost", "photo", "video", "enableFrameProcessor", "frameProcessorQueueDepth", "frameProcessorRuntimes", "frameProcessorMaxAsyncTasks", "frameProcessorMaxRetainedFrames", "frameProcessorDropPolicy", "frameProcessorBlockTimeout")
+    private val propsThatRequireFrameRateReconfiguration = arrayListOf("frameProcessorFps", "frameProcessorRateMode", "frameProcessorLatencyBudget")
     private val arrayListOfZoom = arrayListOf("zoom")
   }
 
@@ -103,13 +104,16 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
       field = value
       setOnTouchListener(if (value) touchEventListener else null)
     }
+  var frameProcessorQueueDepth = 1
+  var frameProcessorRuntimes = 1
+  var frameProcessorMaxAsyncTasks = 0
+  var frameProcessorMaxRetainedFrames = 1
+  var frameProcessorDropPolicy = "keep-latest"
+  var frameProcessorBlockTimeout = 100
   var frameProcessorFps = 1.0
-    set(value) {
-      field = value
-      actualFrameProcessorFps = if (value == -1.0) 30.0 else value
-      lastFrameProcessorPerformanceEvaluation = System.currentTimeMillis()
-      frameProcessorPerformanceDataCollector.clear()
-    }
+  var frameProcessorRateMode = "throughput"
+  var frameProcessorLatencyBudget = 100.0
+  var frameProcessorChangeThreshold = 0.0
 
   // private properties
   private var isMounted = false
@@ -131,7 +135,9 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
 
   internal var activeVideoRecording: Recording? = null
 
-  private var lastFrameProcessorCall = System.currentTimeMillis()
+  // re-used for every frame to avoid allocations in the analyzer, see frameProcessorCallback
+  private val frameProcessorPlaneBuffers = arrayOfNulls<ByteBuffer>(3)
+  private val frameProcessorPlaneStrides = IntArray(3 * 2)
 
   private var extensionsManager: ExtensionsManager? = null
 
@@ -166,15 +172,7 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
   private var minZoom: Float = 1f
   private var maxZoom: Float = 1f
 
-  private var actualFrameProcessorFps = 30.0
-  private val frameProcessorPerformanceDataCollector = FrameProcessorPerformanceDataCollector()
   private var lastSuggestedFrameProcessorFps = 0.0
-  private var lastFrameProcessorPerformanceEvaluation = System.currentTimeMillis()
-  private val isReadyForNewEvaluation: Boolean
-    get() {
-      val lastPerformanceEvaluationElapsedTime = System.currentTimeMillis() - lastFrameProcessorPerformanceEvaluation
-      return lastPerformanceEvaluationElapsedTime > 1000
-    }
 
   @DoNotStrip
   private var mHybridData: HybridData? = null
@@ -267,7 +265,50 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
   }
 
   private external fun initHybrid(): HybridData
-  private external fun frameProcessorCallback(frame: ImageProxy)
+  private external fun frameProcessorCallback(
+    frame: ImageProxy,
+    width: Int,
+    height: Int,
+    format: Int,
+    timestamp: Long,
+    planesCount: Int,
+    planeBuffers: Array<ByteBuffer?>,
+    planeStrides: IntArray,
+    analyzerTimestamp: Long
+  )
+  private external fun configureFrameQueue(depth: Int, policy: Int, timeoutMs: Int)
+  /**
+   * Configures which Frames are passed to the Frame Processor, see [frameProcessorFps]. Frames are throttled natively.
+   */
+  private external fun configureFrameRate(mode: Int, fixedFps: Double, latencyBudgetMs: Double)
+  /**
+   * Configures the mean absolute luma difference a Frame needs to be passed to the Frame Processor, see [frameProcessorChangeThreshold]. 0 disables it.
+   */
+  private external fun configureChangeDetection(threshold: Double)
+  /**
+   * Configures how many Frames can be retained past their Frame Processor call at once, see [frameProcessorMaxRetainedFrames].
+   */
+  private external fun configureFrameRetention(maxRetainedFrames: Int)
+
+  /**
+   * Passes the [image] and everything the C++ Frame needs to know about it in a single JNI call,
+   * so the Frame Processor never has to call back into Java to read the Frame's properties.
+   *
+   * The [image] is owned by the native Frame Queue afterwards, which closes it once it has been processed or dropped.
+   * [analyzerTimestamp] is the [System.nanoTime] at which the analyzer received the [image], for tracing.
+   */
+  private fun callFrameProcessor(image: ImageProxy, analyzerTimestamp: Long) {
+    val planes = image.planes
+    val planesCount = min(planes.size, frameProcessorPlaneBuffers.size)
+    for (i in 0 until planesCount) {
+      frameProcessorPlaneBuffers[i] = planes[i].buffer
+      frameProcessorPlaneStrides[i * 2] = planes[i].rowStride
+      frameProcessorPlaneStrides[i * 2 + 1] = planes[i].pixelStride
+    }
+    frameProcessorCallback(image, image.width, image.height, image.format, image.imageInfo.timestamp,
+      planesCount, frameProcessorPlaneBuffers, frameProcessorPlaneStrides, analyzerTimestamp)
+    frameProcessorPlaneBuffers.fill(null)
+  }
 
   override fun getLifecycle(): Lifecycle {
     return lifecycleRegistry
@@ -325,6 +366,11 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
         }
         if (shouldReconfigureSession) {
           configureSession()
+        } else if (changedProps.containsAny(propsThatRequireFrameRateReconfiguration) && enableFrameProcessor) {
+          configureFrameRateController()
+        }
+        if (!shouldReconfigureSession && changedProps.contains("frameProcessorChangeThreshold") && enableFrameProcessor) {
+          configureChangeDetection(frameProcessorChangeThreshold)
         }
         if (shouldReconfigureZoom) {
           val zoomClamped = max(min(zoom, maxZoom), minZoom)
@@ -395,9 +441,15 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
       val videoRecorderBuilder = Recorder.Builder()
         .setExecutor(cameraExecutor)
 
+      // The native Frame Queue decides which Frames to drop, so CameraX has to deliver every Frame as long as
+      // there is room in the queue - plus one Frame that is being processed per runtime, one per runAsync() task that holds on to its Frame,
+      // and the Frames the Frame Processor retains with incrementRefCount() (retaining more than that throws, see configureFrameRetention()).
+      val imageQueueDepth = max(frameProcessorQueueDepth, 1) + max(frameProcessorRuntimes, 1) + max(frameProcessorMaxAsyncTasks, 0) +
+        max(frameProcessorMaxRetainedFrames, 0)
       val imageAnalysisBuilder = ImageAnalysis.Builder()
         .setTargetRotation(outputRotation)
-        .setBackpressureStrategy(ImageAnalysis.STRATEGY_KEEP_ONLY_LATEST)
+        .setBackpressureStrategy(ImageAnalysis.STRATEGY_BLOCK_PRODUCER)
+        .setImageQueueDepth(imageQueueDepth)
         .setBackgroundExecutor(frameProcessorThread)
 
       if (format == null) {
@@ -480,23 +532,14 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
       }
       if (enableFrameProcessor) {
         Log.i(TAG, "Adding ImageAnalysis use-case...")
+        configureFrameQueue(frameProcessorQueueDepth, frameDropPolicyToNative(frameProcessorDropPolicy), frameProcessorBlockTimeout)
+        configureFrameRateController()
+        configureChangeDetection(frameProcessorChangeThreshold)
+        configureFrameRetention(max(frameProcessorMaxRetainedFrames, 0))
         imageAnalysis = imageAnalysisBuilder.build().apply {
           setAnalyzer(cameraExecutor, { image ->
-            val now = System.currentTimeMillis()
-            val intervalMs = (1.0 / actualFrameProcessorFps) * 1000.0
-            if (now - lastFrameProcessorCall > intervalMs) {
-              lastFrameProcessorCall = now
-
-              val perfSample = frameProcessorPerformanceDataCollector.beginPerformanceSampleCollection()
-              frameProcessorCallback(image)
-              perfSample.endPerformanceSampleCollection()
-            }
-            image.close()
-
-            if (isReadyForNewEvaluation) {
-              // last evaluation was more than a second ago, evaluate again
-              evaluateNewPerformanceSamples()
-            }
+            // the native side decides whether the Frame is processed or throttled, see configureFrameRateController()
+            callFrameProcessor(image, System.nanoTime())
           })
         }
         useCases.add(imageAnalysis!!)
@@ -529,21 +572,45 @@ class CameraViewOld(context: Context, private val frameProcessorThread: Executor
     }
   }
 
-  private fun evaluateNewPerformanceSamples() {
-    lastFrameProcessorPerformanceEvaluation = System.currentTimeMillis()
-    val maxFrameProcessorFps = 30 // TODO: Get maxFrameProcessorFps from ImageAnalyser
-    val averageFps = 1.0 / frameProcessorPerformanceDataCollector.averageExecutionTimeSeconds
-    val suggestedFrameProcessorFps = floor(min(averageFps, maxFrameProcessorFps.toDouble()))
+  private fun frameDropPolicyToNative(policy: String): Int {
+    // must be in the same order as the C++ FrameDropPolicy enum
+    return when (policy) {
+      "drop-oldest" -> 0
+      "drop-newest" -> 1
+      "keep-latest" -> 2
+      "block" -> 3
+      else -> throw InvalidTypeScriptUnionError("frameProcessorDropPolicy", policy)
+    }
+  }
 
-    if (frameProcessorFps == -1.0) {
-      // frameProcessorFps="auto"
-      actualFrameProcessorFps = suggestedFrameProcessorFps
-    } else {
+  private fun configureFrameRateController() {
+    // must be in the same order as the C++ FrameRateMode enum
+    val mode = when {
+      frameProcessorFps != -1.0 -> 0
+      frameProcessorRateMode == "throughput" -> 1
+      frameProcessorRateMode == "latency" -> 2
+      else -> throw InvalidTypeScriptUnionError("frameProcessorRateMode", frameProcessorRateMode)
+    }
+    configureFrameRate(mode, frameProcessorFps, frameProcessorLatencyBudget)
+  }
+
+  /**
+   * Called by the native FrameRateController (on the Frame Processor thread) when it changed the Frame Processor's rate,
+   * or, if [frameProcessorFps] is fixed, when it has a new suggestion. Durations are in milliseconds.
+   */
+  @DoNotStrip
+  @Keep
+  private fun onFrameRateDecision(mode: Int, fps: Double, previousFps: Double, suggestedFps: Double, cameraFps: Double,
+                                  averageExecutionTime: Double, averageLatency: Double) {
+    if (mode == 0) {
       // frameProcessorFps={someCustomFpsValue}
-      if (suggestedFrameProcessorFps != lastSuggestedFrameProcessorFps && suggestedFrameProcessorFps != frameProcessorFps) {
-        invokeOnFrameProcessorPerformanceSuggestionAvailable(frameProcessorFps, suggestedFrameProcessorFps)
-        lastSuggestedFrameProcessorFps = suggestedFrameProcessorFps
+      if (suggestedFps != lastSuggestedFrameProcessorFps && suggestedFps != frameProcessorFps) {
+        invokeOnFrameProcessorPerformanceSuggestionAvailable(frameProcessorFps, suggestedFps)
+        lastSuggestedFrameProcessorFps = suggestedFps
       }
+    } else {
+      // frameProcessorFps="auto"
+      invokeOnFrameProcessorFpsChanged(fps, previousFps, cameraFps, averageExecutionTime, averageLatency)
     }
   }
 }
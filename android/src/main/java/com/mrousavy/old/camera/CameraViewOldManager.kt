@@ -28,6 +28,7 @@ class CameraViewOldManager(reactContext: ReactApplicationContext) : ViewGroupMan
       .put("cameraInitialized", MapBuilder.of("registrationName", "onInitialized"))
       .put("cameraError", MapBuilder.of("registrationName", "onError"))
       .put("cameraPerformanceSuggestionAvailable", MapBuilder.of("registrationName", "onFrameProcessorPerformanceSuggestionAvailable"))
+      .put("cameraFrameProcessorFpsChanged", MapBuilder.of("registrationName", "onFrameProcessorFpsChanged"))
       .build()
   }
 
@@ -115,6 +116,71 @@ class CameraViewOldManager(reactContext: ReactApplicationContext) : ViewGroupMan
     view.frameProcessorFps = frameProcessorFps
   }
 
+  @ReactProp(name = "frameProcessorRateMode")
+  fun setFrameProcessorRateMode(view: CameraViewOld, frameProcessorRateMode: String?) {
+    val mode = frameProcessorRateMode ?: "throughput"
+    if (view.frameProcessorRateMode != mode)
+      addChangedPropToTransaction(view, "frameProcessorRateMode")
+    view.frameProcessorRateMode = mode
+  }
+
+  @ReactProp(name = "frameProcessorLatencyBudget", defaultDouble = 100.0)
+  fun setFrameProcessorLatencyBudget(view: CameraViewOld, frameProcessorLatencyBudget: Double) {
+    if (view.frameProcessorLatencyBudget != frameProcessorLatencyBudget)
+      addChangedPropToTransaction(view, "frameProcessorLatencyBudget")
+    view.frameProcessorLatencyBudget = frameProcessorLatencyBudget
+  }
+
+  @ReactProp(name = "frameProcessorChangeThreshold", defaultDouble = 0.0)
+  fun setFrameProcessorChangeThreshold(view: CameraViewOld, frameProcessorChangeThreshold: Double) {
+    if (view.frameProcessorChangeThreshold != frameProcessorChangeThreshold)
+      addChangedPropToTransaction(view, "frameProcessorChangeThreshold")
+    view.frameProcessorChangeThreshold = frameProcessorChangeThreshold
+  }
+
+  @ReactProp(name = "frameProcessorQueueDepth", defaultInt = 1)
+  fun setFrameProcessorQueueDepth(view: CameraViewOld, frameProcessorQueueDepth: Int) {
+    if (view.frameProcessorQueueDepth != frameProcessorQueueDepth)
+      addChangedPropToTransaction(view, "frameProcessorQueueDepth")
+    view.frameProcessorQueueDepth = frameProcessorQueueDepth
+  }
+
+  @ReactProp(name = "frameProcessorRuntimes", defaultInt = 1)
+  fun setFrameProcessorRuntimes(view: CameraViewOld, frameProcessorRuntimes: Int) {
+    if (view.frameProcessorRuntimes != frameProcessorRuntimes)
+      addChangedPropToTransaction(view, "frameProcessorRuntimes")
+    view.frameProcessorRuntimes = frameProcessorRuntimes
+  }
+
+  @ReactProp(name = "frameProcessorMaxAsyncTasks", defaultInt = 0)
+  fun setFrameProcessorMaxAsyncTasks(view: CameraViewOld, frameProcessorMaxAsyncTasks: Int) {
+    if (view.frameProcessorMaxAsyncTasks != frameProcessorMaxAsyncTasks)
+      addChangedPropToTransaction(view, "frameProcessorMaxAsyncTasks")
+    view.frameProcessorMaxAsyncTasks = frameProcessorMaxAsyncTasks
+  }
+
+  @ReactProp(name = "frameProcessorMaxRetainedFrames", defaultInt = 1)
+  fun setFrameProcessorMaxRetainedFrames(view: CameraViewOld, frameProcessorMaxRetainedFrames: Int) {
+    if (view.frameProcessorMaxRetainedFrames != frameProcessorMaxRetainedFrames)
+      addChangedPropToTransaction(view, "frameProcessorMaxRetainedFrames")
+    view.frameProcessorMaxRetainedFrames = frameProcessorMaxRetainedFrames
+  }
+
+  @ReactProp(name = "frameProcessorDropPolicy")
+  fun setFrameProcessorDropPolicy(view: CameraViewOld, frameProcessorDropPolicy: String?) {
+    val policy = frameProcessorDropPolicy ?: "keep-latest"
+    if (view.frameProcessorDropPolicy != policy)
+      addChangedPropToTransaction(view, "frameProcessorDropPolicy")
+    view.frameProcessorDropPolicy = policy
+  }
+
+  @ReactProp(name = "frameProcessorBlockTimeout", defaultInt = 100)
+  fun setFrameProcessorBlockTimeout(view: CameraViewOld, frameProcessorBlockTimeout: Int) {
+    if (view.frameProcessorBlockTimeout != frameProcessorBlockTimeout)
+      addChangedPropToTransaction(view, "frameProcessorBlockTimeout")
+    view.frameProcessorBlockTimeout = frameProcessorBlockTimeout
+  }
+
   @ReactProp(name = "hdr")
   fun setHdr(view: CameraViewOld, hdr: Boolean?) {
     if (view.hdr != hdr)
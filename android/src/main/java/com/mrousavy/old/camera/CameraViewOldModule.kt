@@ -63,7 +63,7 @@ class CameraViewOldModule(reactContext: ReactApplicationContext) : ReactContextB
 
     if (frameProcessorManager == null) {
       frameProcessorThread.execute {
-        frameProcessorManager = FrameProcessorRuntimeManagerOld(reactApplicationContext, frameProcessorThread)
+        frameProcessorManager = FrameProcessorRuntimeManagerOld(reactApplicationContext)
       }
     }
   }
@@ -0,0 +1,79 @@
+package com.mrousavy.old.camera.frameprocessor;
+
+import android.graphics.Rect;
+import android.media.Image;
+import androidx.annotation.Keep;
+import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
+import androidx.camera.core.ExperimentalGetImage;
+import androidx.camera.core.ImageInfo;
+import androidx.camera.core.ImageProxy;
+import com.facebook.proguard.annotations.DoNotStrip;
+
+/**
+ * An {@link ImageProxy} that shares the image of another one, but has its own crop rect.
+ * Created for every plugin call with a {@code frame.crop(...)}, so the Frame's ImageProxy is never modified by a plugin call.
+ */
+@DoNotStrip
+@Keep
+class CroppedImageProxy implements ImageProxy {
+    private final @NonNull ImageProxy mImage;
+    private @NonNull Rect mCropRect;
+
+    @DoNotStrip
+    @Keep
+    CroppedImageProxy(@NonNull ImageProxy image, int x, int y, int width, int height) {
+        mImage = image;
+        mCropRect = new Rect(x, y, x + width, y + height);
+    }
+
+    @Override
+    public void close() {
+        // the image belongs to the Frame, which closes it.
+    }
+
+    @NonNull
+    @Override
+    public Rect getCropRect() {
+        return mCropRect;
+    }
+
+    @Override
+    public void setCropRect(@Nullable Rect rect) {
+        mCropRect = rect != null ? new Rect(rect) : new Rect(0, 0, getWidth(), getHeight());
+    }
+
+    @Override
+    public int getFormat() {
+        return mImage.getFormat();
+    }
+
+    @Override
+    public int getHeight() {
+        return mImage.getHeight();
+    }
+
+    @Override
+    public int getWidth() {
+        return mImage.getWidth();
+    }
+
+    @NonNull
+    @Override
+    public PlaneProxy[] getPlanes() {
+        return mImage.getPlanes();
+    }
+
+    @NonNull
+    @Override
+    public ImageInfo getImageInfo() {
+        return mImage.getImageInfo();
+    }
+
+    @Nullable
+    @Override
+    @ExperimentalGetImage
+    public Image getImage() {
+        return mImage.getImage();
+    }
+}
@@ -17,9 +17,14 @@ public abstract class FrameProcessorPlugin {
     /**
      * The actual Frame Processor plugin callback. Called for every frame the ImageAnalyzer receives.
      * @param image The CameraX ImageProxy. Don't call .close() on this, as VisionCameraOld handles that.
+     *              If the plugin was called with a {@code frame.crop(...)}, {@link ImageProxy#getCropRect()} is the cropped region
+     *              (the ImageProxy is then a view of the Frame's image that is only valid until this method returns).
+     * @param params The parameters passed from JS. ArrayBuffers and typed arrays are passed as direct
+     *               {@link java.nio.ByteBuffer}s that point into JS memory, so they are only valid until this method returns.
      * @return You can return any primitive, map or array you want. See the
      * <a href="https://react-native-vision-camera-old.com/docs/guides/frame-processors-plugins-overview#types">Types</a>
-     * table for a list of supported types.
+     * table for a list of supported types. Primitive arrays (e.g. {@code float[]}) are returned as JS typed arrays,
+     * and {@link java.nio.ByteBuffer}s as ArrayBuffers (zero-copy for direct buffers).
      */
     @DoNotStrip
     @Keep
@@ -45,9 +50,11 @@ public abstract class FrameProcessorPlugin {
 
     /**
      * Registers the given plugin in the Frame Processor Runtime.
+     * Plugins can be registered at any time (e.g. in {@code MainApplication.onCreate}), a Frame Processor can call
+     * them once it has been set after the plugin was registered.
      * @param plugin An instance of a plugin.
      */
     public static void register(@NonNull FrameProcessorPlugin plugin) {
-        FrameProcessorRuntimeManagerOld.Companion.getPlugins().add(plugin);
+        FrameProcessorRuntimeManagerOld.addPlugin(plugin);
     }
 }
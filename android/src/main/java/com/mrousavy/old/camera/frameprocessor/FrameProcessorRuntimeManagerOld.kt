@@ -10,10 +10,9 @@ import com.facebook.react.uimanager.UIManagerHelper
 import com.mrousavy.old.camera.CameraViewOld
 import com.mrousavy.old.camera.ViewNotFoundError
 import java.lang.ref.WeakReference
-import java.util.concurrent.ExecutorService
 
 @Suppress("KotlinJniMissingFunction") // I use fbjni, Android Studio is not smart enough to realize that.
-class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext, frameProcessorThread: ExecutorService) {
+class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext) {
   companion object {
     const val TAG = "FrameProcessorRuntime"
     val Plugins: ArrayList<FrameProcessorPlugin> = ArrayList()
@@ -28,6 +27,22 @@ class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext, framePro
         enableFrameProcessors = false
       }
     }
+
+    /**
+     * Adds the plugin and hands it to C++, which installs it into every worklet runtime with its next Frame Processor.
+     */
+    @JvmStatic
+    fun addPlugin(plugin: FrameProcessorPlugin) {
+      Plugins.add(plugin)
+      if (enableFrameProcessors) {
+        registerPlugin(plugin)
+      }
+    }
+
+    // static, so plugins don't need a FrameProcessorRuntimeManagerOld. Use addPlugin() instead.
+    @JvmStatic
+    @DoNotStrip
+    external fun registerPlugin(plugin: FrameProcessorPlugin)
   }
 
   @DoNotStrip
@@ -40,7 +55,7 @@ class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext, framePro
       val holder = context.catalystInstance.jsCallInvokerHolder as CallInvokerHolderImpl
       val jsRuntimeHolder =
         context.javaScriptContextHolder?.get() ?: throw Error("JSI Runtime is null! VisionCameraOld does not yet support bridgeless mode..")
-      mScheduler = VisionCameraOldScheduler(frameProcessorThread)
+      mScheduler = VisionCameraOldScheduler()
       mContext = WeakReference(context)
       mHybridData = initHybrid(jsRuntimeHolder, holder, mScheduler!!)
       initializeRuntime()
@@ -63,17 +78,6 @@ class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext, framePro
     return view ?: throw ViewNotFoundError(viewId)
   }
 
-  @Suppress("unused")
-  @DoNotStrip
-  @Keep
-  fun registerPlugins() {
-    Log.i(TAG, "Installing Frame Processor Plugins...")
-    Plugins.forEach { plugin ->
-      registerPlugin(plugin)
-    }
-    Log.i(TAG, "Successfully installed ${Plugins.count()} Frame Processor Plugins!")
-  }
-
   // private C++ funcs
   private external fun initHybrid(
     jsContext: Long,
@@ -81,6 +85,5 @@ class FrameProcessorRuntimeManagerOld(context: ReactApplicationContext, framePro
     scheduler: VisionCameraOldScheduler
   ): HybridData
   private external fun initializeRuntime()
-  private external fun registerPlugin(plugin: FrameProcessorPlugin)
   private external fun installJSIBindings()
 }
@@ -2,25 +2,19 @@ package com.mrousavy.old.camera.frameprocessor;
 
 import com.facebook.jni.HybridData;
 import com.facebook.proguard.annotations.DoNotStrip;
-import java.util.concurrent.ExecutorService;
 
+/**
+ * Owns the C++ task scheduler, which runs Frame Processor work on its own worker threads.
+ */
 @SuppressWarnings("JavaJniMissingFunction") // using fbjni here
 public class VisionCameraOldScheduler {
     @SuppressWarnings({"unused", "FieldCanBeLocal"})
     @DoNotStrip
     private final HybridData mHybridData;
-    private final ExecutorService frameProcessorThread;
 
-    public VisionCameraOldScheduler(ExecutorService frameProcessorThread) {
-        this.frameProcessorThread = frameProcessorThread;
+    public VisionCameraOldScheduler() {
         mHybridData = initHybrid();
     }
 
     private native HybridData initHybrid();
-
-    @SuppressWarnings("unused")
-    @DoNotStrip
-    private void scheduleOnUI(Runnable runnable) {
-        frameProcessorThread.submit(runnable);
-    }
 }
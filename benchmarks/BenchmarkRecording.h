@@ -0,0 +1,24 @@
+#pragma once
+
+#include <FrameRecording.h>
+
+#include <cstdlib>
+#include <memory>
+
+namespace vision {
+namespace benchmarks {
+
+/**
+ * The Frame recording at `$VISION_CAMERA_RECORDING` (see Camera.startFrameRecording()), or null if it is not set.
+ * Benchmarks that replay real-world Frames are skipped without one.
+ */
+inline std::shared_ptr<FrameRecording> getBenchmarkRecording() {
+  static auto recording = []() -> std::shared_ptr<FrameRecording> {
+    auto path = std::getenv("VISION_CAMERA_RECORDING");
+    return path != nullptr ? FrameRecording::open(path) : nullptr;
+  }();
+  return recording;
+}
+
+} // namespace benchmarks
+} // namespace vision
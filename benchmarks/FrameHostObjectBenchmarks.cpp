@@ -0,0 +1,258 @@
+#include <benchmark/benchmark.h>
+
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include <FrameHostObjectBase.h>
+#include <FrameProcessorPluginNative.h>
+#include <FrameProcessorPluginRegistryNative.h>
+#include <FrameProperties.h>
+#include <RuntimeThreadScope.h>
+#include <TypedArrays.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkRecording.h"
+#include "SyntheticFrame.h"
+
+namespace vision {
+namespace benchmarks {
+
+using namespace facebook;
+
+namespace {
+
+constexpr int kFrameWidth = 1280;
+constexpr int kFrameHeight = 720;
+// property reads per call into JS, so the call itself doesn't dominate the measurement.
+constexpr int kReadsPerCall = 1000;
+
+/**
+ * A Frame HostObject that wraps a SyntheticFrame instead of a Camera Frame, closing it is a no-op.
+ */
+class SyntheticFrameHostObject : public FrameHostObjectBase {
+ public:
+  explicit SyntheticFrameHostObject(const FrameDescriptor& descriptor): FrameHostObjectBase(descriptor) { }
+  void close() override { invalidate(); }
+};
+
+/**
+ * A native plugin that does no work, to measure the overhead of calling a plugin from a worklet.
+ */
+class NoopPlugin : public FrameProcessorPluginNative {
+ public:
+  std::string getName() const override { return "benchmarkNoop"; }
+  jsi::Value callback(jsi::Runtime& runtime, const FrameDescriptor& frame, const jsi::Value* arguments, size_t count) override {
+    return jsi::Value(frame.width);
+  }
+};
+VISION_EXPORT_NATIVE_FRAME_PROCESSOR_PLUGIN(NoopPlugin)
+
+/**
+ * A Hermes runtime with the native plugins installed, like the Frame Processor's worklet runtime.
+ */
+struct HermesContext {
+  std::unique_ptr<jsi::Runtime> runtime = hermes::makeHermesRuntime();
+  SyntheticFrame frame { kFrameWidth, kFrameHeight };
+
+  HermesContext() {
+    RuntimeThreadScope runtimeScope(*runtime);
+    FrameProcessorPluginRegistryNative::shared().installPlugins(*runtime);
+  }
+
+  jsi::Function evaluateFunction(const std::string& source) {
+    auto buffer = std::make_shared<jsi::StringBuffer>("(" + source + ")");
+    return runtime->evaluateJavaScript(buffer, "benchmark.js").asObject(*runtime).asFunction(*runtime);
+  }
+
+  std::shared_ptr<SyntheticFrameHostObject> createFrame() {
+    return std::make_shared<SyntheticFrameHostObject>(frame.getDescriptor());
+  }
+};
+
+void BM_FramePropertyAccess(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto readProperties = context.evaluateFunction(
+    "function(frame, count) { let sum = 0; for (let i = 0; i < count; i++) { sum += frame.width + frame.height; } return sum; }");
+
+  bool isHostObject = state.range(0) != 0;
+  auto frameHostObject = context.createFrame();
+  jsi::Object frame = isHostObject ? jsi::Object::createFromHostObject(runtime, frameHostObject) : jsi::Object(runtime);
+  if (!isHostObject) {
+    // a plain JS object as the baseline
+    frame.setProperty(runtime, "width", kFrameWidth);
+    frame.setProperty(runtime, "height", kFrameHeight);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(readProperties.call(runtime, frame, kReadsPerCall));
+  }
+  state.SetItemsProcessed(state.iterations() * kReadsPerCall * 2);
+}
+BENCHMARK(BM_FramePropertyAccess)->ArgName("hostObject")->Arg(0)->Arg(1);
+
+/**
+ * Frame HostObject accesses through FrameHostObject::get(): a property, two methods and a name a Frame doesn't have.
+ * `utf8` only resolves the names the way they were resolved before, by converting them to strings and hashing those, as a baseline.
+ */
+void BM_FrameHostObjectGet(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto frameHostObject = context.createFrame();
+  // property keys of JS accesses, as Hermes passes them to the HostObject.
+  std::vector<jsi::PropNameID> names;
+  for (const auto* name : { "width", "close", "toString", "someOtherProperty" }) {
+    names.push_back(jsi::PropNameID::forAscii(runtime, name));
+  }
+
+  bool isUtf8 = state.range(0) != 0;
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto& name = names[i++ % names.size()];
+    if (isUtf8) {
+      benchmark::DoNotOptimize(findFrameProperty(name.utf8(runtime)));
+    } else {
+      benchmark::DoNotOptimize(frameHostObject->get(runtime, name));
+    }
+  }
+}
+BENCHMARK(BM_FrameHostObjectGet)->ArgName("utf8")->Arg(0)->Arg(1);
+
+void BM_FrameGetPlane(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto getPlane = context.evaluateFunction("function(frame) { return frame.getPlane(0).buffer.byteLength; }");
+  auto frame = jsi::Object::createFromHostObject(runtime, context.createFrame());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(getPlane.call(runtime, frame));
+  }
+}
+BENCHMARK(BM_FrameGetPlane);
+
+void BM_FrameToArrayBuffer(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto toArrayBuffer = context.evaluateFunction("function(frame) { return frame.toArrayBuffer().byteLength; }");
+  auto frame = jsi::Object::createFromHostObject(runtime, context.createFrame());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toArrayBuffer.call(runtime, frame));
+  }
+}
+BENCHMARK(BM_FrameToArrayBuffer);
+
+void BM_FrameToRGB(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto toRGB = context.evaluateFunction("function(frame) { return frame.toRGB({ format: 'rgb' }).byteLength; }");
+  auto frame = jsi::Object::createFromHostObject(runtime, context.createFrame());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toRGB.call(runtime, frame));
+  }
+}
+BENCHMARK(BM_FrameToRGB);
+
+/**
+ * Converting a quarter of the Frame through `crop()`, compare with BM_FrameToRGB.
+ */
+void BM_FrameCropToRGB(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto cropToRGB = context.evaluateFunction(
+      "function(frame) { return frame.crop({ x: 321, y: 181, width: frame.width / 2, height: frame.height / 2 }).toRGB().byteLength; }");
+  auto frame = jsi::Object::createFromHostObject(runtime, context.createFrame());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cropToRGB.call(runtime, frame));
+  }
+}
+BENCHMARK(BM_FrameCropToRGB);
+
+void BM_CreateTypedArray(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto arrayBuffer = context.evaluateFunction("function() { return new ArrayBuffer(400); }").call(runtime).asObject(runtime);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(createTypedArray(runtime, "Float32Array", arrayBuffer.getArrayBuffer(runtime)));
+  }
+}
+BENCHMARK(BM_CreateTypedArray);
+
+void BM_IsArrayBufferView(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  bool isView = state.range(0) != 0;
+  auto source = isView ? "function() { return new Float32Array(100); }" : "function() { return { x: 1, y: 2 }; }";
+  auto object = context.evaluateFunction(source).call(runtime).asObject(runtime);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(isArrayBufferView(runtime, object));
+  }
+}
+BENCHMARK(BM_IsArrayBufferView)->ArgName("typedArray")->Arg(0)->Arg(1);
+
+void BM_NativePluginCall(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto callPlugin = context.evaluateFunction("function(frame) { return __benchmarkNoop(frame, { threshold: 0.5 }); }");
+  auto frame = jsi::Object::createFromHostObject(runtime, context.createFrame());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(callPlugin.call(runtime, frame));
+  }
+}
+BENCHMARK(BM_NativePluginCall);
+
+/**
+ * One Frame through the worklet runtime the way the Frame Processor calls it: wrap the Frame in a HostObject,
+ * call the worklet, and release the Frame Processor's reference.
+ */
+void BM_WorkletInvocation(benchmark::State& state) {
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto worklet = context.evaluateFunction("function(frame) { 'worklet'; return frame.width * frame.height; }");
+
+  for (auto _ : state) {
+    auto frameHostObject = context.createFrame();
+    auto frame = jsi::Object::createFromHostObject(runtime, frameHostObject);
+    benchmark::DoNotOptimize(worklet.call(runtime, frame));
+    frameHostObject->decrementRefCount();
+  }
+}
+BENCHMARK(BM_WorkletInvocation);
+
+/**
+ * The recorded Frames through a worklet that calls a native plugin, at maximum speed. Replace the worklet's source
+ * with the Frame Processor you are investigating to reproduce its performance with real-world content.
+ */
+void BM_ReplayWorkletInvocation(benchmark::State& state) {
+  auto recording = getBenchmarkRecording();
+  if (recording == nullptr || recording->size() == 0) {
+    state.SkipWithError("Set VISION_CAMERA_RECORDING to a Frame recording to replay it");
+    return;
+  }
+  HermesContext context;
+  auto& runtime = *context.runtime;
+  auto worklet = context.evaluateFunction("function(frame) { 'worklet'; return __benchmarkNoop(frame) + frame.toRGB().byteLength; }");
+
+  size_t index = 0;
+  for (auto _ : state) {
+    auto frameHostObject = std::make_shared<SyntheticFrameHostObject>(recording->getFrame(index++ % recording->size()));
+    auto frame = jsi::Object::createFromHostObject(runtime, frameHostObject);
+    benchmark::DoNotOptimize(worklet.call(runtime, frame));
+    frameHostObject->decrementRefCount();
+  }
+}
+BENCHMARK(BM_ReplayWorkletInvocation);
+
+} // namespace
+
+} // namespace benchmarks
+} // namespace vision
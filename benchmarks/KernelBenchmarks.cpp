@@ -0,0 +1,367 @@
+#include <benchmark/benchmark.h>
+
+#include <BufferPool.h>
+#include <FrameChangeDetector.h>
+#include <FrameQueue.h>
+#include <FrameRateController.h>
+#include <FrameRecording.h>
+#include <FrameSequencer.h>
+#include <FrameTracer.h>
+#include <FrameWorkerPool.h>
+#include <InFlightLimiter.h>
+#include <LatencyHistogram.h>
+#include <TaskScheduler.h>
+#include <WorkStealingPool.h>
+#include <kernels/FrameToTensor.h>
+#include <kernels/LumaChange.h>
+#include <kernels/LumaStatistics.h>
+#include <kernels/YUVToRGB.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkRecording.h"
+#include "SyntheticFrame.h"
+
+namespace vision {
+namespace benchmarks {
+
+namespace {
+
+// 480p, 720p and 1080p, the Frame sizes CameraX delivers to Frame Processors most often.
+void applyFrameSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({ 640, 480 })->Args({ 1280, 720 })->Args({ 1920, 1080 });
+}
+
+void BM_YUVToRGB(benchmark::State& state, kernels::KernelImplementation implementation, kernels::RGBFormat format) {
+  if (!kernels::isKernelImplementationSupported(implementation)) {
+    state.SkipWithError("Kernel implementation is not supported on this CPU");
+    return;
+  }
+  SyntheticFrame frame(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  auto descriptor = frame.getDescriptor();
+  kernels::YUVImage image;
+  kernels::describeYUVImage(descriptor, image);
+
+  size_t dstRowStride = static_cast<size_t>(descriptor.width) * kernels::bytesPerPixel(format);
+  std::vector<uint8_t> dst(dstRowStride * descriptor.height);
+  for (auto _ : state) {
+    kernels::convertYUVToRGB(image, format, dst.data(), dstRowStride, implementation);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * descriptor.width * descriptor.height);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(dst.size()));
+}
+BENCHMARK_CAPTURE(BM_YUVToRGB, Scalar/RGB, kernels::KernelImplementation::Scalar, kernels::RGBFormat::RGB)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_YUVToRGB, SSE41/RGB, kernels::KernelImplementation::SSE41, kernels::RGBFormat::RGB)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_YUVToRGB, AVX2/RGB, kernels::KernelImplementation::AVX2, kernels::RGBFormat::RGB)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_YUVToRGB, NEON/RGB, kernels::KernelImplementation::NEON, kernels::RGBFormat::RGB)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_YUVToRGB, Auto/RGBA, kernels::KernelImplementation::Auto, kernels::RGBFormat::RGBA)->Apply(applyFrameSizes);
+
+/**
+ * YUV to RGB with the recorded Frames, so the kernels see real-world content, strides and Frame sizes.
+ */
+void BM_ReplayYUVToRGB(benchmark::State& state) {
+  auto recording = getBenchmarkRecording();
+  if (recording == nullptr || recording->size() == 0) {
+    state.SkipWithError("Set VISION_CAMERA_RECORDING to a Frame recording to replay it");
+    return;
+  }
+  std::vector<uint8_t> dst;
+  size_t index = 0;
+  int64_t pixels = 0;
+  for (auto _ : state) {
+    auto descriptor = recording->getFrame(index++ % recording->size());
+    kernels::YUVImage image;
+    if (!kernels::describeYUVImage(descriptor, image)) {
+      state.SkipWithError("The recording does not contain YUV Frames");
+      return;
+    }
+    size_t dstRowStride = static_cast<size_t>(descriptor.width) * kernels::bytesPerPixel(kernels::RGBFormat::RGB);
+    dst.resize(dstRowStride * descriptor.height);
+    kernels::convertYUVToRGB(image, kernels::RGBFormat::RGB, dst.data(), dstRowStride);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+    pixels += static_cast<int64_t>(descriptor.width) * descriptor.height;
+  }
+  state.SetItemsProcessed(pixels);
+}
+BENCHMARK(BM_ReplayYUVToRGB);
+
+void BM_FrameToTensor(benchmark::State& state, kernels::TensorDataType dataType, kernels::TensorLayout layout) {
+  SyntheticFrame frame(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  auto descriptor = frame.getDescriptor();
+
+  // a typical classification model input
+  kernels::TensorOptions options;
+  options.width = 224;
+  options.height = 224;
+  options.crop = { 0, 0, descriptor.width, descriptor.height };
+  options.dataType = dataType;
+  options.layout = layout;
+  options.resizeMode = kernels::ResizeMode::Area;
+  options.mean = { 123.675f, 116.28f, 103.53f };
+  options.std = { 58.395f, 57.12f, 57.375f };
+
+  std::vector<uint8_t> dst(kernels::getTensorByteSize(options));
+  for (auto _ : state) {
+    kernels::convertFrameToTensor(descriptor, options, dst.data());
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_FrameToTensor, Float32/NHWC, kernels::TensorDataType::Float32, kernels::TensorLayout::NHWC)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_FrameToTensor, Float32/NCHW, kernels::TensorDataType::Float32, kernels::TensorLayout::NCHW)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_FrameToTensor, UInt8/NHWC, kernels::TensorDataType::UInt8, kernels::TensorLayout::NHWC)->Apply(applyFrameSizes);
+
+void BM_LumaChange(benchmark::State& state, kernels::KernelImplementation implementation) {
+  if (!kernels::isKernelImplementationSupported(implementation)) {
+    state.SkipWithError("Kernel implementation is not supported on this CPU");
+    return;
+  }
+  SyntheticFrame frame(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  auto descriptor = frame.getDescriptor();
+  kernels::YUVImage image;
+  kernels::describeYUVImage(descriptor, image);
+
+  constexpr int gridWidth = FrameChangeDetector::kGridWidth;
+  constexpr int gridHeight = FrameChangeDetector::kGridHeight;
+  std::vector<uint8_t> reference(gridWidth * gridHeight);
+  std::vector<uint8_t> grid(gridWidth * gridHeight);
+  kernels::sampleLumaGrid(image.y, image.yRowStride, image.width, image.height, gridWidth, gridHeight, reference.data(), implementation);
+  for (auto _ : state) {
+    kernels::sampleLumaGrid(image.y, image.yRowStride, image.width, image.height, gridWidth, gridHeight, grid.data(), implementation);
+    benchmark::DoNotOptimize(kernels::sumOfAbsoluteDifferences(grid.data(), reference.data(), grid.size(), implementation));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_LumaChange, Scalar, kernels::KernelImplementation::Scalar)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaChange, SSE41, kernels::KernelImplementation::SSE41)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaChange, AVX2, kernels::KernelImplementation::AVX2)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaChange, NEON, kernels::KernelImplementation::NEON)->Apply(applyFrameSizes);
+
+// everything getLumaStatistics() can compute at once: the histogram, a 4x4 grid and the sharpness.
+void BM_LumaStatistics(benchmark::State& state, kernels::KernelImplementation implementation) {
+  if (!kernels::isKernelImplementationSupported(implementation)) {
+    state.SkipWithError("Kernel implementation is not supported on this CPU");
+    return;
+  }
+  SyntheticFrame frame(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  auto descriptor = frame.getDescriptor();
+  kernels::YUVImage image;
+  kernels::describeYUVImage(descriptor, image);
+
+  std::vector<uint32_t> histogram(kernels::kLumaHistogramBins);
+  std::vector<float> gridMean(4 * 4);
+  std::vector<float> gridVariance(4 * 4);
+  kernels::LumaStatisticsOptions options;
+  options.histogram = histogram.data();
+  options.gridColumns = 4;
+  options.gridRows = 4;
+  options.gridMean = gridMean.data();
+  options.gridVariance = gridVariance.data();
+  options.sharpness = true;
+  for (auto _ : state) {
+    auto statistics = kernels::computeLumaStatistics(image.y, image.yRowStride, image.width, image.height, options, implementation);
+    benchmark::DoNotOptimize(statistics);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image.width) * image.height);
+}
+BENCHMARK_CAPTURE(BM_LumaStatistics, Scalar, kernels::KernelImplementation::Scalar)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaStatistics, SSE41, kernels::KernelImplementation::SSE41)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaStatistics, AVX2, kernels::KernelImplementation::AVX2)->Apply(applyFrameSizes);
+BENCHMARK_CAPTURE(BM_LumaStatistics, NEON, kernels::KernelImplementation::NEON)->Apply(applyFrameSizes);
+
+void BM_BufferPoolAcquire(benchmark::State& state) {
+  auto pool = std::make_shared<BufferPool>();
+  auto size = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    auto buffer = pool->acquire(size);
+    benchmark::DoNotOptimize(buffer->data());
+  }
+}
+// the size of a 720p RGB Frame
+BENCHMARK(BM_BufferPoolAcquire)->Arg(1280 * 720 * 3);
+
+void BM_FrameQueuePushPop(benchmark::State& state) {
+  FrameQueueConfig config;
+  config.depth = static_cast<size_t>(state.range(0));
+  config.policy = FrameDropPolicy::DropOldest;
+  FrameQueue<int> queue(config);
+  auto onDrop = [](std::unique_ptr<int>) { };
+  for (auto _ : state) {
+    queue.push(std::make_unique<int>(1), onDrop);
+    benchmark::DoNotOptimize(queue.pop(std::chrono::milliseconds(0)));
+  }
+}
+BENCHMARK(BM_FrameQueuePushPop)->Arg(1)->Arg(3);
+
+// the time from schedule() until the task starts running on its lane's worker.
+void BM_TaskSchedulerLatency(benchmark::State& state, TaskLane lane) {
+  TaskScheduler scheduler;
+  std::atomic<int64_t> startedAt { 0 };
+  for (auto _ : state) {
+    startedAt.store(0, std::memory_order_relaxed);
+    auto scheduledAt = std::chrono::steady_clock::now();
+    scheduler.schedule(lane, [&startedAt]() {
+      startedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+    });
+    int64_t ran = 0;
+    while ((ran = startedAt.load(std::memory_order_acquire)) == 0) {
+      // yield instead of spinning, so the worker gets a core even on single core machines.
+      std::this_thread::yield();
+    }
+    auto latency = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ran)) - scheduledAt;
+    state.SetIterationTime(std::chrono::duration<double>(latency).count());
+  }
+}
+BENCHMARK_CAPTURE(BM_TaskSchedulerLatency, Frame, TaskLane::Frame)->UseManualTime();
+BENCHMARK_CAPTURE(BM_TaskSchedulerLatency, Plugin, TaskLane::Plugin)->UseManualTime();
+
+// the same, with the worker asleep - a task that arrives after a quiet period (e.g. once per Frame) pays for the wake-up.
+void BM_TaskSchedulerWakeUpLatency(benchmark::State& state) {
+  TaskScheduler scheduler;
+  std::atomic<int64_t> startedAt { 0 };
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    state.ResumeTiming();
+    startedAt.store(0, std::memory_order_relaxed);
+    auto scheduledAt = std::chrono::steady_clock::now();
+    scheduler.schedule(TaskLane::Frame, [&startedAt]() {
+      startedAt.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+    });
+    int64_t ran = 0;
+    while ((ran = startedAt.load(std::memory_order_acquire)) == 0) {
+      std::this_thread::yield();
+    }
+    auto latency = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ran)) - scheduledAt;
+    state.SetIterationTime(std::chrono::duration<double>(latency).count());
+  }
+}
+BENCHMARK(BM_TaskSchedulerWakeUpLatency)->UseManualTime()->Iterations(200);
+
+// many threads scheduling onto the same lane at once, the worker drains the lane as fast as it can.
+void BM_TaskSchedulerSubmit(benchmark::State& state) {
+  static TaskScheduler* scheduler = nullptr;
+  static std::atomic<int64_t> executed { 0 };
+  if (state.thread_index() == 0) {
+    scheduler = new TaskScheduler();
+    executed = 0;
+  }
+  for (auto _ : state) {
+    scheduler->schedule(TaskLane::Plugin, []() { executed.fetch_add(1, std::memory_order_relaxed); });
+  }
+  if (state.thread_index() == 0) {
+    // waits for the worker to run every task
+    delete scheduler;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskSchedulerSubmit)->Threads(1)->Threads(4);
+
+// Frames per second of a Frame Processor that takes 2ms per Frame, on 1-4 workers. It sleeps (like a plugin that waits for
+// an accelerator) so the workers overlap even on machines with few cores. In order, every Frame also waits for the ones before it.
+void BM_FrameWorkerPool(benchmark::State& state) {
+  auto workersCount = static_cast<size_t>(state.range(0));
+  auto isInOrder = state.range(1) != 0;
+  FrameSequencer sequencer;
+  {
+    FrameWorkerPool<uint64_t> workers(workersCount, FrameDispatchPolicy::LeastLoaded, [&](size_t, std::unique_ptr<uint64_t> sequence) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      if (isInOrder) {
+        sequencer.waitForTurn(*sequence);
+      }
+      sequencer.complete(*sequence);
+    });
+    for (auto _ : state) {
+      workers.dispatch(std::make_unique<uint64_t>(sequencer.next()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameWorkerPool)->ArgNames({ "workers", "inOrder" })->ArgsProduct({ { 1, 2, 4 }, { 0, 1 } })->UseRealTime();
+
+// runAsync() calls this once per Frame, from multiple Frame Processor threads with frameProcessorRuntimes.
+void BM_InFlightLimiter(benchmark::State& state) {
+  static InFlightLimiter limiter(1);
+  for (auto _ : state) {
+    if (limiter.tryAcquire()) {
+      limiter.release();
+    }
+  }
+}
+BENCHMARK(BM_InFlightLimiter)->Threads(1)->Threads(4);
+
+// a runParallel() of 3 plugins that take 2ms each: 6ms per Frame when they run one after another (workers = 0).
+void BM_WorkStealingPool(benchmark::State& state) {
+  auto workersCount = static_cast<size_t>(state.range(0));
+  auto plugin = []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+  std::unique_ptr<WorkStealingPool> pool;
+  if (workersCount > 0) {
+    pool = std::make_unique<WorkStealingPool>(workersCount);
+  }
+  for (auto _ : state) {
+    if (pool == nullptr) {
+      plugin();
+      plugin();
+      plugin();
+    } else {
+      pool->run({ plugin, plugin }, plugin);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorkStealingPool)->ArgName("workers")->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
+
+void BM_LatencyHistogramRecord(benchmark::State& state) {
+  LatencyHistogram histogram;
+  int64_t value = 1;
+  for (auto _ : state) {
+    histogram.record(std::chrono::nanoseconds(value));
+    // spread the samples over the buckets between 1µs and 1s
+    value = (value * 7919 + 104729) % 1000000000;
+  }
+}
+BENCHMARK(BM_LatencyHistogramRecord);
+
+// the per-Frame cost of throttling and adapting `frameProcessorFps`: a 30 FPS Camera, every processed Frame is recorded.
+void BM_FrameRateController(benchmark::State& state) {
+  FrameRateController controller;
+  int64_t timestamp = 0;
+  int64_t executionTime = 20000000;
+  for (auto _ : state) {
+    timestamp += 33333333;
+    if (controller.shouldProcess(timestamp)) {
+      benchmark::DoNotOptimize(controller.recordFrame(std::chrono::nanoseconds(executionTime), std::chrono::nanoseconds(executionTime)));
+      // vary the execution time between 20ms and 60ms
+      executionTime = 20000000 + (executionTime * 7919 + 104729) % 40000000;
+    }
+  }
+}
+BENCHMARK(BM_FrameRateController);
+
+void BM_FrameTracerRecord(benchmark::State& state) {
+  auto& tracer = FrameTracer::shared();
+  if (state.range(0) != 0) {
+    tracer.start();
+  } else {
+    tracer.stop();
+  }
+  for (auto _ : state) {
+    TraceScope trace("benchmark");
+  }
+  tracer.stop();
+}
+BENCHMARK(BM_FrameTracerRecord)->ArgName("enabled")->Arg(0)->Arg(1);
+
+} // namespace
+
+} // namespace benchmarks
+} // namespace vision
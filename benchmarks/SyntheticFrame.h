@@ -0,0 +1,55 @@
+#pragma once
+
+#include <FrameDescriptor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vision {
+namespace benchmarks {
+
+/**
+ * An Android YUV_420_888 Frame in the NV21 layout CameraX delivers (a Y plane and an interleaved VU plane
+ * that the U and V planes point into), filled with a deterministic gradient instead of a camera image.
+ */
+class SyntheticFrame {
+ public:
+  SyntheticFrame(int width, int height): width_(width), height_(height) {
+    size_t lumaSize = static_cast<size_t>(width) * height;
+    y_.resize(lumaSize);
+    vu_.resize(lumaSize / 2);
+    for (int row = 0; row < height; row++) {
+      for (int column = 0; column < width; column++) {
+        y_[static_cast<size_t>(row) * width + column] = static_cast<uint8_t>((row + column) & 0xFF);
+      }
+    }
+    for (size_t i = 0; i < vu_.size(); i++) {
+      vu_[i] = static_cast<uint8_t>(128 + (i % 64) - 32);
+    }
+  }
+
+  FrameDescriptor getDescriptor(int64_t timestamp = 0) {
+    FrameDescriptor descriptor;
+    descriptor.width = width_;
+    descriptor.height = height_;
+    descriptor.pixelFormat = PixelFormat::YUV_420_888;
+    descriptor.colorRange = ColorRange::Full;
+    descriptor.timestamp = timestamp;
+    descriptor.planesCount = 3;
+    descriptor.planes[0] = PlaneDescriptor { y_.data(), y_.size(), width_, 1 };
+    descriptor.planes[1] = PlaneDescriptor { vu_.data() + 1, vu_.size() - 1, width_, 2 };
+    descriptor.planes[2] = PlaneDescriptor { vu_.data(), vu_.size() - 1, width_, 2 };
+    descriptor.isValid = true;
+    return descriptor;
+  }
+
+ private:
+  int width_;
+  int height_;
+  std::vector<uint8_t> y_;
+  std::vector<uint8_t> vu_;
+};
+
+} // namespace benchmarks
+} // namespace vision
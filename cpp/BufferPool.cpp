@@ -0,0 +1,127 @@
+#include "BufferPool.h"
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace vision {
+
+PooledBuffer::~PooledBuffer() {
+  pool_->release(data_, size_);
+}
+
+std::shared_ptr<BufferPool> BufferPool::shared() {
+  static auto pool = std::make_shared<BufferPool>();
+  return pool;
+}
+
+BufferPool::BufferPool(const BufferPoolConfig& config): config_(config) { }
+
+BufferPool::~BufferPool() {
+  trim();
+}
+
+uint8_t* BufferPool::allocate(size_t size) {
+  return static_cast<uint8_t*>(::operator new(size, std::align_val_t(kAlignment)));
+}
+
+void BufferPool::free(uint8_t* data) {
+  ::operator delete(data, std::align_val_t(kAlignment));
+}
+
+std::unique_ptr<PooledBuffer> BufferPool::acquire(size_t size) {
+  uint8_t* data = nullptr;
+  {
+    std::unique_lock lock(mutex_);
+    auto entry = idleBuffers_.find(size);
+    if (entry != idleBuffers_.end() && !entry->second.empty()) {
+      data = entry->second.back();
+      entry->second.pop_back();
+      stats_.hits++;
+      stats_.bytesHeld -= size;
+      stats_.buffersHeld--;
+    } else {
+      stats_.misses++;
+    }
+    stats_.bytesInUse += size;
+  }
+
+  if (data == nullptr) {
+    // allocate outside of the lock, this is the slow path.
+    data = allocate(size);
+  }
+  return std::unique_ptr<PooledBuffer>(new PooledBuffer(shared_from_this(), data, size));
+}
+
+void BufferPool::release(uint8_t* data, size_t size) {
+  {
+    std::unique_lock lock(mutex_);
+    stats_.bytesInUse -= size;
+    auto& buffers = idleBuffers_[size];
+    if (buffers.size() < config_.maxBuffersPerSize && stats_.bytesHeld + size <= config_.maxBytesHeld) {
+      buffers.push_back(data);
+      stats_.bytesHeld += size;
+      stats_.buffersHeld++;
+      return;
+    }
+    stats_.evictions++;
+  }
+  free(data);
+}
+
+void BufferPool::configure(const BufferPoolConfig& config) {
+  {
+    std::unique_lock lock(mutex_);
+    config_ = config;
+  }
+  trimToConfig();
+}
+
+BufferPoolConfig BufferPool::getConfig() const {
+  std::unique_lock lock(mutex_);
+  return config_;
+}
+
+BufferPoolStats BufferPool::getStats() const {
+  std::unique_lock lock(mutex_);
+  return stats_;
+}
+
+void BufferPool::trim() {
+  std::vector<uint8_t*> buffers;
+  {
+    std::unique_lock lock(mutex_);
+    for (auto& entry : idleBuffers_) {
+      buffers.insert(buffers.end(), entry.second.begin(), entry.second.end());
+    }
+    idleBuffers_.clear();
+    stats_.bytesHeld = 0;
+    stats_.buffersHeld = 0;
+  }
+  for (auto buffer : buffers) {
+    free(buffer);
+  }
+}
+
+void BufferPool::trimToConfig() {
+  std::vector<uint8_t*> buffers;
+  {
+    std::unique_lock lock(mutex_);
+    for (auto& entry : idleBuffers_) {
+      auto& idle = entry.second;
+      while (!idle.empty() && (idle.size() > config_.maxBuffersPerSize || stats_.bytesHeld > config_.maxBytesHeld)) {
+        buffers.push_back(idle.back());
+        idle.pop_back();
+        stats_.bytesHeld -= entry.first;
+        stats_.buffersHeld--;
+        stats_.evictions++;
+      }
+    }
+  }
+  for (auto buffer : buffers) {
+    free(buffer);
+  }
+}
+
+} // namespace vision
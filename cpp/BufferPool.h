@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vision {
+
+class BufferPool;
+
+struct BufferPoolConfig {
+  // the maximum amount of bytes idle buffers may hold in total, buffers released beyond that are freed.
+  size_t maxBytesHeld = 64 * 1024 * 1024;
+  // the maximum amount of idle buffers kept per size.
+  size_t maxBuffersPerSize = 4;
+};
+
+struct BufferPoolStats {
+  // acquires that reused an idle buffer
+  uint64_t hits = 0;
+  // acquires that had to allocate a new buffer
+  uint64_t misses = 0;
+  // released buffers that were freed because the pool was full
+  uint64_t evictions = 0;
+  // bytes held by idle buffers in the pool
+  size_t bytesHeld = 0;
+  // bytes of buffers that are currently acquired
+  size_t bytesInUse = 0;
+  size_t buffersHeld = 0;
+};
+
+/**
+ * A buffer acquired from a BufferPool. The memory is returned to the pool once this is destroyed.
+ * The contents of a buffer are undefined after acquiring it, since it might have been used before.
+ */
+class PooledBuffer {
+ public:
+  ~PooledBuffer();
+  PooledBuffer(const PooledBuffer&) = delete;
+  PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+  uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  friend class BufferPool;
+  PooledBuffer(std::shared_ptr<BufferPool> pool, uint8_t* data, size_t size): pool_(std::move(pool)), data_(data), size_(size) { }
+
+  std::shared_ptr<BufferPool> pool_;
+  uint8_t* data_;
+  size_t size_;
+};
+
+/**
+ * A thread-safe pool of aligned buffers, keyed by their exact byte size.
+ *
+ * Frame outputs (RGB conversions, tensors, copies) have the same size for every Frame of a session,
+ * so after the first few Frames every acquire is served from the pool instead of the allocator.
+ *
+ * A BufferPool must be owned by a std::shared_ptr, since acquired buffers keep it alive.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool> {
+ public:
+  // cache-line aligned, which is also enough for any SIMD load/store.
+  static constexpr size_t kAlignment = 64;
+
+  /**
+   * Get the pool shared by all Frames.
+   */
+  static std::shared_ptr<BufferPool> shared();
+
+  explicit BufferPool(const BufferPoolConfig& config = BufferPoolConfig());
+  ~BufferPool();
+
+  /**
+   * Get a buffer of exactly `size` bytes, either an idle one from the pool or a newly allocated one.
+   */
+  std::unique_ptr<PooledBuffer> acquire(size_t size);
+
+  /**
+   * Updates the caps of this pool, and frees idle buffers that exceed them.
+   */
+  void configure(const BufferPoolConfig& config);
+  BufferPoolConfig getConfig() const;
+  BufferPoolStats getStats() const;
+  /**
+   * Frees all idle buffers.
+   */
+  void trim();
+
+ private:
+  friend class PooledBuffer;
+  void release(uint8_t* data, size_t size);
+  void trimToConfig();
+
+  static uint8_t* allocate(size_t size);
+  static void free(uint8_t* data);
+
+ private:
+  mutable std::mutex mutex_;
+  BufferPoolConfig config_;
+  BufferPoolStats stats_;
+  std::unordered_map<size_t, std::vector<uint8_t*>> idleBuffers_;
+};
+
+} // namespace vision
@@ -0,0 +1,63 @@
+#include "BufferPoolBindings.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+
+#include "BufferPool.h"
+
+namespace vision {
+
+using namespace facebook;
+
+void installBufferPoolBindings(jsi::Runtime& runtime) {
+  // getFrameBufferPoolStats(): BufferPoolStats
+  auto getStats = [](jsi::Runtime& runtime,
+                     const jsi::Value& thisValue,
+                     const jsi::Value* arguments,
+                     size_t count) -> jsi::Value {
+    auto stats = BufferPool::shared()->getStats();
+    auto result = jsi::Object(runtime);
+    result.setProperty(runtime, "hits", jsi::Value(static_cast<double>(stats.hits)));
+    result.setProperty(runtime, "misses", jsi::Value(static_cast<double>(stats.misses)));
+    result.setProperty(runtime, "evictions", jsi::Value(static_cast<double>(stats.evictions)));
+    result.setProperty(runtime, "bytesHeld", jsi::Value(static_cast<double>(stats.bytesHeld)));
+    result.setProperty(runtime, "bytesInUse", jsi::Value(static_cast<double>(stats.bytesInUse)));
+    result.setProperty(runtime, "buffersHeld", jsi::Value(static_cast<double>(stats.buffersHeld)));
+    return result;
+  };
+  runtime.global().setProperty(runtime, "getFrameBufferPoolStats", jsi::Function::createFromHostFunction(runtime,
+                                                                                                         jsi::PropNameID::forAscii(runtime, "getFrameBufferPoolStats"),
+                                                                                                         0,
+                                                                                                         getStats));
+
+  // configureFrameBufferPool(config: { maxBytesHeld?: number, maxBuffersPerSize?: number })
+  auto configure = [](jsi::Runtime& runtime,
+                      const jsi::Value& thisValue,
+                      const jsi::Value* arguments,
+                      size_t count) -> jsi::Value {
+    if (count < 1 || !arguments[0].isObject()) {
+      throw jsi::JSError(runtime, "configureFrameBufferPool: First argument ('config') must be an object!");
+    }
+    auto options = arguments[0].asObject(runtime);
+    auto pool = BufferPool::shared();
+    auto config = pool->getConfig();
+
+    auto maxBytesHeld = options.getProperty(runtime, "maxBytesHeld");
+    if (maxBytesHeld.isNumber()) {
+      config.maxBytesHeld = static_cast<size_t>(std::max(maxBytesHeld.asNumber(), 0.0));
+    }
+    auto maxBuffersPerSize = options.getProperty(runtime, "maxBuffersPerSize");
+    if (maxBuffersPerSize.isNumber()) {
+      config.maxBuffersPerSize = static_cast<size_t>(std::max(maxBuffersPerSize.asNumber(), 0.0));
+    }
+    pool->configure(config);
+    return jsi::Value::undefined();
+  };
+  runtime.global().setProperty(runtime, "configureFrameBufferPool", jsi::Function::createFromHostFunction(runtime,
+                                                                                                          jsi::PropNameID::forAscii(runtime, "configureFrameBufferPool"),
+                                                                                                          1, // config
+                                                                                                          configure));
+}
+
+} // namespace vision
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <utility>
+
+#include "BufferPool.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * A jsi::MutableBuffer backed by a PooledBuffer. Once the JS ArrayBuffer is garbage collected,
+ * the memory goes back to the pool instead of being freed.
+ */
+class PooledMutableBuffer : public jsi::MutableBuffer {
+ public:
+  explicit PooledMutableBuffer(std::unique_ptr<PooledBuffer> buffer): buffer_(std::move(buffer)) { }
+
+  size_t size() const override { return buffer_->size(); }
+  uint8_t* data() override { return buffer_->data(); }
+
+  /**
+   * Acquires a buffer of `size` bytes from the shared BufferPool.
+   */
+  static std::shared_ptr<PooledMutableBuffer> acquire(size_t size) {
+    return std::make_shared<PooledMutableBuffer>(BufferPool::shared()->acquire(size));
+  }
+
+ private:
+  std::unique_ptr<PooledBuffer> buffer_;
+};
+
+/**
+ * Installs `getFrameBufferPoolStats()` and `configureFrameBufferPool(config)` into the given Runtime.
+ */
+void installBufferPoolBindings(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+} // namespace vision
@@ -0,0 +1,32 @@
+#include "CroppedFrameHostObject.h"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace vision {
+
+CroppedFrameHostObject::CroppedFrameHostObject(std::shared_ptr<FrameHostObjectBase> source, const FrameRect& rect):
+  FrameHostObjectBase(cropFrameDescriptor(source->descriptor, rect), false), source_(std::move(source)), rect_(rect) { }
+
+void CroppedFrameHostObject::incrementRefCount() {
+  if (!descriptor.isValid) {
+    throw std::runtime_error("Trying to retain a cropped Frame that has already been closed!");
+  }
+  source_->incrementRefCount();
+}
+
+void CroppedFrameHostObject::decrementRefCount() {
+  source_->decrementRefCount();
+}
+
+int CroppedFrameHostObject::getRefCount() const {
+  return source_->getRefCount();
+}
+
+void CroppedFrameHostObject::close() {
+  // the memory belongs to the source Frame, which is closed on its own.
+  invalidate();
+}
+
+} // namespace vision
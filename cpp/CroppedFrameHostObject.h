@@ -0,0 +1,43 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+
+#include "FrameCrop.h"
+#include "FrameDescriptor.h"
+#include "FrameHostObjectBase.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * A region of a Frame, returned by `frame.crop(rect)`. It shares the source Frame's plane memory, only the plane
+ * pointers and dimensions of its descriptor differ - so conversions and C++ plugins process just the region without copying it.
+ *
+ * A crop does not own a Camera buffer: retaining or releasing it retains or releases the source Frame,
+ * and closing it only invalidates the crop itself. Crops of crops refer to the original Frame directly.
+ */
+class JSI_EXPORT CroppedFrameHostObject : public FrameHostObjectBase {
+ public:
+  /**
+   * `rect` is in the coordinates of `source`, and must be aligned with alignCropRect().
+   */
+  CroppedFrameHostObject(std::shared_ptr<FrameHostObjectBase> source, const FrameRect& rect);
+
+ public:
+  void incrementRefCount() override;
+  void decrementRefCount() override;
+  int getRefCount() const override;
+  void close() override;
+
+  FrameHostObjectBase& getSourceFrame() override { return *source_; }
+  FrameRect getSourceRect() const override { return rect_; }
+
+ private:
+  std::shared_ptr<FrameHostObjectBase> source_;
+  FrameRect rect_;
+};
+
+} // namespace vision
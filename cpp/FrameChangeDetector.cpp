@@ -0,0 +1,45 @@
+#include "FrameChangeDetector.h"
+
+#include "kernels/LumaChange.h"
+#include "kernels/YUVToRGB.h"
+
+namespace vision {
+
+void FrameChangeDetector::setThreshold(double threshold) {
+  threshold_.store(threshold > 0 ? threshold : 0, std::memory_order_relaxed);
+  // a new threshold starts with a fresh reference, so the next Frame is always processed.
+  resetReference_.store(true, std::memory_order_release);
+}
+
+bool FrameChangeDetector::hasChanged(const FrameDescriptor& frame) {
+  if (resetReference_.load(std::memory_order_acquire) && resetReference_.exchange(false, std::memory_order_acq_rel)) {
+    hasReference_ = false;
+  }
+
+  kernels::YUVImage image;
+  if (!kernels::describeYUVImage(frame, image) || image.width < kernels::kLumaGridCellWidth || image.height < kGridHeight) {
+    lastDifference_.store(-1, std::memory_order_relaxed);
+    hasReference_ = false;
+    return true;
+  }
+
+  kernels::sampleLumaGrid(image.y, image.yRowStride, image.width, image.height, kGridWidth, kGridHeight, current_.data());
+  if (!hasReference_ || image.width != referenceWidth_ || image.height != referenceHeight_) {
+    lastDifference_.store(-1, std::memory_order_relaxed);
+  } else {
+    auto sum = kernels::sumOfAbsoluteDifferences(current_.data(), reference_.data(), current_.size());
+    auto difference = static_cast<double>(sum) / current_.size();
+    lastDifference_.store(difference, std::memory_order_relaxed);
+    if (difference < threshold_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+  }
+
+  reference_.swap(current_);
+  hasReference_ = true;
+  referenceWidth_ = image.width;
+  referenceHeight_ = image.height;
+  return true;
+}
+
+} // namespace vision
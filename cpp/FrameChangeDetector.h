@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "FrameDescriptor.h"
+
+namespace vision {
+
+/**
+ * Detects whether a Frame differs enough from the last processed Frame to be worth passing to the Frame Processor
+ * (`frameProcessorChangeThreshold`), so static scenes don't run the Frame Processor over and over on the same image.
+ *
+ * The metric is the mean absolute difference of a subsampled luma grid (kGridWidth x kGridHeight cells of 16 averaged
+ * pixels each) against the grid of the last Frame that was considered changed, in luma levels (0...255).
+ * Comparing against the last processed Frame instead of the previous Frame makes slow changes (e.g. a sunset) add up.
+ *
+ * hasChanged() must only be called from a single thread (the Camera thread). setThreshold() can be called from any thread.
+ */
+class FrameChangeDetector {
+ public:
+  static constexpr int kGridWidth = 64;
+  static constexpr int kGridHeight = 48;
+
+  /**
+   * Sets the mean absolute luma difference a Frame needs to be considered changed. 0 disables the detector.
+   */
+  void setThreshold(double threshold);
+  bool isEnabled() const { return threshold_.load(std::memory_order_relaxed) > 0; }
+
+  /**
+   * Returns whether the Frame changed enough since the last Frame this returned true for, and if so makes it the new reference.
+   * The first Frame, Frames with a different size and Frames that are not YUV always count as changed.
+   */
+  bool hasChanged(const FrameDescriptor& frame);
+
+  /**
+   * The difference measured for the last Frame passed to hasChanged(), or -1 if it could not be measured.
+   */
+  double getLastDifference() const { return lastDifference_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<double> threshold_ { 0 };
+  std::atomic<bool> resetReference_ { false };
+  std::atomic<double> lastDifference_ { -1 };
+
+  // Camera thread only
+  std::array<uint8_t, kGridWidth * kGridHeight> reference_;
+  std::array<uint8_t, kGridWidth * kGridHeight> current_;
+  bool hasReference_ = false;
+  int referenceWidth_ = 0;
+  int referenceHeight_ = 0;
+};
+
+} // namespace vision
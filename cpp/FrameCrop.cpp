@@ -0,0 +1,67 @@
+#include "FrameCrop.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace vision {
+
+namespace {
+
+bool isYUV420(PixelFormat pixelFormat) {
+  return pixelFormat == PixelFormat::YUV_420_888 || pixelFormat == PixelFormat::YUV_420_BIPLANAR;
+}
+
+/**
+ * Moves `plane` to the given column and row, and shrinks it to the bytes the crop's `columns` x `rows` samples span.
+ */
+PlaneDescriptor cropPlane(const PlaneDescriptor& plane, int column, int row, int columns, int rows) {
+  auto offset = static_cast<size_t>(row) * plane.rowStride + static_cast<size_t>(column) * plane.pixelStride;
+  PlaneDescriptor result = plane;
+  if (offset >= plane.size) {
+    result.data = plane.data + plane.size;
+    result.size = 0;
+    return result;
+  }
+  // the last row usually ends before the row stride does, e.g. Android's interleaved chroma planes lack the last byte.
+  auto span = static_cast<size_t>(rows - 1) * plane.rowStride + static_cast<size_t>(columns - 1) * plane.pixelStride + 1;
+  result.data = plane.data + offset;
+  result.size = std::min(span, plane.size - offset);
+  return result;
+}
+
+} // namespace
+
+bool isRectWithinFrame(const FrameDescriptor& frame, const FrameRect& rect) {
+  return rect.x >= 0 && rect.y >= 0 && rect.width > 0 && rect.height > 0 && rect.x <= frame.width - rect.width &&
+         rect.y <= frame.height - rect.height;
+}
+
+FrameRect alignCropRect(const FrameDescriptor& frame, const FrameRect& rect) {
+  if (!isYUV420(frame.pixelFormat)) {
+    return rect;
+  }
+  // the size may stay odd, the last chroma sample then covers a single column or row - just like in odd sized Frames.
+  FrameRect aligned = rect;
+  aligned.x = rect.x & ~1;
+  aligned.y = rect.y & ~1;
+  aligned.width = rect.width + (rect.x - aligned.x);
+  aligned.height = rect.height + (rect.y - aligned.y);
+  return aligned;
+}
+
+FrameDescriptor cropFrameDescriptor(const FrameDescriptor& frame, const FrameRect& rect) {
+  FrameDescriptor result = frame;
+  result.width = rect.width;
+  result.height = rect.height;
+  for (size_t i = 0; i < frame.planesCount; i++) {
+    if (isYUV420(frame.pixelFormat) && i > 0) {
+      // the chroma planes are subsampled by 2 in both directions
+      result.planes[i] = cropPlane(frame.planes[i], rect.x / 2, rect.y / 2, (rect.width + 1) / 2, (rect.height + 1) / 2);
+    } else {
+      result.planes[i] = cropPlane(frame.planes[i], rect.x, rect.y, rect.width, rect.height);
+    }
+  }
+  return result;
+}
+
+} // namespace vision
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "FrameDescriptor.h"
+
+namespace vision {
+
+/**
+ * A rectangle in the pixel coordinates of a Frame.
+ */
+struct FrameRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+/**
+ * Returns whether `rect` is non-empty and lies within the Frame.
+ */
+bool isRectWithinFrame(const FrameDescriptor& frame, const FrameRect& rect);
+
+/**
+ * Aligns `rect` to the Frame's chroma subsampling, so every chroma sample of the crop belongs to the same pixels as in the Frame.
+ *
+ * For 4:2:0 YUV Frames the origin is moved to even coordinates, and the size grows by the same amount
+ * so the aligned rect still covers `rect`. Packed RGB Frames don't need any alignment.
+ */
+FrameRect alignCropRect(const FrameDescriptor& frame, const FrameRect& rect);
+
+/**
+ * Describes the region `rect` of `frame` without copying any pixels: the planes point into the Frame's memory
+ * at the region's origin and keep their strides, only the dimensions change.
+ *
+ * `rect` must lie within the Frame and be aligned with alignCropRect().
+ */
+FrameDescriptor cropFrameDescriptor(const FrameDescriptor& frame, const FrameRect& rect);
+
+} // namespace vision
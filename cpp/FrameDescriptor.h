@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace vision {
+
+enum class PixelFormat {
+  Unknown,
+  // Android YUV_420_888: 3 planes (Y, U, V) with individual row- and pixel-strides
+  YUV_420_888,
+  // iOS 420YpCbCr8BiPlanar: 2 planes (Y, interleaved CbCr)
+  YUV_420_BIPLANAR,
+  RGBA_8888,
+  BGRA_8888,
+};
+
+enum class ColorRange {
+  // Y, Cb and Cr use the full 0...255 range (JFIF), e.g. Android YUV_420_888
+  Full,
+  // Y uses 16...235 and Cb/Cr use 16...240 (BT.601 video range), e.g. iOS 420YpCbCr8BiPlanarVideoRange
+  Video,
+};
+
+/**
+ * Describes the memory layout of a single plane of a Frame.
+ */
+struct PlaneDescriptor {
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  int rowStride = 0;
+  int pixelStride = 0;
+};
+
+/**
+ * A bool that is written and read from multiple threads, e.g. a Frame that is released on a background thread
+ * while a worklet checks it. Unlike std::atomic<bool> it can be copied, together with the FrameDescriptor it belongs to.
+ */
+class AtomicFlag {
+ public:
+  AtomicFlag(bool value = false): value_(value) { } // NOLINT(runtime/explicit)
+  AtomicFlag(const AtomicFlag& other): value_(other.load()) { }
+  AtomicFlag& operator=(const AtomicFlag& other) {
+    store(other.load());
+    return *this;
+  }
+  AtomicFlag& operator=(bool value) {
+    store(value);
+    return *this;
+  }
+
+  bool load() const { return value_.load(std::memory_order_acquire); }
+  void store(bool value) { value_.store(value, std::memory_order_release); }
+  operator bool() const { return load(); } // NOLINT(runtime/explicit)
+
+ private:
+  std::atomic<bool> value_;
+};
+
+/**
+ * A plain description of a Frame and its pixel memory.
+ *
+ * The descriptor is filled once when the Frame enters the Frame Processor pipeline, so reading
+ * any of its properties afterwards does not require a call into the platform (JNI/Objective-C).
+ * The plane pointers are owned by the platform Frame and are only valid as long as `isValid` is true.
+ */
+struct FrameDescriptor {
+  static constexpr size_t kMaxPlanes = 3;
+
+  int width = 0;
+  int height = 0;
+  PixelFormat pixelFormat = PixelFormat::Unknown;
+  ColorRange colorRange = ColorRange::Full;
+  // presentation timestamp, in nanoseconds
+  int64_t timestamp = 0;
+  size_t planesCount = 0;
+  std::array<PlaneDescriptor, kMaxPlanes> planes;
+  // set to false once the Frame is released, which can happen on any thread.
+  AtomicFlag isValid { false };
+
+  int bytesPerRow() const {
+    return planesCount > 0 ? planes[0].rowStride : 0;
+  }
+};
+
+} // namespace vision
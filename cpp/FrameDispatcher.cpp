@@ -0,0 +1,85 @@
+#include "FrameDispatcher.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace vision {
+
+FrameDispatcher::FrameDispatcher(size_t workersCount, FrameDispatchPolicy policy):
+  policy_(policy), workers_(std::max<size_t>(workersCount, 1)) { }
+
+std::optional<size_t> FrameDispatcher::findWorker() const {
+  switch (policy_) {
+    case FrameDispatchPolicy::RoundRobin:
+      if (workers_[next_].isBusy) {
+        return std::nullopt;
+      }
+      return next_;
+    case FrameDispatchPolicy::LeastLoaded:
+    default: {
+      // starting at `next_` spreads Frames evenly while the averages are equal, e.g. before any worker finished a Frame.
+      std::optional<size_t> fastest;
+      for (size_t i = 0; i < workers_.size(); i++) {
+        auto index = (next_ + i) % workers_.size();
+        if (workers_[index].isBusy) {
+          continue;
+        }
+        if (!fastest.has_value() || workers_[index].averageExecutionTime < workers_[*fastest].averageExecutionTime) {
+          fastest = index;
+        }
+      }
+      return fastest;
+    }
+  }
+}
+
+std::optional<size_t> FrameDispatcher::acquire() {
+  std::unique_lock lock(mutex_);
+  std::optional<size_t> worker;
+  condition_.wait(lock, [&]() {
+    worker = findWorker();
+    return isClosed_ || worker.has_value();
+  });
+  if (isClosed_) {
+    return std::nullopt;
+  }
+
+  workers_[*worker].isBusy = true;
+  busyCount_++;
+  next_ = (*worker + 1) % workers_.size();
+  return worker;
+}
+
+void FrameDispatcher::release(size_t worker, std::chrono::nanoseconds executionTime) {
+  {
+    std::unique_lock lock(mutex_);
+    auto& state = workers_[worker];
+    auto sample = static_cast<double>(executionTime.count());
+    state.averageExecutionTime = state.averageExecutionTime == 0 ? sample
+                                                                 : state.averageExecutionTime + kSmoothing * (sample - state.averageExecutionTime);
+    state.isBusy = false;
+    busyCount_--;
+  }
+  // acquire() and waitUntilIdle() wait on the same condition
+  condition_.notify_all();
+}
+
+void FrameDispatcher::waitUntilIdle() {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [&]() { return busyCount_ == 0; });
+}
+
+void FrameDispatcher::close() {
+  {
+    std::unique_lock lock(mutex_);
+    isClosed_ = true;
+  }
+  condition_.notify_all();
+}
+
+size_t FrameDispatcher::getBusyCount() const {
+  std::unique_lock lock(mutex_);
+  return busyCount_;
+}
+
+} // namespace vision
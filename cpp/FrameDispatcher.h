@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace vision {
+
+/**
+ * How Frames are spread across the workers of a Frame Processor that runs on more than one worklet runtime.
+ */
+enum class FrameDispatchPolicy {
+  // hand Frames to the workers in turn
+  RoundRobin,
+  // hand each Frame to the idle worker that has been the fastest recently
+  LeastLoaded,
+};
+
+/**
+ * Decides which worker processes the next Frame.
+ *
+ * A worker processes one Frame at a time. acquire() waits until a worker is idle (with RoundRobin, until the worker
+ * whose turn it is is idle), so Frames keep waiting in the FrameQueue - where its drop policy applies - instead of
+ * piling up behind a busy worker.
+ *
+ * acquire() must only be called from a single thread (the one popping the FrameQueue), release() from the workers.
+ * Both take a mutex, which is fine at Camera rates.
+ */
+class FrameDispatcher {
+ public:
+  // the weight of a new sample in a worker's average execution time
+  static constexpr double kSmoothing = 0.2;
+
+  FrameDispatcher(size_t workersCount, FrameDispatchPolicy policy);
+
+  /**
+   * Waits until a worker can take a Frame, marks it busy and returns it. Returns nothing once the dispatcher has been closed.
+   */
+  std::optional<size_t> acquire();
+  /**
+   * Marks `worker` idle again, after it took `executionTime` for its Frame.
+   */
+  void release(size_t worker, std::chrono::nanoseconds executionTime);
+  /**
+   * Waits until all workers are idle.
+   */
+  void waitUntilIdle();
+  /**
+   * Wakes up acquire() and makes it return nothing from now on.
+   */
+  void close();
+
+  size_t getWorkersCount() const { return workers_.size(); }
+  FrameDispatchPolicy getPolicy() const { return policy_; }
+  size_t getBusyCount() const;
+
+ private:
+  std::optional<size_t> findWorker() const;
+
+ private:
+  struct Worker {
+    bool isBusy = false;
+    // exponentially weighted moving average, in nanoseconds
+    double averageExecutionTime = 0;
+  };
+
+  const FrameDispatchPolicy policy_;
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<Worker> workers_;
+  // the worker whose turn it is (RoundRobin), or where the search for an idle worker starts (LeastLoaded)
+  size_t next_ = 0;
+  size_t busyCount_ = 0;
+  bool isClosed_ = false;
+};
+
+} // namespace vision
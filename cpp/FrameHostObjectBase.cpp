@@ -0,0 +1,598 @@
+#include "FrameHostObjectBase.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BufferPoolBindings.h"
+#include "CroppedFrameHostObject.h"
+#include "FrameTracer.h"
+#include "TypedArrays.h"
+#include "kernels/FrameToTensor.h"
+#include "kernels/LumaStatistics.h"
+#include "kernels/YUVToRGB.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+int getIntOption(jsi::Runtime& runtime, const jsi::Object& options, const char* name, const char* method) { // NOLINT(runtime/references)
+  auto value = options.getProperty(runtime, name);
+  if (!value.isNumber()) {
+    throw jsi::JSError(runtime, std::string(method) + ": `" + name + "` must be a number!");
+  }
+  return static_cast<int>(value.asNumber());
+}
+
+/**
+ * Parses a per-channel option (`mean` or `std`), which is either a single number for all channels or an array of 3 numbers.
+ */
+void parseChannelOption(jsi::Runtime& runtime, const jsi::Object& options, const char* name, // NOLINT(runtime/references)
+                        std::array<float, kernels::kTensorChannels>& result) { // NOLINT(runtime/references)
+  auto value = options.getProperty(runtime, name);
+  if (value.isUndefined()) {
+    return;
+  }
+  if (value.isNumber()) {
+    result.fill(static_cast<float>(value.asNumber()));
+    return;
+  }
+  if (value.isObject() && value.asObject(runtime).isArray(runtime)) {
+    auto array = value.asObject(runtime).asArray(runtime);
+    if (array.size(runtime) == kernels::kTensorChannels) {
+      for (size_t i = 0; i < kernels::kTensorChannels; i++) {
+        result[i] = static_cast<float>(array.getValueAtIndex(runtime, i).asNumber());
+      }
+      return;
+    }
+  }
+  throw jsi::JSError(runtime, std::string("Frame.toTensor: `") + name + "` must be a number or an array of 3 numbers!");
+}
+
+} // namespace
+
+/**
+ * A jsi::MutableBuffer that points directly into a Frame's memory (zero-copy).
+ *
+ * JS engines read a MutableBuffer's pointer once and can't detach an ArrayBuffer later, so the buffer holds a reference to
+ * the Frame: the Camera gets the memory back only once the JS ArrayBuffer has been garbage collected.
+ */
+class FrameHostObjectBase::MemoryBuffer : public jsi::MutableBuffer {
+ public:
+  MemoryBuffer(std::shared_ptr<FrameHostObjectBase> frame, uint8_t* data, size_t size): frame_(std::move(frame)), data_(data), size_(size) {
+    frame_->incrementRefCount();
+    frame_->getSourceFrame().memoryBuffers_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  ~MemoryBuffer() override {
+    frame_->getSourceFrame().memoryBuffers_.fetch_sub(1, std::memory_order_acq_rel);
+    try {
+      frame_->decrementRefCount();
+    } catch (const std::exception&) {
+      // the garbage collector can't handle errors, and the reference can't have been released by anyone else.
+    }
+  }
+
+  size_t size() const override { return size_; }
+  uint8_t* data() override { return data_; }
+
+ private:
+  std::shared_ptr<FrameHostObjectBase> frame_;
+  uint8_t* data_;
+  size_t size_;
+};
+
+FrameHostObjectBase::FrameHostObjectBase(const FrameDescriptor& descriptor): FrameHostObjectBase(descriptor, true) { }
+
+FrameHostObjectBase::FrameHostObjectBase(const FrameDescriptor& descriptor, bool isTracked): descriptor(descriptor) {
+  if (isTracked) {
+    retentionToken_ = FrameRetentionMonitor::shared().track(descriptor.timestamp);
+  }
+}
+
+FrameHostObjectBase::~FrameHostObjectBase() {
+  if (!isReleased_.load(std::memory_order_acquire) && retentionToken_ != 0) {
+    // the platform destructor closed the Frame because it was garbage collected with references still held.
+    FrameRetentionMonitor::shared().untrack(retentionToken_);
+  }
+}
+
+void FrameHostObjectBase::incrementRefCount() {
+  int refCount = refCount_.load(std::memory_order_relaxed);
+  do {
+    if (refCount <= 0) {
+      throw std::runtime_error("Trying to retain a Frame that has already been released!");
+    }
+  } while (!refCount_.compare_exchange_weak(refCount, refCount + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+}
+
+void FrameHostObjectBase::decrementRefCount() {
+  int refCount = refCount_.load(std::memory_order_relaxed);
+  do {
+    if (refCount <= 0) {
+      throw std::runtime_error("Trying to release a Frame that has already been released! "
+                               "Did you call decrementRefCount() more often than incrementRefCount()?");
+    }
+  } while (!refCount_.compare_exchange_weak(refCount, refCount - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+  if (refCount == 1) {
+    // that was the last reference
+    release();
+  }
+}
+
+bool FrameHostObjectBase::acquireRetentionSlot() {
+  auto& source = getSourceFrame();
+  if (source.retentionBudget == nullptr || source.holdsRetentionSlot_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  if (!source.retentionBudget->tryAcquire()) {
+    return false;
+  }
+  if (source.holdsRetentionSlot_.exchange(true, std::memory_order_acq_rel)) {
+    // another thread took a slot for the same Frame in the meantime
+    source.retentionBudget->release();
+  } else if (source.isReleased_.load(std::memory_order_acquire) && source.holdsRetentionSlot_.exchange(false, std::memory_order_acq_rel)) {
+    // the Frame has been released in the meantime, so release() did not see the slot.
+    source.retentionBudget->release();
+  }
+  return true;
+}
+
+void FrameHostObjectBase::release() {
+  if (isReleased_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  if (holdsRetentionSlot_.exchange(false, std::memory_order_acq_rel)) {
+    retentionBudget->release();
+  }
+  {
+    // crops point into this Frame's memory
+    std::unique_lock lock(cropsMutex_);
+    for (const auto& weakCrop : crops_) {
+      auto crop = weakCrop.lock();
+      if (crop != nullptr) {
+        crop->release();
+      }
+    }
+    crops_.clear();
+  }
+  {
+    TraceScope trace("close", descriptor.timestamp);
+    close();
+  }
+  if (retentionToken_ != 0) {
+    FrameRetentionMonitor::shared().untrack(retentionToken_);
+  }
+}
+
+std::vector<jsi::PropNameID> FrameHostObjectBase::getPropertyNames(jsi::Runtime& runtime) {
+  return FramePropertyCache::forRuntime(runtime)->getPropertyNames(runtime);
+}
+
+jsi::Value FrameHostObjectBase::get(jsi::Runtime& runtime, const jsi::PropNameID& name) {
+  auto cache = FramePropertyCache::forRuntime(runtime);
+  auto property = cache->resolve(runtime, name);
+
+  switch (property) {
+    case FrameProperty::Width:
+      assertIsFrameStrong(runtime, "width");
+      return jsi::Value(descriptor.width);
+    case FrameProperty::Height:
+      assertIsFrameStrong(runtime, "height");
+      return jsi::Value(descriptor.height);
+    case FrameProperty::IsValid:
+      return jsi::Value(descriptor.isValid.load());
+    case FrameProperty::BytesPerRow:
+      assertIsFrameStrong(runtime, "bytesPerRow");
+      return jsi::Value(descriptor.bytesPerRow());
+    case FrameProperty::PlanesCount:
+      assertIsFrameStrong(runtime, "planesCount");
+      return jsi::Value(static_cast<int>(descriptor.planesCount));
+    case FrameProperty::Count:
+      return jsi::Value::undefined();
+    default:
+      // all other properties are methods
+      return cache->getFunction(runtime, property);
+  }
+}
+
+jsi::Value FrameHostObjectBase::invoke(jsi::Runtime& runtime, FrameProperty property, const jsi::Value* arguments, size_t count) {
+  switch (property) {
+    case FrameProperty::ToString: {
+      if (!descriptor.isValid) {
+        return jsi::String::createFromUtf8(runtime, "[closed frame]");
+      }
+      auto str = std::to_string(descriptor.width) + " x " + std::to_string(descriptor.height) + " Frame";
+      return jsi::String::createFromUtf8(runtime, str);
+    }
+    case FrameProperty::Close: {
+      if (!descriptor.isValid) {
+        throw jsi::JSError(runtime, "Trying to close an already closed frame! Did you call frame.close() twice?");
+      }
+      if (&getSourceFrame() == this && memoryBuffers_.load(std::memory_order_acquire) > 0) {
+        // the Camera would reuse memory that these ArrayBuffers still point into.
+        throw jsi::JSError(runtime, "Trying to close a frame while ArrayBuffers from getPlane() or toArrayBuffer() still point into it! "
+                                    "Use decrementRefCount() instead, the frame is closed once they have been garbage collected.");
+      }
+      release();
+      return jsi::Value::undefined();
+    }
+    case FrameProperty::IncrementRefCount: {
+      if (!descriptor.isValid) {
+        throw jsi::JSError(runtime, "Trying to retain an already closed frame!");
+      }
+      if (!acquireRetentionSlot()) {
+        auto maxRetainedFrames = getSourceFrame().retentionBudget->getMaxRetainedFrames();
+        throw jsi::JSError(runtime, "Trying to retain more than " + std::to_string(maxRetainedFrames) + " Frames at once! "
+                                    "Release a retained Frame with decrementRefCount() first, or raise `frameProcessorMaxRetainedFrames`.");
+      }
+      incrementRefCount();
+      return jsi::Value::undefined();
+    }
+    case FrameProperty::DecrementRefCount: {
+      if (getRefCount() <= 0) {
+        throw jsi::JSError(runtime, "Trying to release a frame that has already been released! "
+                                    "Did you call decrementRefCount() more often than incrementRefCount()?");
+      }
+      if (getRefCount() <= getSourceFrame().memoryBuffers_.load(std::memory_order_acquire)) {
+        // the remaining references belong to ArrayBuffers from getPlane() or toArrayBuffer().
+        throw jsi::JSError(runtime, "Trying to release a frame that is only retained by its ArrayBuffers! "
+                                    "Did you call decrementRefCount() more often than incrementRefCount()?");
+      }
+      decrementRefCount();
+      return jsi::Value::undefined();
+    }
+    case FrameProperty::GetPlane:
+      return getPlane(runtime, arguments, count);
+    case FrameProperty::ToArrayBuffer:
+      return toArrayBuffer(runtime);
+    case FrameProperty::ToRGB:
+      return toRGB(runtime, arguments, count);
+    case FrameProperty::ToTensor:
+      return toTensor(runtime, arguments, count);
+    case FrameProperty::Crop:
+      return crop(runtime, arguments, count);
+    case FrameProperty::GetLumaStatistics:
+      return getLumaStatistics(runtime, arguments, count);
+    default:
+      throw jsi::JSError(runtime, "Tried to call a Frame property that is not a function!");
+  }
+}
+
+jsi::Value FrameHostObjectBase::getPlane(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  assertIsFrameStrong(runtime, "getPlane");
+  if (count < 1 || !arguments[0].isNumber()) {
+    throw jsi::JSError(runtime, "Frame.getPlane: First argument ('planeIndex') must be a number!");
+  }
+  auto index = static_cast<int>(arguments[0].asNumber());
+  if (index < 0 || index >= static_cast<int>(descriptor.planesCount)) {
+    auto message = "Frame.getPlane: Plane index " + std::to_string(index) + " is out of bounds, the Frame only has " +
+                   std::to_string(descriptor.planesCount) + " planes!";
+    throw jsi::JSError(runtime, message.c_str());
+  }
+  const auto& plane = descriptor.planes[index];
+
+  std::shared_ptr<jsi::MutableBuffer> buffer;
+  if (acquireRetentionSlot()) {
+    buffer = std::make_shared<MemoryBuffer>(shared_from_this(), plane.data, plane.size);
+  } else {
+    // the Frame can't be retained by the ArrayBuffer, so it gets a copy.
+    auto copy = PooledMutableBuffer::acquire(plane.size);
+    std::memcpy(copy->data(), plane.data, plane.size);
+    buffer = copy;
+  }
+  auto result = jsi::Object(runtime);
+  result.setProperty(runtime, "buffer", jsi::ArrayBuffer(runtime, buffer));
+  result.setProperty(runtime, "rowStride", jsi::Value(plane.rowStride));
+  result.setProperty(runtime, "pixelStride", jsi::Value(plane.pixelStride));
+  return result;
+}
+
+jsi::Value FrameHostObjectBase::toArrayBuffer(jsi::Runtime& runtime) {
+  assertIsFrameStrong(runtime, "toArrayBuffer");
+  size_t totalSize = 0;
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    totalSize += descriptor.planes[i].size;
+  }
+
+  // most formats store their planes back-to-back already, then the buffer can point into the Frame's memory directly.
+  bool isContiguous = descriptor.planesCount > 0;
+  for (size_t i = 1; i < descriptor.planesCount; i++) {
+    isContiguous = isContiguous && descriptor.planes[i - 1].data + descriptor.planes[i - 1].size == descriptor.planes[i].data;
+  }
+  if (isContiguous && acquireRetentionSlot()) {
+    return jsi::ArrayBuffer(runtime, std::make_shared<MemoryBuffer>(shared_from_this(), descriptor.planes[0].data, totalSize));
+  }
+
+  // otherwise (e.g. Android's interleaved U/V planes, or the Frame can't be retained) they are copied back-to-back into one contiguous buffer
+  auto result = PooledMutableBuffer::acquire(totalSize);
+  size_t offset = 0;
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    const auto& plane = descriptor.planes[i];
+    std::memcpy(result->data() + offset, plane.data, plane.size);
+    offset += plane.size;
+  }
+  return jsi::ArrayBuffer(runtime, result);
+}
+
+jsi::Value FrameHostObjectBase::toRGB(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  assertIsFrameStrong(runtime, "toRGB");
+
+  auto format = kernels::RGBFormat::RGB;
+  if (count > 0 && arguments[0].isObject()) {
+    auto formatValue = arguments[0].asObject(runtime).getProperty(runtime, "format");
+    if (formatValue.isString()) {
+      auto formatName = formatValue.asString(runtime).utf8(runtime);
+      if (formatName == "rgb") {
+        format = kernels::RGBFormat::RGB;
+      } else if (formatName == "rgba") {
+        format = kernels::RGBFormat::RGBA;
+      } else if (formatName == "bgr") {
+        format = kernels::RGBFormat::BGR;
+      } else if (formatName == "bgra") {
+        format = kernels::RGBFormat::BGRA;
+      } else {
+        throw jsi::JSError(runtime, "Frame.toRGB: Unknown format \"" + formatName + "\"! Expected one of rgb, rgba, bgr or bgra.");
+      }
+    } else if (!formatValue.isUndefined()) {
+      throw jsi::JSError(runtime, "Frame.toRGB: `format` must be a string!");
+    }
+  }
+
+  size_t dstRowStride = static_cast<size_t>(descriptor.width) * kernels::bytesPerPixel(format);
+  auto result = PooledMutableBuffer::acquire(dstRowStride * descriptor.height);
+
+  kernels::YUVImage image;
+  if (kernels::describeYUVImage(descriptor, image)) {
+    kernels::convertYUVToRGB(image, format, result->data(), dstRowStride);
+  } else if ((descriptor.pixelFormat == PixelFormat::RGBA_8888 || descriptor.pixelFormat == PixelFormat::BGRA_8888) &&
+             descriptor.planesCount > 0) {
+    const auto& plane = descriptor.planes[0];
+    kernels::convertPackedToRGB(plane.data, plane.rowStride, descriptor.pixelFormat == PixelFormat::BGRA_8888, descriptor.width,
+                                descriptor.height, format, result->data(), dstRowStride);
+  } else {
+    throw jsi::JSError(runtime, "Frame.toRGB: The Frame's pixel format is not supported!");
+  }
+  return jsi::ArrayBuffer(runtime, result);
+}
+
+jsi::Value FrameHostObjectBase::toTensor(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  assertIsFrameStrong(runtime, "toTensor");
+  if (count < 1 || !arguments[0].isObject()) {
+    throw jsi::JSError(runtime, "Frame.toTensor: First argument ('options') must be an object!");
+  }
+  auto options = arguments[0].asObject(runtime);
+
+  kernels::TensorOptions tensor;
+  tensor.width = getIntOption(runtime, options, "width", "Frame.toTensor");
+  tensor.height = getIntOption(runtime, options, "height", "Frame.toTensor");
+  if (tensor.width <= 0 || tensor.height <= 0) {
+    throw jsi::JSError(runtime, "Frame.toTensor: `width` and `height` must be greater than 0!");
+  }
+
+  tensor.crop = { 0, 0, descriptor.width, descriptor.height };
+  auto cropValue = options.getProperty(runtime, "crop");
+  if (cropValue.isObject()) {
+    auto crop = cropValue.asObject(runtime);
+    tensor.crop.x = getIntOption(runtime, crop, "x", "Frame.toTensor: crop");
+    tensor.crop.y = getIntOption(runtime, crop, "y", "Frame.toTensor: crop");
+    tensor.crop.width = getIntOption(runtime, crop, "width", "Frame.toTensor: crop");
+    tensor.crop.height = getIntOption(runtime, crop, "height", "Frame.toTensor: crop");
+    if (tensor.crop.x < 0 || tensor.crop.y < 0 || tensor.crop.width <= 0 || tensor.crop.height <= 0 ||
+        tensor.crop.x + tensor.crop.width > descriptor.width || tensor.crop.y + tensor.crop.height > descriptor.height) {
+      throw jsi::JSError(runtime, "Frame.toTensor: `crop` must be a non-empty rectangle within the Frame!");
+    }
+  }
+
+  auto layout = options.getProperty(runtime, "layout");
+  if (layout.isString()) {
+    auto name = layout.asString(runtime).utf8(runtime);
+    if (name == "NHWC") {
+      tensor.layout = kernels::TensorLayout::NHWC;
+    } else if (name == "NCHW") {
+      tensor.layout = kernels::TensorLayout::NCHW;
+    } else {
+      throw jsi::JSError(runtime, "Frame.toTensor: Unknown layout \"" + name + "\"! Expected NHWC or NCHW.");
+    }
+  }
+
+  auto dataType = options.getProperty(runtime, "dtype");
+  if (dataType.isString()) {
+    auto name = dataType.asString(runtime).utf8(runtime);
+    if (name == "float32") {
+      tensor.dataType = kernels::TensorDataType::Float32;
+    } else if (name == "uint8") {
+      tensor.dataType = kernels::TensorDataType::UInt8;
+    } else if (name == "int8") {
+      tensor.dataType = kernels::TensorDataType::Int8;
+    } else {
+      throw jsi::JSError(runtime, "Frame.toTensor: Unknown dtype \"" + name + "\"! Expected float32, uint8 or int8.");
+    }
+  }
+
+  auto format = options.getProperty(runtime, "format");
+  if (format.isString()) {
+    auto name = format.asString(runtime).utf8(runtime);
+    if (name == "rgb") {
+      tensor.channelOrder = kernels::RGBFormat::RGB;
+    } else if (name == "bgr") {
+      tensor.channelOrder = kernels::RGBFormat::BGR;
+    } else {
+      throw jsi::JSError(runtime, "Frame.toTensor: Unknown format \"" + name + "\"! Expected rgb or bgr.");
+    }
+  }
+
+  // area averaging avoids aliasing once we skip source pixels, bilinear is sharper for everything else.
+  bool isLargeDownscale = tensor.crop.width >= tensor.width * 2 && tensor.crop.height >= tensor.height * 2;
+  tensor.resizeMode = isLargeDownscale ? kernels::ResizeMode::Area : kernels::ResizeMode::Bilinear;
+  auto resize = options.getProperty(runtime, "resize");
+  if (resize.isString()) {
+    auto name = resize.asString(runtime).utf8(runtime);
+    if (name == "bilinear") {
+      tensor.resizeMode = kernels::ResizeMode::Bilinear;
+    } else if (name == "area") {
+      tensor.resizeMode = kernels::ResizeMode::Area;
+    } else {
+      throw jsi::JSError(runtime, "Frame.toTensor: Unknown resize mode \"" + name + "\"! Expected bilinear or area.");
+    }
+  }
+
+  parseChannelOption(runtime, options, "mean", tensor.mean);
+  parseChannelOption(runtime, options, "std", tensor.std);
+  for (float std : tensor.std) {
+    if (std == 0.0f) {
+      throw jsi::JSError(runtime, "Frame.toTensor: `std` must not be 0!");
+    }
+  }
+
+  size_t byteSize = kernels::getTensorByteSize(tensor);
+  auto output = options.getProperty(runtime, "output");
+  if (output.isObject() && output.asObject(runtime).isArrayBuffer(runtime)) {
+    // write into the caller's buffer, so a Frame Processor can reuse the same tensor for every Frame.
+    auto arrayBuffer = output.asObject(runtime).getArrayBuffer(runtime);
+    if (arrayBuffer.size(runtime) < byteSize) {
+      auto message = "Frame.toTensor: `output` is too small, the tensor needs " + std::to_string(byteSize) + " bytes but it only has " +
+                     std::to_string(arrayBuffer.size(runtime)) + " bytes!";
+      throw jsi::JSError(runtime, message.c_str());
+    }
+    if (!kernels::convertFrameToTensor(descriptor, tensor, arrayBuffer.data(runtime))) {
+      throw jsi::JSError(runtime, "Frame.toTensor: The Frame's pixel format is not supported!");
+    }
+    return std::move(arrayBuffer);
+  } else if (!output.isUndefined()) {
+    throw jsi::JSError(runtime, "Frame.toTensor: `output` must be an ArrayBuffer!");
+  }
+
+  auto result = PooledMutableBuffer::acquire(byteSize);
+  if (!kernels::convertFrameToTensor(descriptor, tensor, result->data())) {
+    throw jsi::JSError(runtime, "Frame.toTensor: The Frame's pixel format is not supported!");
+  }
+  return jsi::ArrayBuffer(runtime, result);
+}
+
+jsi::Value FrameHostObjectBase::crop(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  assertIsFrameStrong(runtime, "crop");
+  if (count < 1 || !arguments[0].isObject()) {
+    throw jsi::JSError(runtime, "Frame.crop: First argument ('rect') must be an object!");
+  }
+  auto rectObject = arguments[0].asObject(runtime);
+  FrameRect rect;
+  rect.x = getIntOption(runtime, rectObject, "x", "Frame.crop");
+  rect.y = getIntOption(runtime, rectObject, "y", "Frame.crop");
+  rect.width = getIntOption(runtime, rectObject, "width", "Frame.crop");
+  rect.height = getIntOption(runtime, rectObject, "height", "Frame.crop");
+  if (!isRectWithinFrame(descriptor, rect)) {
+    throw jsi::JSError(runtime, "Frame.crop: `rect` must be a non-empty rectangle within the Frame!");
+  }
+
+  // crops of crops refer to the source Frame directly, so there is only one level of Frames to invalidate.
+  auto& source = getSourceFrame();
+  auto offset = getSourceRect();
+  rect.x += offset.x;
+  rect.y += offset.y;
+  rect = alignCropRect(source.descriptor, rect);
+
+  auto result = std::make_shared<CroppedFrameHostObject>(source.shared_from_this(), rect);
+  {
+    std::unique_lock lock(source.cropsMutex_);
+    if (source.isReleased_.load(std::memory_order_acquire)) {
+      throw jsi::JSError(runtime, "Cannot get `crop`, frame is already closed!");
+    }
+    // drop crops that have been garbage collected already, so a Frame that is cropped repeatedly does not accumulate them.
+    auto isExpired = [](const std::weak_ptr<FrameHostObjectBase>& crop) { return crop.expired(); };
+    source.crops_.erase(std::remove_if(source.crops_.begin(), source.crops_.end(), isExpired), source.crops_.end());
+    source.crops_.push_back(result);
+  }
+  return jsi::Object::createFromHostObject(runtime, result);
+}
+
+jsi::Value FrameHostObjectBase::getLumaStatistics(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+  assertIsFrameStrong(runtime, "getLumaStatistics");
+  kernels::YUVImage image;
+  if (!kernels::describeYUVImage(descriptor, image)) {
+    throw jsi::JSError(runtime, "Frame.getLumaStatistics: The Frame's pixel format is not supported! Only YUV Frames have a luma plane.");
+  }
+
+  bool wantsHistogram = false;
+  bool wantsSharpness = false;
+  int gridColumns = 0;
+  int gridRows = 0;
+  if (count > 0 && arguments[0].isObject()) {
+    auto options = arguments[0].asObject(runtime);
+    auto histogram = options.getProperty(runtime, "histogram");
+    wantsHistogram = histogram.isBool() && histogram.getBool();
+    auto sharpness = options.getProperty(runtime, "sharpness");
+    wantsSharpness = sharpness.isBool() && sharpness.getBool();
+    auto gridValue = options.getProperty(runtime, "grid");
+    if (gridValue.isObject()) {
+      auto grid = gridValue.asObject(runtime);
+      gridColumns = getIntOption(runtime, grid, "columns", "Frame.getLumaStatistics: grid");
+      gridRows = getIntOption(runtime, grid, "rows", "Frame.getLumaStatistics: grid");
+      if (gridColumns <= 0 || gridRows <= 0 || gridColumns > descriptor.width || gridRows > descriptor.height) {
+        throw jsi::JSError(runtime, "Frame.getLumaStatistics: `grid` must have at least 1 and at most as many columns and rows as the Frame!");
+      }
+    } else if (!gridValue.isUndefined()) {
+      throw jsi::JSError(runtime, "Frame.getLumaStatistics: `grid` must be an object!");
+    }
+  }
+
+  // the kernel writes straight into the buffers that back the returned typed arrays.
+  kernels::LumaStatisticsOptions options;
+  std::shared_ptr<PooledMutableBuffer> histogram;
+  if (wantsHistogram) {
+    histogram = PooledMutableBuffer::acquire(kernels::kLumaHistogramBins * sizeof(uint32_t));
+    options.histogram = reinterpret_cast<uint32_t*>(histogram->data());
+  }
+  std::shared_ptr<PooledMutableBuffer> gridMean;
+  std::shared_ptr<PooledMutableBuffer> gridVariance;
+  if (gridColumns > 0) {
+    size_t cellsSize = static_cast<size_t>(gridColumns) * gridRows * sizeof(float);
+    gridMean = PooledMutableBuffer::acquire(cellsSize);
+    gridVariance = PooledMutableBuffer::acquire(cellsSize);
+    options.gridColumns = gridColumns;
+    options.gridRows = gridRows;
+    options.gridMean = reinterpret_cast<float*>(gridMean->data());
+    options.gridVariance = reinterpret_cast<float*>(gridVariance->data());
+  }
+  options.sharpness = wantsSharpness;
+
+  auto statistics = kernels::computeLumaStatistics(image.y, image.yRowStride, image.width, image.height, options);
+
+  auto result = jsi::Object(runtime);
+  result.setProperty(runtime, "mean", jsi::Value(statistics.mean));
+  result.setProperty(runtime, "variance", jsi::Value(statistics.variance));
+  if (histogram != nullptr) {
+    result.setProperty(runtime, "histogram", createTypedArray(runtime, "Uint32Array", jsi::ArrayBuffer(runtime, histogram)));
+  }
+  if (gridMean != nullptr) {
+    auto grid = jsi::Object(runtime);
+    grid.setProperty(runtime, "columns", jsi::Value(gridColumns));
+    grid.setProperty(runtime, "rows", jsi::Value(gridRows));
+    grid.setProperty(runtime, "mean", createTypedArray(runtime, "Float32Array", jsi::ArrayBuffer(runtime, gridMean)));
+    grid.setProperty(runtime, "variance", createTypedArray(runtime, "Float32Array", jsi::ArrayBuffer(runtime, gridVariance)));
+    result.setProperty(runtime, "grid", grid);
+  }
+  if (wantsSharpness) {
+    result.setProperty(runtime, "sharpness", jsi::Value(statistics.sharpness));
+  }
+  return result;
+}
+
+void FrameHostObjectBase::assertIsFrameStrong(jsi::Runtime& runtime, const char* accessedPropName) const {
+  if (!descriptor.isValid) {
+    auto message = std::string("Cannot get `") + accessedPropName + "`, frame is already closed!";
+    throw jsi::JSError(runtime, message.c_str());
+  }
+}
+
+} // namespace vision
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FrameCrop.h"
+#include "FrameDescriptor.h"
+#include "FrameProcessorStats.h"
+#include "FramePropertyCache.h"
+#include "FrameRetentionBudget.h"
+#include "FrameRetentionMonitor.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * The platform-independent part of a Frame HostObject, shared by the Android and the iOS `FrameHostObjectOld`.
+ *
+ * All properties are resolved through the Runtime's FramePropertyCache and read from the FrameDescriptor,
+ * the platform implementations only own the native Frame and decide how it is closed.
+ *
+ * Frames are reference counted: the Frame Processor holds the first reference while it runs, and JS can retain
+ * the Frame beyond that with `incrementRefCount()`. The native Frame is closed the moment the last reference is released,
+ * instead of whenever the JS garbage collector destroys the HostObject.
+ *
+ * `crop()` returns a CroppedFrameHostObject that shares this Frame's memory. Crops are only valid as long as this Frame is,
+ * they are invalidated the moment it is closed.
+ *
+ * `getPlane()` and `toArrayBuffer()` return ArrayBuffers that point directly into the Frame's memory. Each one holds a reference
+ * to the Frame until it is garbage collected, and `close()` refuses to close a Frame while any of them are alive.
+ *
+ * A Frame that JS retains (with `incrementRefCount()` or a zero-copy ArrayBuffer) takes a slot of its Camera's FrameRetentionBudget
+ * until it is closed. Once the budget is exhausted `incrementRefCount()` throws, and ArrayBuffers are copies instead.
+ */
+class JSI_EXPORT FrameHostObjectBase : public jsi::HostObject, public std::enable_shared_from_this<FrameHostObjectBase> {
+ public:
+  explicit FrameHostObjectBase(const FrameDescriptor& descriptor);
+  ~FrameHostObjectBase() override;
+
+ public:
+  jsi::Value get(jsi::Runtime& runtime, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& runtime) override;
+
+  /**
+   * Invokes the Frame method `property` (e.g. `close`) on this Frame.
+   */
+  jsi::Value invoke(jsi::Runtime& runtime, FrameProperty property, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+
+  /**
+   * Retains the Frame so it stays valid after the Frame Processor returned, e.g. to hand it to background work.
+   */
+  virtual void incrementRefCount();
+  /**
+   * Releases one reference, and closes the Frame if it was the last one.
+   * The Frame Processor releases its own reference once the worklet returned.
+   */
+  virtual void decrementRefCount();
+  virtual int getRefCount() const { return refCount_.load(std::memory_order_acquire); }
+  /**
+   * Closes the Frame now, no matter how many references are still held. Only the first call closes the native Frame.
+   */
+  void release();
+
+  /**
+   * Closes the Frame and returns its buffer to the Camera. Called exactly once, through release().
+   */
+  virtual void close() = 0;
+  /**
+   * Marks the Frame as invalid without closing it, e.g. because the Camera closes it itself.
+   */
+  void invalidate() { descriptor.isValid.store(false); }
+
+  /**
+   * The Frame that owns the platform buffer, which platform plugins receive: this Frame, or the Frame a crop was created from.
+   */
+  virtual FrameHostObjectBase& getSourceFrame() { return *this; }
+  /**
+   * The region of getSourceFrame() this Frame covers.
+   */
+  virtual FrameRect getSourceRect() const { return { 0, 0, descriptor.width, descriptor.height }; }
+
+ public:
+  FrameDescriptor descriptor;
+  /**
+   * The stats of the Camera that delivered this Frame, which plugin calls with it are recorded into. Null for Frames no Camera delivered.
+   * Crops use their source Frame's stats.
+   */
+  std::shared_ptr<FrameProcessorStats> stats;
+  /**
+   * The budget of the Camera that delivered this Frame, which limits how many of its Frames JS can retain. Null for no limit.
+   * Crops use their source Frame's budget.
+   */
+  std::shared_ptr<FrameRetentionBudget> retentionBudget;
+
+ protected:
+  /**
+   * Creates a Frame that does not own a Camera buffer (e.g. a crop), so it is not tracked by the FrameRetentionMonitor.
+   */
+  FrameHostObjectBase(const FrameDescriptor& descriptor, bool isTracked);
+
+  void assertIsFrameStrong(jsi::Runtime& runtime, const char* accessedPropName) const; // NOLINT(runtime/references)
+
+ private:
+  jsi::Value getPlane(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+  jsi::Value toArrayBuffer(jsi::Runtime& runtime); // NOLINT(runtime/references)
+  jsi::Value toRGB(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+  jsi::Value toTensor(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+  jsi::Value crop(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+  jsi::Value getLumaStatistics(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count); // NOLINT(runtime/references)
+  /**
+   * Takes a slot of the retention budget for the source Frame, unless it holds one already. Returns false if the budget is exhausted.
+   */
+  bool acquireRetentionSlot();
+
+ private:
+  class MemoryBuffer;
+
+ private:
+  std::atomic<int> refCount_ { 1 };
+  // ArrayBuffers that point into this Frame's memory (also through crops), see MemoryBuffer.
+  std::atomic<int> memoryBuffers_ { 0 };
+  std::atomic<bool> isReleased_ { false };
+  // whether this Frame holds a slot of its retentionBudget, given back once it is released
+  std::atomic<bool> holdsRetentionSlot_ { false };
+  // 0 if the Frame is not tracked
+  FrameRetentionMonitor::Token retentionToken_ = 0;
+  // invalidated once this Frame is released
+  std::mutex cropsMutex_;
+  std::vector<std::weak_ptr<FrameHostObjectBase>> crops_;
+};
+
+} // namespace vision
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+
+#include "FrameDescriptor.h"
+#include "ParallelPluginCall.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * A Frame Processor Plugin that is implemented in C++.
+ *
+ * Unlike Java (`FrameProcessorPlugin`) and Objective-C (`VISION_EXPORT_FRAME_PROCESSOR`) plugins, a native plugin is called
+ * directly from the worklet runtime: it receives the Frame's FrameDescriptor and the JS arguments as they are, and returns a
+ * jsi::Value. Nothing is converted to Java/Objective-C objects, and no JNI/Objective-C calls are made per Frame.
+ *
+ * Register it with `VISION_EXPORT_NATIVE_FRAME_PROCESSOR_PLUGIN(MyPlugin)`, it is installed into the worklet runtime as
+ * `__<name>` together with the platform plugins.
+ */
+class FrameProcessorPluginNative {
+ public:
+  virtual ~FrameProcessorPluginNative() = default;
+
+  /**
+   * The name of the plugin. The JS function is prefixed with two underscores (`__`).
+   */
+  virtual std::string getName() const = 0;
+
+  /**
+   * Called on the Frame Processor thread for every call of the plugin in a worklet.
+   *
+   * @param frame The Frame the plugin was called with. Its plane pointers are only valid during this call,
+   *              unless the worklet retained the Frame (`frame.incrementRefCount()`).
+   * @param arguments The arguments after the Frame.
+   * @param count The amount of arguments after the Frame.
+   */
+  virtual jsi::Value callback(jsi::Runtime& runtime, // NOLINT(runtime/references)
+                              const FrameDescriptor& frame,
+                              const jsi::Value* arguments,
+                              size_t count) = 0;
+
+  /**
+   * Optional: prepares a call that `runParallel()` can run on another thread, at the same time as other plugins.
+   * Convert `arguments` into plain C++ values here, ParallelPluginCall::run() does the work without touching the Runtime.
+   *
+   * The default returns nullptr, `runParallel()` then calls callback() on the Frame Processor thread while the other plugins run.
+   *
+   * @param frame The Frame the plugin was called with. Its plane pointers stay valid until `runParallel()` returned.
+   */
+  virtual std::unique_ptr<ParallelPluginCall> prepareParallelCall(jsi::Runtime& runtime, // NOLINT(runtime/references)
+                                                                  const FrameDescriptor& frame,
+                                                                  const jsi::Value* arguments,
+                                                                  size_t count) {
+    return nullptr;
+  }
+};
+
+/**
+ * Registers `plugin` in the FrameProcessorPluginRegistryNative. Used by VISION_EXPORT_NATIVE_FRAME_PROCESSOR_PLUGIN.
+ */
+bool registerNativeFrameProcessorPlugin(std::shared_ptr<FrameProcessorPluginNative> plugin);
+
+} // namespace vision
+
+#define VISION_NATIVE_CONCAT2(A, B) A##B
+#define VISION_NATIVE_CONCAT(A, B) VISION_NATIVE_CONCAT2(A, B)
+
+/**
+ * Use this Macro in a .cpp file to register the given FrameProcessorPluginNative subclass when its library is loaded.
+ * * Make sure the class is default-constructible
+ * * Make sure the plugin's name is unique across other frame processor plugins: a Java/Objective-C plugin with the same name is replaced,
+ *   and a second native plugin with the same name is ignored (and logged)
+ * * On Android, make sure the library containing the plugin is loaded (`System.loadLibrary`) before the Camera sets a Frame Processor
+ */
+#define VISION_EXPORT_NATIVE_FRAME_PROCESSOR_PLUGIN(plugin_class)                                                    \
+  static const bool VISION_NATIVE_CONCAT(plugin_class, _isRegistered) =                                              \
+    ::vision::registerNativeFrameProcessorPlugin(std::make_shared<plugin_class>());
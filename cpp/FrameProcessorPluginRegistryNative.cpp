@@ -0,0 +1,220 @@
+#include "FrameProcessorPluginRegistryNative.h"
+
+#include <jsi/jsi.h>
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#endif
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "FrameHostObjectBase.h"
+#include "FrameProcessorStats.h"
+#include "FrameTracer.h"
+#include "RuntimeCache.h"
+#include "RuntimeThreadScope.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+constexpr auto kPluginsInstalledGlobalName = "__visionCameraPluginsInstalled";
+constexpr auto kInstalledPluginsGlobalName = "__visionCameraInstalledPlugins";
+
+/**
+ * The plugins a Runtime has a `__<name>` getter for, and the registry version it has seen last.
+ */
+class InstalledPlugins : public jsi::HostObject {
+ public:
+  uint64_t version = 0;
+  std::unordered_set<std::string> names;
+};
+
+void defineGlobalProperty(jsi::Runtime& runtime, const std::string& name, jsi::Object descriptor) { // NOLINT(runtime/references)
+  auto object = runtime.global().getProperty(runtime, "Object").asObject(runtime);
+  auto defineProperty = object.getProperty(runtime, "defineProperty").asObject(runtime).asFunction(runtime);
+  defineProperty.callWithThis(runtime, object, runtime.global(), jsi::String::createFromUtf8(runtime, name), std::move(descriptor));
+}
+
+void logError(const std::string& message) {
+#if defined(__ANDROID__)
+  __android_log_write(ANDROID_LOG_ERROR, "VisionCameraOld", message.c_str());
+#else
+  fprintf(stderr, "VisionCameraOld: %s\n", message.c_str());
+#endif
+}
+
+} // namespace
+
+bool registerNativeFrameProcessorPlugin(std::shared_ptr<FrameProcessorPluginNative> plugin) {
+  FrameProcessorPluginRegistryNative::shared().addPlugin(std::move(plugin));
+  return true;
+}
+
+FrameProcessorPluginRegistryNative& FrameProcessorPluginRegistryNative::shared() {
+  // never destroyed, plugins register from static initializers and might outlive static destruction order.
+  static auto registry = new FrameProcessorPluginRegistryNative();
+  return *registry;
+}
+
+void FrameProcessorPluginRegistryNative::addPlugin(std::shared_ptr<FrameProcessorPluginNative> plugin) {
+  std::unique_lock lock(mutex_);
+  auto name = plugin->getName();
+  for (const auto& existing : plugins_) {
+    if (existing->getName() == name) {
+      // this runs in a static initializer, where nothing could catch an error. Keep the first plugin instead.
+      logError("Tried to register two native Frame Processor Plugins with the name \"" + name + "\", the second one is ignored! "
+               "Either choose unique names, or remove the unused plugin.");
+      return;
+    }
+  }
+  plugins_.push_back(std::move(plugin));
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+void FrameProcessorPluginRegistryNative::addPlatformPlugin(const std::string& name, CreatePluginFunction create) {
+  std::unique_lock lock(mutex_);
+  platformPlugins_[name] = std::move(create);
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<FrameProcessorPluginNative> FrameProcessorPluginRegistryNative::findPlugin(const std::string& name) const {
+  std::unique_lock lock(mutex_);
+  for (const auto& plugin : plugins_) {
+    if (plugin->getName() == name) {
+      return plugin;
+    }
+  }
+  return nullptr;
+}
+
+void FrameProcessorPluginRegistryNative::installPlugins(jsi::Runtime& runtime) const {
+  if (!RuntimeThreadScope::isCurrent(runtime)) {
+    // e.g. from the JS thread while the runtime processes a Frame on its own thread, which would corrupt the runtime.
+    throw std::logic_error("Frame Processor Plugins can only be installed on the thread that runs the worklet runtime!");
+  }
+  auto installed = RuntimeCache<InstalledPlugins>::get(runtime, kInstalledPluginsGlobalName, []() {
+    return std::make_shared<InstalledPlugins>();
+  });
+  if (installed->version == version_.load(std::memory_order_acquire)) {
+    // swapping a Frame Processor on a runtime that has seen every plugin already.
+    return;
+  }
+
+  std::vector<std::string> names;
+  {
+    std::unique_lock lock(mutex_);
+    installed->version = version_.load(std::memory_order_relaxed);
+    for (const auto& plugin : plugins_) {
+      names.push_back(plugin->getName());
+    }
+    for (const auto& [name, create] : platformPlugins_) {
+      names.push_back(name);
+    }
+  }
+
+  for (const auto& name : names) {
+    if (!installed->names.insert(name).second) {
+      continue;
+    }
+    // name is always prefixed with two underscores (__)
+    auto globalName = "__" + name;
+    // resolves the plugin on its first use, and then replaces itself with the plugin's function.
+    auto getter = [this, name, globalName](jsi::Runtime& runtime,
+                                           const jsi::Value& thisValue,
+                                           const jsi::Value* arguments,
+                                           size_t count) -> jsi::Value {
+      auto function = createPluginFunction(runtime, name);
+      auto descriptor = jsi::Object(runtime);
+      descriptor.setProperty(runtime, "value", jsi::Value(runtime, function));
+      descriptor.setProperty(runtime, "writable", true);
+      descriptor.setProperty(runtime, "configurable", true);
+      defineGlobalProperty(runtime, globalName, std::move(descriptor));
+      return jsi::Value(std::move(function));
+    };
+    auto descriptor = jsi::Object(runtime);
+    descriptor.setProperty(runtime, "get", jsi::Function::createFromHostFunction(runtime,
+                                                                               jsi::PropNameID::forUtf8(runtime, globalName),
+                                                                               0,
+                                                                               getter));
+    descriptor.setProperty(runtime, "configurable", true);
+    defineGlobalProperty(runtime, globalName, std::move(descriptor));
+  }
+}
+
+jsi::Function FrameProcessorPluginRegistryNative::createPluginFunction(jsi::Runtime& runtime, const std::string& pluginName) const {
+  // a native plugin replaces a platform plugin with the same name.
+  auto plugin = findPlugin(pluginName);
+  if (plugin == nullptr) {
+    CreatePluginFunction create;
+    {
+      std::unique_lock lock(mutex_);
+      auto platformPlugin = platformPlugins_.find(pluginName);
+      if (platformPlugin != platformPlugins_.end()) {
+        create = platformPlugin->second;
+      }
+    }
+    if (create == nullptr) {
+      throw jsi::JSError(runtime, "There is no Frame Processor Plugin named \"" + pluginName + "\"!");
+    }
+    return create(runtime);
+  }
+
+  // name is always prefixed with two underscores (__)
+  auto name = "__" + pluginName;
+  auto traceName = FrameTracer::shared().intern("plugin " + name);
+
+  auto function = [plugin, name, traceName](jsi::Runtime& runtime,
+                                 const jsi::Value& thisValue,
+                                 const jsi::Value* arguments,
+                                 size_t count) -> jsi::Value {
+    if (count < 1 || !arguments[0].isObject() || !arguments[0].asObject(runtime).isHostObject(runtime)) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + ": First argument ('frame') must be a Frame!");
+    }
+    auto boxedHostObject = arguments[0].asObject(runtime).asHostObject(runtime);
+    auto frameHostObject = dynamic_cast<FrameHostObjectBase*>(boxedHostObject.get());
+    if (frameHostObject == nullptr) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + ": First argument ('frame') must be a Frame!");
+    }
+    if (!frameHostObject->descriptor.isValid) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin " + name + " was called with a Frame that has already been released!");
+    }
+
+    // we are offset by `1` because the frame is the first parameter.
+    auto stats = frameHostObject->getSourceFrame().stats.get();
+    TraceScope trace(traceName, frameHostObject->descriptor.timestamp);
+    // C++ plugins read their arguments themselves, so the whole call is one stage.
+    PluginStageScope stage(stats, PluginStage::Call);
+    try {
+      return plugin->callback(runtime, frameHostObject->descriptor, arguments + 1, count - 1);
+    } catch (...) {
+      if (stats != nullptr) {
+        stats->recordPluginError();
+      }
+      throw;
+    }
+  };
+
+  return jsi::Function::createFromHostFunction(runtime,
+                                               jsi::PropNameID::forUtf8(runtime, name),
+                                               1, // frame
+                                               function);
+}
+
+bool FrameProcessorPluginRegistryNative::arePluginsInstalled(jsi::Runtime& runtime) {
+  return runtime.global().hasProperty(runtime, kPluginsInstalledGlobalName);
+}
+
+void FrameProcessorPluginRegistryNative::markPluginsInstalled(jsi::Runtime& runtime) {
+  runtime.global().setProperty(runtime, kPluginsInstalledGlobalName, jsi::Value(true));
+}
+
+} // namespace vision
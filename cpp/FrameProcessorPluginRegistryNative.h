@@ -0,0 +1,89 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameProcessorPluginNative.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Holds all Frame Processor Plugins, shared by Android and iOS: the C++ plugins (FrameProcessorPluginNative), which register
+ * themselves when their library is loaded, and the platform (Java/Objective-C) plugins.
+ *
+ * Plugins are installed lazily: installPlugins() only defines a `__<name>` getter for every plugin the runtime doesn't know yet,
+ * and the getter creates the plugin's function on its first use. Plugins can be added at any time, the next installPlugins()
+ * on a runtime picks them up - and costs nothing if no plugin has been added since the last one.
+ *
+ * installPlugins(), markPluginsInstalled() and the getters modify the runtime's globals, so they must only ever run on the
+ * runtime's own thread, inside a RuntimeThreadScope.
+ */
+class FrameProcessorPluginRegistryNative {
+ public:
+  /**
+   * Get the registry shared by all Cameras.
+   */
+  static FrameProcessorPluginRegistryNative& shared();
+
+  /**
+   * Adds the given plugin. If a native plugin with the same name has already been added, logs an error and keeps that one.
+   */
+  void addPlugin(std::shared_ptr<FrameProcessorPluginNative> plugin);
+
+  /**
+   * Creates the `__<name>` function of a platform plugin in the given Runtime.
+   */
+  using CreatePluginFunction = std::function<jsi::Function(jsi::Runtime& runtime)>; // NOLINT(runtime/references)
+  /**
+   * Adds a platform (Java/Objective-C) plugin. A native plugin with the same name replaces it, a later platform plugin with the
+   * same name replaces it in all runtimes that haven't used it yet.
+   */
+  void addPlatformPlugin(const std::string& name, CreatePluginFunction create);
+
+  /**
+   * Get the native plugin with the given name, or nullptr if there is none.
+   */
+  std::shared_ptr<FrameProcessorPluginNative> findPlugin(const std::string& name) const;
+
+  /**
+   * Defines a lazy `__<name>` getter in the given (worklet) Runtime for every plugin that has been added since the last call.
+   * Throws a std::logic_error if it is not called inside a RuntimeThreadScope of `runtime`.
+   */
+  void installPlugins(jsi::Runtime& runtime) const; // NOLINT(runtime/references)
+
+  /**
+   * Incremented whenever a plugin is added. A runtime that has installed the plugins at this version doesn't need installPlugins() again.
+   */
+  uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+  /**
+   * Whether the bindings plugins rely on (e.g. `__runParallel`) have already been installed into the given Runtime.
+   */
+  static bool arePluginsInstalled(jsi::Runtime& runtime); // NOLINT(runtime/references)
+  /**
+   * Marks the given Runtime as having the plugin bindings installed. The marker is a hidden global, so it goes away with the Runtime.
+   */
+  static void markPluginsInstalled(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+ private:
+  jsi::Function createPluginFunction(jsi::Runtime& runtime, const std::string& name) const; // NOLINT(runtime/references)
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<FrameProcessorPluginNative>> plugins_;
+  std::unordered_map<std::string, CreatePluginFunction> platformPlugins_;
+  // incremented whenever a plugin is added, so runtimes that have seen the current version skip installPlugins().
+  std::atomic<uint64_t> version_ { 0 };
+};
+
+} // namespace vision
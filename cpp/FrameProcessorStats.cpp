@@ -0,0 +1,85 @@
+#include "FrameProcessorStats.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace vision {
+
+namespace {
+
+struct ViewRegistry {
+  std::mutex mutex;
+  std::unordered_map<int, std::shared_ptr<FrameProcessorStats>> stats;
+};
+
+ViewRegistry& getViewRegistry() {
+  // never destroyed, views might unregister while static destructors run.
+  static auto registry = new ViewRegistry();
+  return *registry;
+}
+
+} // namespace
+
+void FrameProcessorStats::recordExecutionTime(std::chrono::nanoseconds duration) {
+  executionTime_.record(duration);
+}
+
+void FrameProcessorStats::recordLatency(std::chrono::nanoseconds duration) {
+  latency_.record(duration);
+}
+
+void FrameProcessorStats::recordPluginStage(PluginStage stage, std::chrono::nanoseconds duration) {
+  switch (stage) {
+    case PluginStage::ArgumentsConversion:
+      pluginArgumentsConversion_.record(duration);
+      break;
+    case PluginStage::Call:
+      pluginCall_.record(duration);
+      break;
+    case PluginStage::ResultConversion:
+      pluginResultConversion_.record(duration);
+      break;
+  }
+}
+
+FrameProcessorStatsSnapshot FrameProcessorStats::getSnapshot() const {
+  FrameProcessorStatsSnapshot snapshot;
+  snapshot.executionTime = executionTime_.getSummary();
+  snapshot.latency = latency_.getSummary();
+  snapshot.pluginArgumentsConversion = pluginArgumentsConversion_.getSummary();
+  snapshot.pluginCall = pluginCall_.getSummary();
+  snapshot.pluginResultConversion = pluginResultConversion_.getSummary();
+  snapshot.framesDelivered = framesDelivered_.load(std::memory_order_relaxed);
+  snapshot.framesThrottled = framesThrottled_.load(std::memory_order_relaxed);
+  snapshot.framesUnchanged = framesUnchanged_.load(std::memory_order_relaxed);
+  snapshot.framesDropped = framesDropped_.load(std::memory_order_relaxed);
+  snapshot.frameProcessorErrors = frameProcessorErrors_.load(std::memory_order_relaxed);
+  snapshot.pluginErrors = pluginErrors_.load(std::memory_order_relaxed);
+  snapshot.asyncTasksRun = asyncTasksRun_.load(std::memory_order_relaxed);
+  snapshot.asyncTasksSkipped = asyncTasksSkipped_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void FrameProcessorStats::registerView(int viewTag, std::shared_ptr<FrameProcessorStats> stats) {
+  auto& registry = getViewRegistry();
+  std::unique_lock lock(registry.mutex);
+  registry.stats[viewTag] = std::move(stats);
+}
+
+void FrameProcessorStats::unregisterView(int viewTag) {
+  auto& registry = getViewRegistry();
+  std::unique_lock lock(registry.mutex);
+  registry.stats.erase(viewTag);
+}
+
+std::shared_ptr<FrameProcessorStats> FrameProcessorStats::get(int viewTag) {
+  auto& registry = getViewRegistry();
+  std::unique_lock lock(registry.mutex);
+  auto entry = registry.stats.find(viewTag);
+  return entry != registry.stats.end() ? entry->second : nullptr;
+}
+
+} // namespace vision
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "LatencyHistogram.h"
+
+namespace vision {
+
+/**
+ * A stage of a Frame Processor Plugin call.
+ */
+enum class PluginStage {
+  ArgumentsConversion,
+  Call,
+  ResultConversion,
+};
+
+struct FrameProcessorStatsSnapshot {
+  // how long the Frame Processor (worklet) took to run
+  LatencySummary executionTime;
+  // from the Camera delivering the Frame until the Frame Processor returned, including the time the Frame was queued
+  LatencySummary latency;
+  // Frames the Camera delivered to the Frame Processor pipeline
+  uint64_t framesDelivered = 0;
+  // Frames that were skipped because of `frameProcessorFps`
+  uint64_t framesThrottled = 0;
+  // Frames that were skipped because they did not change enough (`frameProcessorChangeThreshold`)
+  uint64_t framesUnchanged = 0;
+  // Frames that were dropped because the Frame Processor was still busy (backpressure)
+  uint64_t framesDropped = 0;
+  // Frames for which the Frame Processor threw an error
+  uint64_t frameProcessorErrors = 0;
+  // errors thrown by Frame Processor Plugins called with this Camera's Frames
+  uint64_t pluginErrors = 0;
+  // the stages of a Frame Processor Plugin call: converting the arguments, the plugin itself, and converting its result
+  LatencySummary pluginArgumentsConversion;
+  LatencySummary pluginCall;
+  LatencySummary pluginResultConversion;
+  // runAsync() tasks that ran, and that were skipped because too many were in flight already
+  uint64_t asyncTasksRun = 0;
+  uint64_t asyncTasksSkipped = 0;
+};
+
+/**
+ * Collects the latency distribution and the Frame counters of a single Camera's Frame Processor.
+ *
+ * Everything is recorded lock-free on the Camera/Frame Processor threads and can be read from any thread.
+ */
+class FrameProcessorStats {
+ public:
+  void recordFrameDelivered() { framesDelivered_.fetch_add(1, std::memory_order_relaxed); }
+  void recordFrameThrottled() { framesThrottled_.fetch_add(1, std::memory_order_relaxed); }
+  void recordFrameUnchanged() { framesUnchanged_.fetch_add(1, std::memory_order_relaxed); }
+  void recordFrameDropped() { framesDropped_.fetch_add(1, std::memory_order_relaxed); }
+  void recordFrameProcessorError() { frameProcessorErrors_.fetch_add(1, std::memory_order_relaxed); }
+  void recordAsyncTaskRun() { asyncTasksRun_.fetch_add(1, std::memory_order_relaxed); }
+  void recordAsyncTaskSkipped() { asyncTasksSkipped_.fetch_add(1, std::memory_order_relaxed); }
+  void recordPluginError() { pluginErrors_.fetch_add(1, std::memory_order_relaxed); }
+
+  void recordExecutionTime(std::chrono::nanoseconds duration);
+  void recordLatency(std::chrono::nanoseconds duration);
+  void recordPluginStage(PluginStage stage, std::chrono::nanoseconds duration);
+
+  FrameProcessorStatsSnapshot getSnapshot() const;
+
+  /**
+   * Makes `stats` available through get(viewTag), for platforms that can not look up a Camera view from the JS thread.
+   */
+  static void registerView(int viewTag, std::shared_ptr<FrameProcessorStats> stats);
+  static void unregisterView(int viewTag);
+  static std::shared_ptr<FrameProcessorStats> get(int viewTag);
+
+ private:
+  LatencyHistogram executionTime_;
+  LatencyHistogram latency_;
+  LatencyHistogram pluginArgumentsConversion_;
+  LatencyHistogram pluginCall_;
+  LatencyHistogram pluginResultConversion_;
+
+  std::atomic<uint64_t> framesDelivered_ { 0 };
+  std::atomic<uint64_t> framesThrottled_ { 0 };
+  std::atomic<uint64_t> framesUnchanged_ { 0 };
+  std::atomic<uint64_t> framesDropped_ { 0 };
+  std::atomic<uint64_t> frameProcessorErrors_ { 0 };
+  std::atomic<uint64_t> asyncTasksRun_ { 0 };
+  std::atomic<uint64_t> asyncTasksSkipped_ { 0 };
+  std::atomic<uint64_t> pluginErrors_ { 0 };
+};
+
+/**
+ * Records the time until end() (or the end of the scope) as a plugin stage of `stats`. Does nothing if `stats` is null,
+ * e.g. for a replayed Frame that no Camera delivered.
+ */
+class PluginStageScope {
+ public:
+  PluginStageScope(FrameProcessorStats* stats, PluginStage stage):
+    stats_(stats), stage_(stage), start_(stats != nullptr ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) { }
+
+  ~PluginStageScope() { end(); }
+
+  /**
+   * Ends the stage before the scope ends. Only the first call records it.
+   */
+  void end() {
+    if (stats_ != nullptr) {
+      stats_->recordPluginStage(stage_, std::chrono::steady_clock::now() - start_);
+      stats_ = nullptr;
+    }
+  }
+
+  PluginStageScope(const PluginStageScope&) = delete;
+  PluginStageScope& operator=(const PluginStageScope&) = delete;
+
+ private:
+  FrameProcessorStats* stats_;
+  PluginStage stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace vision
@@ -0,0 +1,64 @@
+#include "FrameProcessorStatsBindings.h"
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <utility>
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+jsi::Object createLatencyObject(jsi::Runtime& runtime, const LatencySummary& summary) { // NOLINT(runtime/references)
+  auto result = jsi::Object(runtime);
+  result.setProperty(runtime, "count", jsi::Value(static_cast<double>(summary.count)));
+  result.setProperty(runtime, "mean", jsi::Value(summary.mean));
+  result.setProperty(runtime, "p50", jsi::Value(summary.p50));
+  result.setProperty(runtime, "p90", jsi::Value(summary.p90));
+  result.setProperty(runtime, "p99", jsi::Value(summary.p99));
+  result.setProperty(runtime, "max", jsi::Value(summary.max));
+  return result;
+}
+
+} // namespace
+
+void installFrameProcessorStatsBindings(jsi::Runtime& runtime, TGetFrameProcessorStats getStats) {
+  // getFrameProcessorStats(viewTag: number): FrameProcessorStats
+  auto getFrameProcessorStats = [getStats = std::move(getStats)](jsi::Runtime& runtime,
+                                                                 const jsi::Value& thisValue,
+                                                                 const jsi::Value* arguments,
+                                                                 size_t count) -> jsi::Value {
+    if (count < 1 || !arguments[0].isNumber()) {
+      throw jsi::JSError(runtime, "Camera::getFrameProcessorStats: First argument ('viewTag') must be a number!");
+    }
+    auto stats = getStats(static_cast<int>(arguments[0].asNumber()));
+    if (stats == nullptr) {
+      throw jsi::JSError(runtime, "Camera::getFrameProcessorStats: Could not find a Camera with the given view tag!");
+    }
+    auto snapshot = stats->getSnapshot();
+
+    auto result = jsi::Object(runtime);
+    result.setProperty(runtime, "executionTime", createLatencyObject(runtime, snapshot.executionTime));
+    result.setProperty(runtime, "latency", createLatencyObject(runtime, snapshot.latency));
+    result.setProperty(runtime, "framesDelivered", jsi::Value(static_cast<double>(snapshot.framesDelivered)));
+    result.setProperty(runtime, "framesThrottled", jsi::Value(static_cast<double>(snapshot.framesThrottled)));
+    result.setProperty(runtime, "framesUnchanged", jsi::Value(static_cast<double>(snapshot.framesUnchanged)));
+    result.setProperty(runtime, "framesDropped", jsi::Value(static_cast<double>(snapshot.framesDropped)));
+    result.setProperty(runtime, "frameProcessorErrors", jsi::Value(static_cast<double>(snapshot.frameProcessorErrors)));
+    result.setProperty(runtime, "pluginErrors", jsi::Value(static_cast<double>(snapshot.pluginErrors)));
+    result.setProperty(runtime, "pluginArgumentsConversion", createLatencyObject(runtime, snapshot.pluginArgumentsConversion));
+    result.setProperty(runtime, "pluginCall", createLatencyObject(runtime, snapshot.pluginCall));
+    result.setProperty(runtime, "pluginResultConversion", createLatencyObject(runtime, snapshot.pluginResultConversion));
+    result.setProperty(runtime, "asyncTasksRun", jsi::Value(static_cast<double>(snapshot.asyncTasksRun)));
+    result.setProperty(runtime, "asyncTasksSkipped", jsi::Value(static_cast<double>(snapshot.asyncTasksSkipped)));
+    return result;
+  };
+  runtime.global().setProperty(runtime, "getFrameProcessorStats", jsi::Function::createFromHostFunction(runtime,
+                                                                                                        jsi::PropNameID::forAscii(runtime, "getFrameProcessorStats"),
+                                                                                                        1, // viewTag
+                                                                                                        getFrameProcessorStats));
+}
+
+} // namespace vision
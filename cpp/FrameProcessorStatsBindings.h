@@ -0,0 +1,22 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <functional>
+#include <memory>
+
+#include "FrameProcessorStats.h"
+
+namespace vision {
+
+using namespace facebook;
+
+using TGetFrameProcessorStats = std::function<std::shared_ptr<FrameProcessorStats>(int viewTag)>;
+
+/**
+ * Installs `getFrameProcessorStats(viewTag)` into the given Runtime. `getStats` resolves the stats of the Camera with the given view tag,
+ * or returns `nullptr` if there is no such Camera.
+ */
+void installFrameProcessorStatsBindings(jsi::Runtime& runtime, TGetFrameProcessorStats getStats); // NOLINT(runtime/references)
+
+} // namespace vision
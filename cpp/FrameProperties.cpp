@@ -0,0 +1,94 @@
+#include "FrameProperties.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace vision {
+
+namespace {
+
+struct FramePropertyInfo {
+  std::string_view name;
+  int argumentsCount;
+};
+
+// must be in the same order as the FrameProperty enum.
+constexpr FramePropertyInfo kFrameProperties[] = {
+  { "width", -1 },
+  { "height", -1 },
+  { "isValid", -1 },
+  { "bytesPerRow", -1 },
+  { "planesCount", -1 },
+  { "getPlane", 1 },
+  { "toArrayBuffer", 0 },
+  { "toRGB", 1 },
+  { "toTensor", 1 },
+  { "crop", 1 },
+  { "getLumaStatistics", 1 },
+  { "toString", 0 },
+  { "incrementRefCount", 0 },
+  { "decrementRefCount", 0 },
+  { "close", 0 },
+};
+static_assert(sizeof(kFrameProperties) / sizeof(FramePropertyInfo) == kFramePropertiesCount,
+              "Every FrameProperty needs an entry in kFrameProperties!");
+
+// a power of two, so the slot is a mask instead of a division.
+constexpr size_t kSlotsCount = 64;
+constexpr uint8_t kEmptySlot = 0xFF;
+
+constexpr uint32_t hashName(std::string_view name) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+struct SlotTable {
+  std::array<uint8_t, kSlotsCount> slots {};
+  bool hasCollisions = false;
+};
+
+constexpr SlotTable createSlotTable() {
+  SlotTable table;
+  for (auto& slot : table.slots) {
+    slot = kEmptySlot;
+  }
+  for (size_t i = 0; i < kFramePropertiesCount; i++) {
+    auto& slot = table.slots[hashName(kFrameProperties[i].name) & (kSlotsCount - 1)];
+    if (slot != kEmptySlot) {
+      table.hasCollisions = true;
+    }
+    slot = static_cast<uint8_t>(i);
+  }
+  return table;
+}
+
+// built at compile time, every property has a slot of its own.
+constexpr auto kSlotTable = createSlotTable();
+static_assert(!kSlotTable.hasCollisions, "Two Frame properties have the same hash slot, kSlotsCount or the hash has to change!");
+
+} // namespace
+
+const char* getFramePropertyName(FrameProperty property) {
+  // all names are string literals, so they are null-terminated.
+  return kFrameProperties[static_cast<size_t>(property)].name.data();
+}
+
+int getFramePropertyArgumentsCount(FrameProperty property) {
+  return kFrameProperties[static_cast<size_t>(property)].argumentsCount;
+}
+
+FrameProperty findFrameProperty(std::string_view name) {
+  auto slot = kSlotTable.slots[hashName(name) & (kSlotsCount - 1)];
+  if (slot == kEmptySlot || kFrameProperties[slot].name != name) {
+    return FrameProperty::Count;
+  }
+  return static_cast<FrameProperty>(slot);
+}
+
+} // namespace vision
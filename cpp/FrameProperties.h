@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace vision {
+
+/**
+ * All properties a Frame exposes to JS.
+ */
+enum class FrameProperty {
+  Width,
+  Height,
+  IsValid,
+  BytesPerRow,
+  PlanesCount,
+  GetPlane,
+  ToArrayBuffer,
+  ToRGB,
+  ToTensor,
+  Crop,
+  GetLumaStatistics,
+  ToString,
+  IncrementRefCount,
+  DecrementRefCount,
+  Close,
+  // not a property, marks the amount of properties.
+  Count,
+};
+
+constexpr size_t kFramePropertiesCount = static_cast<size_t>(FrameProperty::Count);
+
+/**
+ * The JS name of a Frame property, e.g. `"width"`.
+ */
+const char* getFramePropertyName(FrameProperty property);
+/**
+ * The amount of arguments if the property is a method, or -1 if it is a plain value.
+ */
+int getFramePropertyArgumentsCount(FrameProperty property);
+
+/**
+ * Finds the Frame property with the given name through a perfect-hash table: one hash of the name and at most one
+ * string compare, no matter how many properties a Frame has. Returns FrameProperty::Count if the name is unknown.
+ * For callers that only have the name as a string, JSI property accesses go through FramePropertyCache::resolve().
+ */
+FrameProperty findFrameProperty(std::string_view name);
+
+} // namespace vision
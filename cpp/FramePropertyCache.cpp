@@ -0,0 +1,86 @@
+#include "FramePropertyCache.h"
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FrameHostObjectBase.h"
+#include "RuntimeCache.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+constexpr auto kCacheGlobalName = "__visionCameraFramePropertyCache";
+
+} // namespace
+
+std::shared_ptr<FramePropertyCache> FramePropertyCache::forRuntime(jsi::Runtime& runtime) {
+  return RuntimeCache<FramePropertyCache>::get(runtime, kCacheGlobalName, [&]() { return std::make_shared<FramePropertyCache>(runtime); });
+}
+
+FramePropertyCache::FramePropertyCache(jsi::Runtime& runtime) {
+  names_.reserve(kPropertiesCount);
+  for (size_t i = 0; i < kPropertiesCount; i++) {
+    auto property = static_cast<FrameProperty>(i);
+    auto name = getFramePropertyName(property);
+    names_.push_back(jsi::PropNameID::forAscii(runtime, name));
+    auto argumentsCount = getFramePropertyArgumentsCount(property);
+    if (argumentsCount < 0) {
+      continue;
+    }
+
+    auto method = [property, name](jsi::Runtime& runtime,
+                                   const jsi::Value& thisValue,
+                                   const jsi::Value* arguments,
+                                   size_t count) -> jsi::Value {
+      std::shared_ptr<FrameHostObjectBase> frameHostObject;
+      if (thisValue.isObject()) {
+        auto object = thisValue.getObject(runtime);
+        if (object.isHostObject(runtime)) {
+          frameHostObject = std::dynamic_pointer_cast<FrameHostObjectBase>(object.getHostObject(runtime));
+        }
+      }
+      if (frameHostObject == nullptr) {
+        auto message = std::string("Frame.") + name + "() must be called on a Frame!";
+        throw jsi::JSError(runtime, message.c_str());
+      }
+      return frameHostObject->invoke(runtime, property, arguments, count);
+    };
+    functions_[i] = jsi::Function::createFromHostFunction(runtime, names_.back(), argumentsCount, method);
+  }
+}
+
+FrameProperty FramePropertyCache::resolve(jsi::Runtime& runtime, const jsi::PropNameID& name) const {
+  // the Runtime interns PropNameIDs, so this compares identities (e.g. symbol IDs in Hermes) without creating a string per access.
+  // Properties are in the order of FrameProperty, the most frequently accessed ones (width, height) come first.
+  for (size_t i = 0; i < kPropertiesCount; i++) {
+    if (jsi::PropNameID::compare(runtime, names_[i], name)) {
+      return static_cast<FrameProperty>(i);
+    }
+  }
+  return FrameProperty::Count;
+}
+
+jsi::Value FramePropertyCache::getFunction(jsi::Runtime& runtime, FrameProperty property) const {
+  const auto& function = functions_[static_cast<size_t>(property)];
+  if (!function.has_value()) {
+    return jsi::Value::undefined();
+  }
+  return jsi::Value(runtime, *function);
+}
+
+std::vector<jsi::PropNameID> FramePropertyCache::getPropertyNames(jsi::Runtime& runtime) const {
+  std::vector<jsi::PropNameID> result;
+  result.reserve(names_.size());
+  for (const auto& name : names_) {
+    result.push_back(jsi::PropNameID(runtime, name));
+  }
+  return result;
+}
+
+} // namespace vision
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "FrameProperties.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Caches everything a Frame HostObject needs to resolve property accesses in a single jsi::Runtime:
+ * the interned jsi::PropNameIDs of all Frame properties, and the jsi::Functions of all Frame methods.
+ *
+ * Methods are created once per Runtime instead of once per property access, so they must not capture the Frame -
+ * they resolve the Frame from the `this` value they are called with instead.
+ *
+ * The cache is owned by the Runtime it was created for (it's stored in a hidden global), so it is destroyed with the Runtime.
+ */
+class FramePropertyCache : public jsi::HostObject {
+ public:
+  static constexpr size_t kPropertiesCount = kFramePropertiesCount;
+
+  /**
+   * Get the cache for the given Runtime, or create it if this is the first Frame in that Runtime.
+   */
+  static std::shared_ptr<FramePropertyCache> forRuntime(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+  explicit FramePropertyCache(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+  /**
+   * Resolves the given PropNameID to a FrameProperty by comparing it with the interned names, without converting it to a string.
+   * Returns FrameProperty::Count if the property is unknown.
+   */
+  FrameProperty resolve(jsi::Runtime& runtime, const jsi::PropNameID& name) const; // NOLINT(runtime/references)
+  /**
+   * Get the cached jsi::Function for a Frame method (e.g. `close`), or `undefined` if the property is not a method.
+   */
+  jsi::Value getFunction(jsi::Runtime& runtime, FrameProperty property) const; // NOLINT(runtime/references)
+  /**
+   * Get copies of all interned property names.
+   */
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& runtime) const; // NOLINT(runtime/references)
+
+ private:
+  std::vector<jsi::PropNameID> names_;
+  std::array<std::optional<jsi::Function>, kPropertiesCount> functions_;
+};
+
+} // namespace vision
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace vision {
+
+/**
+ * What the FrameQueue does when a new Frame arrives while it is full.
+ */
+enum class FrameDropPolicy {
+  // drop the oldest queued Frame to make room for the new one
+  DropOldest,
+  // drop the new Frame
+  DropNewest,
+  // drop all queued Frames, so the consumer always gets the most recent Frame (lowest latency)
+  KeepLatest,
+  // wait for the consumer to make room, and drop the new Frame if that takes longer than the timeout
+  BlockWithTimeout,
+};
+
+struct FrameQueueConfig {
+  size_t depth = 1;
+  FrameDropPolicy policy = FrameDropPolicy::KeepLatest;
+  std::chrono::milliseconds timeout = std::chrono::milliseconds(100);
+};
+
+struct FrameQueueStats {
+  uint64_t enqueued = 0;
+  uint64_t dropped = 0;
+  uint64_t processed = 0;
+};
+
+/**
+ * A bounded, lock-free single-producer/single-consumer queue of Frames between the Camera thread
+ * and the Frame Processor thread.
+ *
+ * Every slot is an atomic pointer. The consumer claims the oldest slot by advancing `head_` with a CAS, which lets the
+ * producer drop the oldest Frame (DropOldest, KeepLatest) by claiming it the same way without ever taking a lock.
+ * The producer is the only one advancing `tail_`.
+ *
+ * A mutex is only used to park a thread that has to wait (an empty queue, or a full queue with BlockWithTimeout),
+ * pushing and popping never lock.
+ *
+ * Dropped Frames are handed to the `onDrop` callback on the producer's thread so they can be closed there.
+ */
+template <typename T>
+class FrameQueue {
+ public:
+  explicit FrameQueue(const FrameQueueConfig& config):
+    config_(config),
+    capacity_(std::max<size_t>(config.depth, 1)),
+    slots_(new std::atomic<T*>[capacity_]) {
+    for (size_t i = 0; i < capacity_; i++) {
+      slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ~FrameQueue() {
+    // Frames should have been drained by the owner (so they can be closed properly), delete whatever is left.
+    drain([](std::unique_ptr<T>) { });
+  }
+
+  FrameQueue(const FrameQueue&) = delete;
+  FrameQueue& operator=(const FrameQueue&) = delete;
+
+  /**
+   * Enqueues a Frame. Must only be called from the producer thread.
+   * Returns false if the Frame itself was dropped.
+   */
+  template <typename OnDrop>
+  bool push(std::unique_ptr<T> item, OnDrop&& onDrop) {
+    if (closed_.load(std::memory_order_acquire)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      onDrop(std::move(item));
+      return false;
+    }
+
+    if (config_.policy == FrameDropPolicy::KeepLatest) {
+      // the new Frame supersedes everything that is still waiting
+      while (auto stale = claimOldest()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        onDrop(std::move(stale));
+      }
+    }
+
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    while (tail - head_.load(std::memory_order_acquire) >= capacity_) {
+      switch (config_.policy) {
+        case FrameDropPolicy::DropNewest:
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          onDrop(std::move(item));
+          return false;
+        case FrameDropPolicy::BlockWithTimeout: {
+          auto deadline = std::chrono::steady_clock::now() + config_.timeout;
+          bool hasSpace = waitUntil(deadline, [&]() {
+            return tail - head_.load(std::memory_order_acquire) < capacity_ || closed_.load(std::memory_order_acquire);
+          });
+          if (!hasSpace || closed_.load(std::memory_order_acquire)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            onDrop(std::move(item));
+            return false;
+          }
+          break;
+        }
+        case FrameDropPolicy::DropOldest:
+        case FrameDropPolicy::KeepLatest:
+        default: {
+          // the consumer might have claimed it in the meantime, then there is space now anyways.
+          auto oldest = claimOldest();
+          if (oldest != nullptr) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            onDrop(std::move(oldest));
+          }
+          break;
+        }
+      }
+    }
+
+    slots_[tail % capacity_].store(item.release(), std::memory_order_relaxed);
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    notify();
+    return true;
+  }
+
+  /**
+   * Dequeues the oldest Frame, waiting up to `timeout` for one to arrive. Must only be called from the consumer thread.
+   * Returns nullptr if no Frame arrived in time, or if the queue has been closed.
+   */
+  std::unique_ptr<T> pop(std::chrono::milliseconds timeout) {
+    auto item = claimOldest();
+    if (item == nullptr) {
+      auto deadline = std::chrono::steady_clock::now() + timeout;
+      waitUntil(deadline, [&]() {
+        return head_.load(std::memory_order_acquire) != tail_.load(std::memory_order_acquire) || closed_.load(std::memory_order_acquire);
+      });
+      item = claimOldest();
+    }
+    if (item != nullptr) {
+      processed_.fetch_add(1, std::memory_order_relaxed);
+      // a producer might be waiting for room (BlockWithTimeout)
+      notify();
+    }
+    return item;
+  }
+
+  /**
+   * Removes all queued Frames and hands them to `onDrop`.
+   */
+  template <typename OnDrop>
+  void drain(OnDrop&& onDrop) {
+    while (auto item = claimOldest()) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      onDrop(std::move(item));
+    }
+  }
+
+  /**
+   * Wakes up all waiting threads and drops every Frame pushed afterwards.
+   */
+  void close() {
+    closed_.store(true, std::memory_order_seq_cst);
+    notify();
+  }
+
+  bool isClosed() const {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Whether no Frame is waiting to be popped right now.
+   */
+  bool isEmpty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  const FrameQueueConfig& getConfig() const {
+    return config_;
+  }
+
+  FrameQueueStats getStats() const {
+    FrameQueueStats stats;
+    stats.enqueued = enqueued_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.processed = processed_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  /**
+   * Claims the oldest Frame, from either the producer or the consumer thread.
+   */
+  std::unique_ptr<T> claimOldest() {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (head != tail_.load(std::memory_order_acquire)) {
+      // the producer never writes to this slot before `head_` moved past it, so the read is stable.
+      T* item = slots_[head % capacity_].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, head + 1, std::memory_order_seq_cst, std::memory_order_acquire)) {
+        return std::unique_ptr<T>(item);
+      }
+      // the other side claimed it first, `head` now holds the new value.
+    }
+    return nullptr;
+  }
+
+  template <typename Predicate>
+  bool waitUntil(std::chrono::steady_clock::time_point deadline, Predicate&& predicate) {
+    std::unique_lock lock(mutex_);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool result = condition_.wait_until(lock, deadline, predicate);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return result;
+  }
+
+  void notify() {
+    // pairs with the increment in waitUntil(): either the waiter sees our change, or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0) {
+      std::unique_lock lock(mutex_);
+      condition_.notify_all();
+    }
+  }
+
+ private:
+  const FrameQueueConfig config_;
+  const size_t capacity_;
+  std::unique_ptr<std::atomic<T*>[]> slots_;
+  std::atomic<uint64_t> head_ { 0 };
+  std::atomic<uint64_t> tail_ { 0 };
+  std::atomic<bool> closed_ { false };
+
+  std::atomic<uint64_t> enqueued_ { 0 };
+  std::atomic<uint64_t> dropped_ { 0 };
+  std::atomic<uint64_t> processed_ { 0 };
+
+  std::atomic<int> waiters_ { 0 };
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+} // namespace vision
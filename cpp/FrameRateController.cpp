@@ -0,0 +1,165 @@
+#include "FrameRateController.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <optional>
+
+namespace vision {
+
+namespace {
+
+constexpr double kNanosecondsPerSecond = 1e9;
+// gaps longer than this are pauses (e.g. the session was stopped), not the Camera's Frame interval.
+constexpr int64_t kMaxCameraInterval = 1000000000;
+// a reported rate is only replaced by one that differs by more than this (relative)
+constexpr double kReportThreshold = 0.1;
+
+} // namespace
+
+FrameRateController::FrameRateController(const FrameRateConfig& config) {
+  configure(config);
+}
+
+void FrameRateController::configure(const FrameRateConfig& config) {
+  std::unique_lock lock(mutex_);
+  config_ = config;
+  if (config_.fixedFps <= 0) {
+    config_.fixedFps = kMinFps;
+  }
+  averageExecutionTime_ = 0;
+  executionTimeDeviation_ = 0;
+  averageLatency_ = 0;
+  adaptiveFps_ = 0;
+  reportedFps_ = 0;
+  reportedSuggestedFps_ = 0;
+  lastReport_ = std::chrono::steady_clock::time_point();
+
+  // the adaptive modes start at the Camera's rate and back off after the first Frames have been measured.
+  fps_.store(config_.mode == FrameRateMode::Fixed ? config_.fixedFps : getCameraFps(), std::memory_order_relaxed);
+  resetDeadline_.store(true, std::memory_order_release);
+}
+
+void FrameRateController::setParallelism(size_t parallelism) {
+  std::unique_lock lock(mutex_);
+  parallelism_ = static_cast<double>(std::max<size_t>(parallelism, 1));
+}
+
+double FrameRateController::getCameraFps() const {
+  auto interval = cameraInterval_.load(std::memory_order_relaxed);
+  return interval > 0 ? std::max(kNanosecondsPerSecond / interval, kMinFps) : kDefaultCameraFps;
+}
+
+bool FrameRateController::shouldProcess(int64_t timestamp) {
+  auto cameraInterval = cameraInterval_.load(std::memory_order_relaxed);
+  auto elapsed = timestamp - lastTimestamp_;
+  if (lastTimestamp_ != 0 && elapsed > 0 && elapsed < kMaxCameraInterval) {
+    cameraInterval = cameraInterval == 0 ? elapsed : cameraInterval + kSmoothing * (elapsed - cameraInterval);
+    cameraInterval_.store(cameraInterval, std::memory_order_relaxed);
+  }
+  lastTimestamp_ = timestamp;
+
+  if (resetDeadline_.load(std::memory_order_acquire) && resetDeadline_.exchange(false, std::memory_order_acq_rel)) {
+    nextDeadline_ = 0;
+  }
+
+  auto interval = static_cast<int64_t>(kNanosecondsPerSecond / fps_.load(std::memory_order_relaxed));
+  // Up to half a Camera interval early is still on time, otherwise jitter in the Camera's timestamps would skip
+  // a Frame that is due and wait for the next one - e.g. 20 FPS from a 30 FPS Camera would turn into 15 FPS.
+  auto tolerance = static_cast<int64_t>(cameraInterval / 2);
+  if (nextDeadline_ != 0 && timestamp + tolerance < nextDeadline_) {
+    return false;
+  }
+  if (nextDeadline_ == 0 || timestamp - nextDeadline_ > interval) {
+    // the first Frame, or we fell behind (e.g. the Camera paused) - don't catch up with a burst of Frames.
+    nextDeadline_ = timestamp + interval;
+  } else {
+    nextDeadline_ += interval;
+  }
+  // a raised rate applies right away instead of after the deadline that was planned with the old rate.
+  nextDeadline_ = std::min(nextDeadline_, timestamp + interval + tolerance);
+  return true;
+}
+
+double FrameRateController::getTargetFps(double cameraFps) const {
+  // with Frames processed in parallel, a new Frame can start while others are still running.
+  auto averageExecutionTime = std::max(averageExecutionTime_ / parallelism_, 1.0);
+  double target = cameraFps;
+  switch (config_.mode) {
+    case FrameRateMode::Fixed:
+    case FrameRateMode::Throughput:
+      target = kThroughputHeadroom * kNanosecondsPerSecond / averageExecutionTime;
+      break;
+    case FrameRateMode::LatencyBudget: {
+      // leave enough room that even slower Frames finish before the next one arrives, so no Frame waits in the queue.
+      target = kNanosecondsPerSecond / (averageExecutionTime + kLatencyDeviations * executionTimeDeviation_ / parallelism_);
+      auto budget = static_cast<double>(config_.latencyBudget.count());
+      if (budget > 0 && averageLatency_ > budget) {
+        // Frames still wait too long (e.g. because of the queue depth), back off further.
+        target *= std::max(0.5, budget / averageLatency_);
+      }
+      break;
+    }
+  }
+  return std::clamp(target, kMinFps, cameraFps);
+}
+
+std::optional<FrameRateDecision> FrameRateController::recordFrame(std::chrono::nanoseconds executionTime,
+                                                                  std::chrono::nanoseconds latency) {
+  std::unique_lock lock(mutex_);
+  auto sample = static_cast<double>(executionTime.count());
+  auto latencySample = static_cast<double>(latency.count());
+  if (averageExecutionTime_ == 0) {
+    averageExecutionTime_ = sample;
+    averageLatency_ = latencySample;
+  } else {
+    auto difference = sample - averageExecutionTime_;
+    averageExecutionTime_ += kSmoothing * difference;
+    executionTimeDeviation_ += kSmoothing * (std::abs(difference) - executionTimeDeviation_);
+    averageLatency_ += kSmoothing * (latencySample - averageLatency_);
+  }
+
+  auto cameraFps = getCameraFps();
+  auto target = getTargetFps(cameraFps);
+  if (adaptiveFps_ == 0) {
+    adaptiveFps_ = target;
+  } else if (std::abs(target - adaptiveFps_) > kDeadBand * adaptiveFps_) {
+    // back off right away so no backlog builds up, but only speed up gradually.
+    adaptiveFps_ = target < adaptiveFps_ ? target : std::min(target, adaptiveFps_ * (1 + kMaxIncreasePerFrame));
+  }
+  // the Camera's rate might have dropped, e.g. in low light
+  adaptiveFps_ = std::min(adaptiveFps_, cameraFps);
+
+  auto isFixed = config_.mode == FrameRateMode::Fixed;
+  auto fps = isFixed ? config_.fixedFps : adaptiveFps_;
+  fps_.store(fps, std::memory_order_relaxed);
+
+  auto now = std::chrono::steady_clock::now();
+  if (now - lastReport_ < kMinReportInterval) {
+    return std::nullopt;
+  }
+  // suggestions for a fixed rate are whole numbers, like `frameProcessorFps` values usually are.
+  auto suggestedFps = isFixed ? std::max(std::floor(adaptiveFps_), kMinFps) : fps;
+  auto hasChanged = isFixed ? suggestedFps != reportedSuggestedFps_
+                            : std::abs(fps - reportedFps_) > kReportThreshold * reportedFps_;
+  if (!hasChanged) {
+    return std::nullopt;
+  }
+
+  FrameRateDecision decision;
+  decision.mode = config_.mode;
+  decision.fps = fps;
+  decision.previousFps = reportedFps_ != 0 ? reportedFps_ : fps;
+  decision.suggestedFps = suggestedFps;
+  decision.cameraFps = cameraFps;
+  decision.averageExecutionTime = std::chrono::nanoseconds(static_cast<int64_t>(averageExecutionTime_));
+  decision.averageLatency = std::chrono::nanoseconds(static_cast<int64_t>(averageLatency_));
+
+  reportedFps_ = fps;
+  reportedSuggestedFps_ = suggestedFps;
+  lastReport_ = now;
+  return decision;
+}
+
+} // namespace vision
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace vision {
+
+enum class FrameRateMode {
+  // a fixed `frameProcessorFps`, the controller only suggests a better rate
+  Fixed,
+  // process as many Frames as possible without building up a backlog
+  Throughput,
+  // keep the time from the Camera delivering a Frame until the Frame Processor returned within a budget
+  LatencyBudget,
+};
+
+struct FrameRateConfig {
+  FrameRateMode mode = FrameRateMode::Throughput;
+  // the rate used in FrameRateMode::Fixed
+  double fixedFps = 30;
+  // the latency every Frame should stay within in FrameRateMode::LatencyBudget
+  std::chrono::nanoseconds latencyBudget = std::chrono::milliseconds(100);
+};
+
+struct FrameRateDecision {
+  FrameRateMode mode = FrameRateMode::Throughput;
+  // the rate Frames are processed at from now on
+  double fps = 0;
+  double previousFps = 0;
+  // the rate the controller would pick on its own, equal to `fps` unless the mode is FrameRateMode::Fixed
+  double suggestedFps = 0;
+  // the rate the Camera actually delivers Frames at, measured from their timestamps
+  double cameraFps = 0;
+  // exponentially weighted moving averages
+  std::chrono::nanoseconds averageExecutionTime { 0 };
+  std::chrono::nanoseconds averageLatency { 0 };
+};
+
+/**
+ * Decides which of the Camera's Frames are passed to the Frame Processor (`frameProcessorFps`), and adapts that rate
+ * to how long the Frame Processor takes.
+ *
+ * The execution time is tracked as an exponentially weighted moving average (EWMA) and deviation, so the rate follows
+ * scenes that are slower to process (e.g. more text for OCR) without reacting to single slow Frames. Lowering the rate
+ * happens right away, raising it is limited to a few percent per Frame, and changes below a dead band are ignored,
+ * so the rate does not oscillate. It never exceeds the rate the Camera actually delivers Frames at.
+ *
+ * Frames are selected by deadline: a Frame is processed if its timestamp reached the next deadline, which then moves
+ * one interval ahead. This keeps the spacing even, instead of drifting towards the Camera's own Frame intervals.
+ *
+ * shouldProcess() must only be called from a single thread (the Camera thread). recordFrame() is called by the Frame Processor
+ * thread(s), configure() and setParallelism() can be called from any thread.
+ */
+class FrameRateController {
+ public:
+  // the weight of a new sample in the moving averages
+  static constexpr double kSmoothing = 0.1;
+  // in FrameRateMode::Throughput, the share of a Frame interval the Frame Processor may use, the rest absorbs jitter.
+  static constexpr double kThroughputHeadroom = 0.9;
+  // in FrameRateMode::LatencyBudget, how many deviations above the average execution time to plan for.
+  static constexpr double kLatencyDeviations = 2;
+  // raising the rate is limited to this much per processed Frame
+  static constexpr double kMaxIncreasePerFrame = 0.05;
+  // changes smaller than this (relative to the current rate) are ignored
+  static constexpr double kDeadBand = 0.05;
+  static constexpr double kMinFps = 1;
+  // used until the Camera delivered enough Frames to measure its rate
+  static constexpr double kDefaultCameraFps = 30;
+  static constexpr std::chrono::milliseconds kMinReportInterval { 1000 };
+
+  explicit FrameRateController(const FrameRateConfig& config = FrameRateConfig());
+
+  /**
+   * Changes the mode, and starts estimating from scratch.
+   */
+  void configure(const FrameRateConfig& config);
+  /**
+   * Sets how many Frames are processed at the same time (one per worklet runtime), which multiplies the rate the
+   * Frame Processor can sustain.
+   */
+  void setParallelism(size_t parallelism);
+
+  /**
+   * Returns whether the Frame with the given `timestamp` (nanoseconds, in the Camera's clock) should be processed.
+   * Every Frame the Camera delivered must be passed here, skipped ones too, so the Camera's rate can be measured.
+   */
+  bool shouldProcess(int64_t timestamp);
+
+  /**
+   * Feeds how long the Frame Processor took for a Frame, and how long that Frame waited before (latency includes the execution time).
+   * Returns a decision if the rate changed enough to be worth reporting (at most once per kMinReportInterval).
+   */
+  std::optional<FrameRateDecision> recordFrame(std::chrono::nanoseconds executionTime, std::chrono::nanoseconds latency);
+
+  double getFps() const { return fps_.load(std::memory_order_relaxed); }
+  double getCameraFps() const;
+
+ private:
+  double getTargetFps(double cameraFps) const;
+
+ private:
+  mutable std::mutex mutex_;
+  FrameRateConfig config_;
+  // the moving averages, in nanoseconds. Guarded by mutex_.
+  double averageExecutionTime_ = 0;
+  double executionTimeDeviation_ = 0;
+  double averageLatency_ = 0;
+  // the adapted rate, before FrameRateMode::Fixed overrides it. Guarded by mutex_.
+  double adaptiveFps_ = 0;
+  double reportedFps_ = 0;
+  double reportedSuggestedFps_ = 0;
+  // Frames processed at the same time. Guarded by mutex_.
+  double parallelism_ = 1;
+  std::chrono::steady_clock::time_point lastReport_;
+
+  std::atomic<double> fps_ { kDefaultCameraFps };
+  // the Camera's Frame interval (nanoseconds), 0 until it has been measured
+  std::atomic<double> cameraInterval_ { 0 };
+  // written by configure() to start with a fresh deadline
+  std::atomic<bool> resetDeadline_ { true };
+  // Camera thread only
+  int64_t lastTimestamp_ = 0;
+  int64_t nextDeadline_ = 0;
+};
+
+} // namespace vision
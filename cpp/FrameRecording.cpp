@@ -0,0 +1,331 @@
+#include "FrameRecording.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace vision {
+
+namespace {
+
+// The file format. All fields are in the native byte order, which is little-endian on every platform we run on.
+constexpr char kFileMagic[8] = { 'V', 'C', 'F', 'R', 'A', 'M', 'E', 'S' };
+constexpr uint32_t kFileVersion = 1;
+constexpr uint32_t kRecordMagic = 0x4D415246; // "FRAM"
+// records and planes start at multiples of this, so replayed planes are as aligned as the Camera's.
+constexpr size_t kAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint8_t reserved[kAlignment - 16];
+};
+static_assert(sizeof(FileHeader) == kAlignment, "The file header must be exactly one alignment unit");
+
+struct RecordedPlane {
+  // relative to the start of the record
+  uint64_t offset;
+  uint64_t size;
+  int32_t rowStride;
+  int32_t pixelStride;
+};
+
+struct RecordHeader {
+  uint32_t magic;
+  uint32_t planesCount;
+  // including this header, the planes and the padding
+  uint64_t recordSize;
+  int64_t timestamp;
+  int32_t width;
+  int32_t height;
+  uint32_t pixelFormat;
+  uint32_t colorRange;
+  RecordedPlane planes[FrameDescriptor::kMaxPlanes];
+};
+
+constexpr size_t align(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+std::string describeError(const std::string& message, const std::string& path) {
+  return message + " \"" + path + "\": " + std::strerror(errno);
+}
+
+bool writeFully(int fd, const void* data, size_t size) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    auto written = ::write(fd, bytes, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+} // namespace
+
+// FrameRecorder
+
+FrameRecorder::FrameRecorder(const std::string& path):
+  fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+  queue_(FrameQueueConfig { kMaxPendingFrames, FrameDropPolicy::DropNewest }) {
+  if (fd_ < 0) {
+    throw std::runtime_error(describeError("Failed to create Frame recording", path));
+  }
+
+  FileHeader header = {};
+  std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+  header.version = kFileVersion;
+  header.headerSize = sizeof(FileHeader);
+  if (!writeFully(fd_, &header, sizeof(header))) {
+    auto message = describeError("Failed to write Frame recording", path);
+    ::close(fd_);
+    throw std::runtime_error(message);
+  }
+  bytesWritten_.store(sizeof(header), std::memory_order_relaxed);
+
+  writer_ = std::thread([this]() { runWriter(); });
+}
+
+FrameRecorder::~FrameRecorder() {
+  stop();
+}
+
+bool FrameRecorder::record(const FrameDescriptor& frame) {
+  if (!frame.isValid || queue_.isClosed()) {
+    return false;
+  }
+
+  // the planes are copied back-to-back, and re-described to point into the copy.
+  size_t totalSize = 0;
+  for (size_t i = 0; i < frame.planesCount; i++) {
+    totalSize += frame.planes[i].size;
+  }
+  auto pending = std::make_unique<PendingFrame>();
+  pending->descriptor = frame;
+  pending->buffer = BufferPool::shared()->acquire(totalSize);
+  size_t offset = 0;
+  for (size_t i = 0; i < frame.planesCount; i++) {
+    std::memcpy(pending->buffer->data() + offset, frame.planes[i].data, frame.planes[i].size);
+    pending->descriptor.planes[i].data = pending->buffer->data() + offset;
+    offset += frame.planes[i].size;
+  }
+
+  return queue_.push(std::move(pending), [this](std::unique_ptr<PendingFrame>) {
+    framesDropped_.fetch_add(1, std::memory_order_relaxed);
+  });
+}
+
+void FrameRecorder::runWriter() {
+  while (!queue_.isClosed()) {
+    auto frame = queue_.pop(std::chrono::milliseconds(100));
+    if (frame != nullptr) {
+      write(*frame);
+    }
+  }
+}
+
+void FrameRecorder::write(const PendingFrame& frame) {
+  const auto& descriptor = frame.descriptor;
+
+  RecordHeader header = {};
+  header.magic = kRecordMagic;
+  header.planesCount = static_cast<uint32_t>(descriptor.planesCount);
+  header.timestamp = descriptor.timestamp;
+  header.width = descriptor.width;
+  header.height = descriptor.height;
+  header.pixelFormat = static_cast<uint32_t>(descriptor.pixelFormat);
+  header.colorRange = static_cast<uint32_t>(descriptor.colorRange);
+  size_t offset = align(sizeof(RecordHeader));
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    header.planes[i].offset = offset;
+    header.planes[i].size = descriptor.planes[i].size;
+    header.planes[i].rowStride = descriptor.planes[i].rowStride;
+    header.planes[i].pixelStride = descriptor.planes[i].pixelStride;
+    offset += align(descriptor.planes[i].size);
+  }
+  header.recordSize = offset;
+
+  static const uint8_t padding[kAlignment] = {};
+  bool success = writeFully(fd_, &header, sizeof(header)) &&
+                 writeFully(fd_, padding, align(sizeof(header)) - sizeof(header));
+  for (size_t i = 0; i < descriptor.planesCount && success; i++) {
+    const auto& plane = descriptor.planes[i];
+    success = writeFully(fd_, plane.data, plane.size) && writeFully(fd_, padding, align(plane.size) - plane.size);
+  }
+
+  if (success) {
+    framesRecorded_.fetch_add(1, std::memory_order_relaxed);
+    bytesWritten_.fetch_add(header.recordSize, std::memory_order_relaxed);
+  } else {
+    // e.g. the disk is full. The partially written record is skipped when the recording is opened.
+    framesDropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void FrameRecorder::stop() {
+  std::unique_lock lock(stopMutex_);
+  if (isStopped_) {
+    return;
+  }
+  isStopped_ = true;
+
+  queue_.close();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  // write the Frames that were still queued
+  queue_.drain([this](std::unique_ptr<PendingFrame> frame) { write(*frame); });
+  ::close(fd_);
+}
+
+FrameRecorderStats FrameRecorder::getStats() const {
+  FrameRecorderStats stats;
+  stats.framesRecorded = framesRecorded_.load(std::memory_order_relaxed);
+  stats.framesDropped = framesDropped_.load(std::memory_order_relaxed);
+  stats.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// FrameRecording
+
+std::shared_ptr<FrameRecording> FrameRecording::open(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error(describeError("Failed to open Frame recording", path));
+  }
+  struct stat info = {};
+  if (::fstat(fd, &info) != 0) {
+    auto message = describeError("Failed to open Frame recording", path);
+    ::close(fd);
+    throw std::runtime_error(message);
+  }
+  auto size = static_cast<size_t>(info.st_size);
+  if (size < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("\"" + path + "\" is not a Frame recording!");
+  }
+
+  // private, so writes into the planes stay in memory. The mapping keeps the file alive after closing it.
+  void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    auto message = describeError("Failed to map Frame recording", path);
+    ::close(fd);
+    throw std::runtime_error(message);
+  }
+  ::close(fd);
+
+  const auto* header = static_cast<const FileHeader*>(data);
+  if (std::memcmp(header->magic, kFileMagic, sizeof(kFileMagic)) != 0 || header->version != kFileVersion) {
+    ::munmap(data, size);
+    throw std::runtime_error("\"" + path + "\" is not a Frame recording, or it was recorded by an incompatible version!");
+  }
+  return std::shared_ptr<FrameRecording>(new FrameRecording(static_cast<uint8_t*>(data), size));
+}
+
+FrameRecording::FrameRecording(uint8_t* data, size_t size): data_(data), size_(size) {
+  const auto* fileHeader = reinterpret_cast<const FileHeader*>(data_);
+  size_t offset = fileHeader->headerSize;
+  while (offset + sizeof(RecordHeader) <= size_) {
+    const auto* header = reinterpret_cast<const RecordHeader*>(data_ + offset);
+    if (header->magic != kRecordMagic || header->recordSize < sizeof(RecordHeader) || header->recordSize > size_ - offset ||
+        header->planesCount > FrameDescriptor::kMaxPlanes) {
+      // a record that was cut off while it was written
+      break;
+    }
+    offsets_.push_back(offset);
+    offset += header->recordSize;
+  }
+}
+
+FrameRecording::~FrameRecording() {
+  ::munmap(data_, size_);
+}
+
+FrameDescriptor FrameRecording::getFrame(size_t index) const {
+  if (index >= offsets_.size()) {
+    throw std::out_of_range("Frame " + std::to_string(index) + " is out of bounds, the recording only has " +
+                            std::to_string(offsets_.size()) + " Frames!");
+  }
+  auto* record = data_ + offsets_[index];
+  const auto* header = reinterpret_cast<const RecordHeader*>(record);
+
+  FrameDescriptor descriptor;
+  descriptor.width = header->width;
+  descriptor.height = header->height;
+  descriptor.pixelFormat = static_cast<PixelFormat>(header->pixelFormat);
+  descriptor.colorRange = static_cast<ColorRange>(header->colorRange);
+  descriptor.timestamp = header->timestamp;
+  descriptor.planesCount = header->planesCount;
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    const auto& plane = header->planes[i];
+    descriptor.planes[i].data = record + plane.offset;
+    descriptor.planes[i].size = static_cast<size_t>(plane.size);
+    descriptor.planes[i].rowStride = plane.rowStride;
+    descriptor.planes[i].pixelStride = plane.pixelStride;
+  }
+  descriptor.isValid = true;
+  return descriptor;
+}
+
+// FrameReplay
+
+FrameReplay::FrameReplay(std::shared_ptr<FrameRecording> recording, const FrameReplayOptions& options):
+  recording_(std::move(recording)), options_(options) { }
+
+void FrameReplay::run(const TOnFrame& onFrame) {
+  auto count = recording_->size();
+  if (count == 0) {
+    return;
+  }
+  auto firstTimestamp = recording_->getFrame(0).timestamp;
+  auto lastTimestamp = recording_->getFrame(count - 1).timestamp;
+  // one loop lasts as long as the recording plus one average Frame interval, so the last and the first Frame don't overlap.
+  auto loopDuration = (lastTimestamp - firstTimestamp) + (count > 1 ? (lastTimestamp - firstTimestamp) / static_cast<int64_t>(count - 1) : 0);
+
+  auto startedAt = std::chrono::steady_clock::now();
+  int64_t loopOffset = 0;
+  do {
+    for (size_t i = 0; i < count; i++) {
+      auto frame = recording_->getFrame(i);
+      frame.timestamp += loopOffset;
+
+      if (options_.speed == ReplaySpeed::Recorded) {
+        auto deliverAt = startedAt + std::chrono::nanoseconds(frame.timestamp - firstTimestamp);
+        std::unique_lock lock(mutex_);
+        condition_.wait_until(lock, deliverAt, [this]() { return isStopped(); });
+      }
+      if (isStopped()) {
+        return;
+      }
+      onFrame(frame);
+    }
+    loopOffset += loopDuration;
+  } while (options_.loop && !isStopped());
+}
+
+void FrameReplay::stop() {
+  {
+    std::unique_lock lock(mutex_);
+    isStopped_.store(true, std::memory_order_release);
+  }
+  condition_.notify_all();
+}
+
+} // namespace vision
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BufferPool.h"
+#include "FrameDescriptor.h"
+#include "FrameQueue.h"
+
+namespace vision {
+
+struct FrameRecorderStats {
+  uint64_t framesRecorded = 0;
+  // Frames that arrived while the writer was still busy with previous Frames
+  uint64_t framesDropped = 0;
+  uint64_t bytesWritten = 0;
+};
+
+/**
+ * Records raw Frames (planes, strides, pixel format and timestamps) into an append-only file, so they can be replayed
+ * through the Frame Processor pipeline later with a FrameRecording and FrameReplay - on the device or on a desktop machine.
+ *
+ * The Camera thread only copies the planes into a pooled buffer, the file is written on a separate thread.
+ * If the writer falls behind by more than kMaxPendingFrames, new Frames are dropped instead of stalling the Camera.
+ *
+ * The file starts with a header, followed by one record per Frame. A record that was not fully written
+ * (e.g. because the app crashed) is ignored when the recording is opened.
+ */
+class FrameRecorder {
+ public:
+  static constexpr size_t kMaxPendingFrames = 8;
+
+  /**
+   * Creates the file at `path` (or truncates it), and starts the writer thread.
+   * Throws a std::runtime_error if the file can not be created.
+   */
+  explicit FrameRecorder(const std::string& path);
+  ~FrameRecorder();
+
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  /**
+   * Copies the Frame and queues it to be written. Returns false if the Frame was dropped.
+   * Must only be called from a single thread (the Camera thread).
+   */
+  bool record(const FrameDescriptor& frame);
+  /**
+   * Writes all queued Frames and closes the file. Frames recorded afterwards are dropped.
+   */
+  void stop();
+
+  FrameRecorderStats getStats() const;
+
+ private:
+  struct PendingFrame {
+    FrameDescriptor descriptor;
+    std::unique_ptr<PooledBuffer> buffer;
+  };
+
+  void runWriter();
+  void write(const PendingFrame& frame);
+
+ private:
+  int fd_;
+  FrameQueue<PendingFrame> queue_;
+  std::thread writer_;
+  std::mutex stopMutex_;
+  bool isStopped_ = false;
+
+  std::atomic<uint64_t> framesRecorded_ { 0 };
+  std::atomic<uint64_t> framesDropped_ { 0 };
+  std::atomic<uint64_t> bytesWritten_ { 0 };
+};
+
+/**
+ * A recording made by the FrameRecorder, memory-mapped so Frames are read without copying them.
+ *
+ * The mapping is private (copy-on-write), so Frame Processors may write into the planes without modifying the file.
+ */
+class FrameRecording {
+ public:
+  /**
+   * Maps the recording at `path`. Throws a std::runtime_error if it can not be opened or is not a Frame recording.
+   */
+  static std::shared_ptr<FrameRecording> open(const std::string& path);
+  ~FrameRecording();
+
+  FrameRecording(const FrameRecording&) = delete;
+  FrameRecording& operator=(const FrameRecording&) = delete;
+
+  size_t size() const { return offsets_.size(); }
+  /**
+   * Describes the Frame at `index`. Its planes point into the mapping, so they are valid as long as this FrameRecording is alive.
+   */
+  FrameDescriptor getFrame(size_t index) const;
+
+ private:
+  FrameRecording(uint8_t* data, size_t size);
+
+ private:
+  uint8_t* data_;
+  size_t size_;
+  // the offset of every complete record in the file
+  std::vector<size_t> offsets_;
+};
+
+enum class ReplaySpeed {
+  // keeps the intervals between the recorded timestamps, like the Camera delivered them
+  Recorded,
+  // delivers the next Frame as soon as the previous one has been handed off
+  Maximum,
+};
+
+struct FrameReplayOptions {
+  ReplaySpeed speed = ReplaySpeed::Recorded;
+  // starts over after the last Frame until stop() is called
+  bool loop = false;
+};
+
+/**
+ * Feeds the Frames of a FrameRecording to a callback in order, as if they came from the Camera.
+ *
+ * With ReplaySpeed::Maximum the next Frame is delivered as soon as `onFrame` returns, so `onFrame` applies back-pressure
+ * by blocking until the pipeline can take another Frame. When looping, timestamps keep increasing across iterations.
+ */
+class FrameReplay {
+ public:
+  using TOnFrame = std::function<void(const FrameDescriptor& frame)>;
+
+  FrameReplay(std::shared_ptr<FrameRecording> recording, const FrameReplayOptions& options);
+
+  /**
+   * Replays the recording on the calling thread, and returns once all Frames have been delivered or stop() was called.
+   */
+  void run(const TOnFrame& onFrame);
+  /**
+   * Makes run() return before delivering the next Frame. Can be called from any thread.
+   */
+  void stop();
+  bool isStopped() const { return isStopped_.load(std::memory_order_acquire); }
+
+  const std::shared_ptr<FrameRecording>& getRecording() const { return recording_; }
+  const FrameReplayOptions& getOptions() const { return options_; }
+
+ private:
+  std::shared_ptr<FrameRecording> recording_;
+  FrameReplayOptions options_;
+
+  std::atomic<bool> isStopped_ { false };
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+} // namespace vision
@@ -0,0 +1,19 @@
+#include "FrameRetentionBudget.h"
+
+namespace vision {
+
+bool FrameRetentionBudget::tryAcquire() {
+  size_t retainedFrames = retainedFrames_.load(std::memory_order_relaxed);
+  do {
+    if (retainedFrames >= maxRetainedFrames_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+  } while (!retainedFrames_.compare_exchange_weak(retainedFrames, retainedFrames + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+  return true;
+}
+
+void FrameRetentionBudget::release() {
+  retainedFrames_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace vision
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace vision {
+
+/**
+ * Limits how many of a Camera's Frames can be retained past their Frame Processor call at the same time.
+ *
+ * The Camera reserves `frameProcessorMaxRetainedFrames` buffers of its image queue for retained Frames. A Frame takes
+ * one of them the first time it is retained (`incrementRefCount()` or a zero-copy ArrayBuffer), and gives it back once it is closed.
+ * Once all of them are taken, retaining another Frame would hold a buffer the Camera needs to keep delivering Frames.
+ */
+class FrameRetentionBudget {
+ public:
+  explicit FrameRetentionBudget(size_t maxRetainedFrames = 0): maxRetainedFrames_(maxRetainedFrames) { }
+
+  /**
+   * Takes one slot for a Frame that is being retained, returns false if all slots are taken.
+   */
+  bool tryAcquire();
+  /**
+   * Gives back the slot of a retained Frame that has been closed.
+   */
+  void release();
+
+  /**
+   * Changes the amount of slots. Frames that are retained already keep their slots, even if there are more of them now.
+   */
+  void setMaxRetainedFrames(size_t maxRetainedFrames) { maxRetainedFrames_.store(maxRetainedFrames, std::memory_order_relaxed); }
+  size_t getMaxRetainedFrames() const { return maxRetainedFrames_.load(std::memory_order_relaxed); }
+  size_t getRetainedFrames() const { return retainedFrames_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> maxRetainedFrames_;
+  std::atomic<size_t> retainedFrames_ { 0 };
+};
+
+} // namespace vision
@@ -0,0 +1,79 @@
+#include "FrameRetentionMonitor.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace vision {
+
+FrameRetentionMonitor& FrameRetentionMonitor::shared() {
+  // never destroyed, Frames might still be released while static destructors run.
+  static auto monitor = new FrameRetentionMonitor();
+  return *monitor;
+}
+
+FrameRetentionMonitor::Token FrameRetentionMonitor::track(int64_t timestamp) {
+  std::unique_lock lock(mutex_);
+  auto token = nextToken_++;
+  entries_.emplace(token, Entry { timestamp, std::chrono::steady_clock::now(), false });
+  return token;
+}
+
+void FrameRetentionMonitor::untrack(Token token) {
+  std::unique_lock lock(mutex_);
+  entries_.erase(token);
+}
+
+void FrameRetentionMonitor::check() {
+  std::vector<FrameRetentionReport> reports;
+  std::shared_ptr<Listener> listener;
+  {
+    std::unique_lock lock(mutex_);
+    if (listener_ == nullptr || entries_.empty()) {
+      return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (auto& [token, entry] : entries_) {
+      auto heldFor = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.acquiredAt);
+      if (entry.isReported || heldFor < deadline_) {
+        continue;
+      }
+      entry.isReported = true;
+      FrameRetentionReport report;
+      report.timestamp = entry.timestamp;
+      report.heldFor = heldFor;
+      report.framesHeld = entries_.size();
+      reports.push_back(report);
+    }
+    listener = listener_;
+  }
+
+  // the listener might log or call into the platform, so don't hold the lock while calling it.
+  for (const auto& report : reports) {
+    (*listener)(report);
+  }
+}
+
+void FrameRetentionMonitor::setDeadline(std::chrono::milliseconds deadline) {
+  std::unique_lock lock(mutex_);
+  deadline_ = deadline;
+}
+
+std::chrono::milliseconds FrameRetentionMonitor::getDeadline() const {
+  std::unique_lock lock(mutex_);
+  return deadline_;
+}
+
+void FrameRetentionMonitor::setListener(Listener listener) {
+  std::unique_lock lock(mutex_);
+  listener_ = listener != nullptr ? std::make_shared<Listener>(std::move(listener)) : nullptr;
+}
+
+size_t FrameRetentionMonitor::getFramesHeld() const {
+  std::unique_lock lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace vision
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace vision {
+
+struct FrameRetentionReport {
+  // the Frame's presentation timestamp, in nanoseconds
+  int64_t timestamp = 0;
+  // how long the Frame has been held so far
+  std::chrono::milliseconds heldFor { 0 };
+  // the amount of Frames that are currently held, including this one
+  size_t framesHeld = 0;
+};
+
+/**
+ * Keeps track of all Frames that have not been released yet, and reports every Frame that is held for longer than the deadline.
+ *
+ * Camera pipelines only have a few buffers, so a Frame that is retained (`incrementRefCount()`) and never released
+ * will eventually stall the Camera. Every Frame is reported at most once.
+ */
+class FrameRetentionMonitor {
+ public:
+  using Listener = std::function<void(const FrameRetentionReport& report)>;
+  using Token = uint64_t;
+
+  /**
+   * Get the monitor shared by all Frames.
+   */
+  static FrameRetentionMonitor& shared();
+
+  /**
+   * Starts tracking a Frame that has just been acquired from the Camera.
+   */
+  Token track(int64_t timestamp);
+  /**
+   * Stops tracking a Frame, because it has been released.
+   */
+  void untrack(Token token);
+
+  /**
+   * Reports all Frames that are held past the deadline and have not been reported yet.
+   * Called periodically by the Frame Processor threads, the listener is invoked on the calling thread.
+   */
+  void check();
+
+  void setDeadline(std::chrono::milliseconds deadline);
+  std::chrono::milliseconds getDeadline() const;
+  /**
+   * Sets the instrumentation hook that is called for every Frame held past the deadline. Pass `nullptr` to disable reporting.
+   */
+  void setListener(Listener listener);
+
+  size_t getFramesHeld() const;
+
+ private:
+  struct Entry {
+    int64_t timestamp;
+    std::chrono::steady_clock::time_point acquiredAt;
+    bool isReported;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<Token, Entry> entries_;
+  Token nextToken_ = 1;
+  std::chrono::milliseconds deadline_ { 1000 };
+  std::shared_ptr<Listener> listener_;
+};
+
+} // namespace vision
@@ -0,0 +1,42 @@
+#include "FrameSequencer.h"
+
+#include <mutex>
+
+namespace vision {
+
+uint64_t FrameSequencer::next() {
+  std::unique_lock lock(mutex_);
+  return next_++;
+}
+
+void FrameSequencer::waitForTurn(uint64_t sequence) {
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [&]() { return isClosed_ || completedUntil_ >= sequence; });
+}
+
+void FrameSequencer::complete(uint64_t sequence) {
+  {
+    std::unique_lock lock(mutex_);
+    if (sequence != completedUntil_) {
+      completedAhead_.insert(sequence);
+      return;
+    }
+    completedUntil_++;
+    // Frames that finished early are now in order too
+    while (!completedAhead_.empty() && *completedAhead_.begin() == completedUntil_) {
+      completedAhead_.erase(completedAhead_.begin());
+      completedUntil_++;
+    }
+  }
+  condition_.notify_all();
+}
+
+void FrameSequencer::close() {
+  {
+    std::unique_lock lock(mutex_);
+    isClosed_ = true;
+  }
+  condition_.notify_all();
+}
+
+} // namespace vision
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace vision {
+
+/**
+ * Numbers Frames in the order they are dispatched, and lets Frames that are processed in parallel wait for their turn,
+ * so whatever they do last (e.g. publishing a result) happens in Frame order.
+ *
+ * Every number handed out by next() has to be completed exactly once. Frames that don't need to wait can complete
+ * in any order, waitForTurn() only waits for all lower numbers to be completed.
+ */
+class FrameSequencer {
+ public:
+  /**
+   * Returns the number of the next Frame. Must only be called from a single thread (the one dispatching Frames).
+   */
+  uint64_t next();
+  /**
+   * Waits until all Frames before `sequence` have been completed, or the sequencer has been closed.
+   */
+  void waitForTurn(uint64_t sequence);
+  void complete(uint64_t sequence);
+  /**
+   * Wakes up all waiting Frames and lets every later waitForTurn() return right away.
+   */
+  void close();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  uint64_t next_ = 0;
+  // every Frame below this has been completed
+  uint64_t completedUntil_ = 0;
+  // Frames that were completed before an earlier one
+  std::set<uint64_t> completedAhead_;
+  bool isClosed_ = false;
+};
+
+} // namespace vision
@@ -0,0 +1,282 @@
+#include "FrameTracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vision {
+
+namespace {
+
+// Perfetto protobuf wire format, see https://perfetto.dev/docs/reference/trace-packet-proto
+namespace proto {
+
+constexpr uint32_t kTracePacket = 1;                   // Trace.packet
+constexpr uint32_t kPacketTimestamp = 8;               // TracePacket.timestamp
+constexpr uint32_t kPacketSequenceId = 10;             // TracePacket.trusted_packet_sequence_id
+constexpr uint32_t kPacketTrackEvent = 11;             // TracePacket.track_event
+constexpr uint32_t kPacketTimestampClockId = 58;       // TracePacket.timestamp_clock_id
+constexpr uint32_t kPacketTrackDescriptor = 60;        // TracePacket.track_descriptor
+constexpr uint32_t kTrackDescriptorUuid = 1;           // TrackDescriptor.uuid
+constexpr uint32_t kTrackDescriptorName = 2;           // TrackDescriptor.name
+constexpr uint32_t kTrackEventDebugAnnotations = 4;    // TrackEvent.debug_annotations
+constexpr uint32_t kTrackEventType = 9;                // TrackEvent.type
+constexpr uint32_t kTrackEventTrackUuid = 11;          // TrackEvent.track_uuid
+constexpr uint32_t kTrackEventName = 23;               // TrackEvent.name
+constexpr uint32_t kDebugAnnotationIntValue = 4;       // DebugAnnotation.int_value
+constexpr uint32_t kDebugAnnotationName = 10;          // DebugAnnotation.name
+
+constexpr uint64_t kSliceBegin = 1;
+constexpr uint64_t kSliceEnd = 2;
+// steady_clock is CLOCK_MONOTONIC on Android and iOS
+constexpr uint64_t kClockMonotonic = 3;
+constexpr uint64_t kSequenceId = 1;
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void writeVarintField(std::vector<uint8_t>& out, uint32_t field, uint64_t value) {
+  writeVarint(out, (field << 3) | 0);
+  writeVarint(out, value);
+}
+
+void writeBytesField(std::vector<uint8_t>& out, uint32_t field, const uint8_t* data, size_t size) {
+  writeVarint(out, (field << 3) | 2);
+  writeVarint(out, size);
+  out.insert(out.end(), data, data + size);
+}
+
+void writeStringField(std::vector<uint8_t>& out, uint32_t field, const std::string& value) {
+  writeBytesField(out, field, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+void writeMessageField(std::vector<uint8_t>& out, uint32_t field, const std::vector<uint8_t>& message) {
+  writeBytesField(out, field, message.data(), message.size());
+}
+
+void writeSlicePacket(std::vector<uint8_t>& out, uint64_t type, uint64_t trackUuid, int64_t timestamp, const TraceEvent* event) {
+  std::vector<uint8_t> trackEvent;
+  writeVarintField(trackEvent, kTrackEventType, type);
+  writeVarintField(trackEvent, kTrackEventTrackUuid, trackUuid);
+  if (event != nullptr) {
+    writeStringField(trackEvent, kTrackEventName, event->name);
+    if (event->frameTimestamp != 0) {
+      std::vector<uint8_t> annotation;
+      writeStringField(annotation, kDebugAnnotationName, "frame");
+      writeVarintField(annotation, kDebugAnnotationIntValue, static_cast<uint64_t>(event->frameTimestamp));
+      writeMessageField(trackEvent, kTrackEventDebugAnnotations, annotation);
+    }
+  }
+
+  std::vector<uint8_t> packet;
+  writeVarintField(packet, kPacketTimestamp, static_cast<uint64_t>(timestamp));
+  writeVarintField(packet, kPacketTimestampClockId, kClockMonotonic);
+  writeVarintField(packet, kPacketSequenceId, kSequenceId);
+  writeMessageField(packet, kPacketTrackEvent, trackEvent);
+  writeMessageField(out, kTracePacket, packet);
+}
+
+} // namespace proto
+
+void appendEscapedJSON(std::string& out, const std::string& value) {
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out += escaped;
+        } else {
+          out += c;
+        }
+    }
+  }
+}
+
+} // namespace
+
+FrameTracer& FrameTracer::shared() {
+  // never destroyed, threads might still record spans while static destructors run.
+  static auto tracer = new FrameTracer();
+  return *tracer;
+}
+
+void FrameTracer::start() {
+  startedAt_.store(now(), std::memory_order_relaxed);
+  isEnabled_.store(true, std::memory_order_release);
+}
+
+void FrameTracer::stop() {
+  isEnabled_.store(false, std::memory_order_release);
+}
+
+FrameTracer::ThreadBuffer& FrameTracer::getThreadBuffer() {
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    std::unique_lock lock(mutex_);
+    buffer = new ThreadBuffer();
+    buffer->threadId = static_cast<uint32_t>(buffers_.size() + 1);
+    buffers_.push_back(buffer);
+  }
+  return *buffer;
+}
+
+void FrameTracer::record(const char* name, int64_t start, int64_t end, int64_t frameTimestamp) {
+  if (!isEnabled()) {
+    return;
+  }
+  auto& buffer = getThreadBuffer();
+  auto index = buffer.writeIndex.load(std::memory_order_relaxed);
+  auto& slot = buffer.slots[index % kEventsPerThread];
+
+  auto sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.duration.store(end - start, std::memory_order_relaxed);
+  slot.frameTimestamp.store(frameTimestamp, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+
+  buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void FrameTracer::setThreadName(const std::string& name) {
+  auto threadId = getThreadBuffer().threadId;
+  std::unique_lock lock(mutex_);
+  for (auto& thread : threads_) {
+    if (thread.threadId == threadId) {
+      thread.name = name;
+      return;
+    }
+  }
+  threads_.push_back(ThreadInfo { threadId, name });
+}
+
+const char* FrameTracer::intern(const std::string& name) {
+  std::unique_lock lock(mutex_);
+  // elements of an unordered_set are never moved, so the pointer stays valid.
+  return names_.insert(name).first->c_str();
+}
+
+std::vector<FrameTracer::ThreadInfo> FrameTracer::getThreads() const {
+  std::unique_lock lock(mutex_);
+  auto threads = threads_;
+  for (const auto* buffer : buffers_) {
+    auto isNamed = std::any_of(threads.begin(), threads.end(), [&](const ThreadInfo& thread) {
+      return thread.threadId == buffer->threadId;
+    });
+    if (!isNamed) {
+      threads.push_back(ThreadInfo { buffer->threadId, "Thread " + std::to_string(buffer->threadId) });
+    }
+  }
+  return threads;
+}
+
+std::vector<TraceEvent> FrameTracer::getEvents() const {
+  std::vector<ThreadBuffer*> buffers;
+  {
+    std::unique_lock lock(mutex_);
+    buffers = buffers_;
+  }
+  auto startedAt = startedAt_.load(std::memory_order_relaxed);
+
+  std::vector<TraceEvent> events;
+  for (const auto* buffer : buffers) {
+    for (const auto& slot : buffer->slots) {
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == 0 || (sequence & 1) != 0) {
+        // never written, or currently being written
+        continue;
+      }
+      TraceEvent event;
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.start = slot.start.load(std::memory_order_relaxed);
+      event.duration = slot.duration.load(std::memory_order_relaxed);
+      event.frameTimestamp = slot.frameTimestamp.load(std::memory_order_relaxed);
+      event.threadId = buffer->threadId;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+        // overwritten while we read it
+        continue;
+      }
+      if (event.start >= startedAt) {
+        events.push_back(event);
+      }
+    }
+  }
+
+  std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+    return a.start < b.start;
+  });
+  return events;
+}
+
+std::string FrameTracer::toChromeTraceJSON() const {
+  auto events = getEvents();
+
+  std::string result = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool isFirst = true;
+  for (const auto& thread : getThreads()) {
+    result += isFirst ? "" : ",";
+    isFirst = false;
+    result += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread.threadId) + ",\"args\":{\"name\":\"";
+    appendEscapedJSON(result, thread.name);
+    result += "\"}}";
+  }
+
+  char timing[96];
+  for (const auto& event : events) {
+    result += isFirst ? "" : ",";
+    isFirst = false;
+    result += "{\"name\":\"";
+    appendEscapedJSON(result, event.name);
+    // timestamps are in microseconds
+    snprintf(timing, sizeof(timing), "\",\"cat\":\"frame-processor\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,",
+             event.start / 1000.0, event.duration / 1000.0);
+    result += timing;
+    result += "\"pid\":1,\"tid\":" + std::to_string(event.threadId);
+    if (event.frameTimestamp != 0) {
+      result += ",\"args\":{\"frame\":" + std::to_string(event.frameTimestamp) + "}";
+    }
+    result += "}";
+  }
+  result += "]}";
+  return result;
+}
+
+std::vector<uint8_t> FrameTracer::toPerfettoProtobuf() const {
+  auto events = getEvents();
+
+  std::vector<uint8_t> result;
+  // one track per thread, the track's uuid is the thread id.
+  for (const auto& thread : getThreads()) {
+    std::vector<uint8_t> descriptor;
+    proto::writeVarintField(descriptor, proto::kTrackDescriptorUuid, thread.threadId);
+    proto::writeStringField(descriptor, proto::kTrackDescriptorName, thread.name);
+
+    std::vector<uint8_t> packet;
+    proto::writeVarintField(packet, proto::kPacketSequenceId, proto::kSequenceId);
+    proto::writeMessageField(packet, proto::kPacketTrackDescriptor, descriptor);
+    proto::writeMessageField(result, proto::kTracePacket, packet);
+  }
+
+  for (const auto& event : events) {
+    proto::writeSlicePacket(result, proto::kSliceBegin, event.threadId, event.start, &event);
+    proto::writeSlicePacket(result, proto::kSliceEnd, event.threadId, event.start + event.duration, nullptr);
+  }
+  return result;
+}
+
+} // namespace vision
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace vision {
+
+/**
+ * A single span of the Frame Processor pipeline, e.g. running the worklet or calling a plugin.
+ */
+struct TraceEvent {
+  // a string with static lifetime, see FrameTracer::intern()
+  const char* name = nullptr;
+  // steady_clock, in nanoseconds
+  int64_t start = 0;
+  int64_t duration = 0;
+  // the presentation timestamp of the Frame this span belongs to, or 0
+  int64_t frameTimestamp = 0;
+  // the FrameTracer's id of the thread that recorded the span
+  uint32_t threadId = 0;
+};
+
+/**
+ * Records spans of the Frame Processor hot path (Camera callback, worklet, plugins, conversions, close) with very little overhead,
+ * so a regression can be attributed to a single stage instead of the total execution time.
+ *
+ * Every thread records into its own fixed-size ring buffer without locking; once a buffer is full, its oldest spans are overwritten.
+ * While tracing is stopped, recording a span costs a single atomic load.
+ * The recorded spans can be exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev) or as a Perfetto protobuf trace.
+ */
+class FrameTracer {
+ public:
+  // spans per thread, the Frame Processor records ~10 spans per Frame, so this covers a few seconds of Frames.
+  static constexpr size_t kEventsPerThread = 4096;
+
+  /**
+   * Get the tracer shared by all Cameras.
+   */
+  static FrameTracer& shared();
+
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /**
+   * Starts recording. Spans that were recorded before are discarded.
+   */
+  void start();
+  /**
+   * Stops recording, the spans recorded so far can still be exported.
+   */
+  void stop();
+  bool isEnabled() const { return isEnabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Records a span that ran from `start` until `end` (steady_clock nanoseconds) on the calling thread.
+   */
+  void record(const char* name, int64_t start, int64_t end, int64_t frameTimestamp = 0);
+
+  /**
+   * Names the calling thread in exported traces, e.g. "Frame Processor".
+   */
+  void setThreadName(const std::string& name);
+
+  /**
+   * Returns a copy of `name` that lives as long as the app, for spans with dynamic names (e.g. plugin names).
+   */
+  const char* intern(const std::string& name);
+
+  /**
+   * Returns all spans recorded since the last start(), ordered by their start time.
+   */
+  std::vector<TraceEvent> getEvents() const;
+
+  /**
+   * Exports all recorded spans in the Chrome trace event format (JSON).
+   */
+  std::string toChromeTraceJSON() const;
+  /**
+   * Exports all recorded spans as a Perfetto trace (`perfetto.protos.Trace`), one track per thread.
+   */
+  std::vector<uint8_t> toPerfettoProtobuf() const;
+
+ private:
+  struct Slot {
+    // odd while the slot is being written, so readers can detect torn spans.
+    std::atomic<uint32_t> sequence { 0 };
+    std::atomic<const char*> name { nullptr };
+    std::atomic<int64_t> start { 0 };
+    std::atomic<int64_t> duration { 0 };
+    std::atomic<int64_t> frameTimestamp { 0 };
+  };
+
+  struct ThreadBuffer {
+    uint32_t threadId = 0;
+    // written by the owning thread only
+    std::atomic<uint64_t> writeIndex { 0 };
+    std::array<Slot, kEventsPerThread> slots;
+  };
+
+  struct ThreadInfo {
+    uint32_t threadId;
+    std::string name;
+  };
+
+  ThreadBuffer& getThreadBuffer();
+  std::vector<ThreadInfo> getThreads() const;
+
+ private:
+  std::atomic<bool> isEnabled_ { false };
+  std::atomic<int64_t> startedAt_ { 0 };
+
+  mutable std::mutex mutex_;
+  // buffers are never freed, a thread's buffer is kept after it exited so its spans can still be exported.
+  std::vector<ThreadBuffer*> buffers_;
+  std::vector<ThreadInfo> threads_;
+  std::unordered_set<std::string> names_;
+};
+
+/**
+ * Records a span from construction until destruction, if tracing is enabled.
+ */
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name, int64_t frameTimestamp = 0):
+    name_(name), frameTimestamp_(frameTimestamp), start_(FrameTracer::shared().isEnabled() ? FrameTracer::now() : 0) { }
+
+  ~TraceScope() { end(); }
+
+  /**
+   * Ends the span before the scope ends. Only the first call records it.
+   */
+  void end() {
+    if (start_ != 0) {
+      FrameTracer::shared().record(name_, start_, FrameTracer::now(), frameTimestamp_);
+      start_ = 0;
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* name_;
+  int64_t frameTimestamp_;
+  int64_t start_;
+};
+
+} // namespace vision
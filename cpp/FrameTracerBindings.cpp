@@ -0,0 +1,86 @@
+#include "FrameTracerBindings.h"
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FrameTracer.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+/**
+ * A jsi::MutableBuffer that owns an exported trace. Traces are exported rarely, so they don't go through the BufferPool.
+ */
+class TraceBuffer : public jsi::MutableBuffer {
+ public:
+  explicit TraceBuffer(std::vector<uint8_t>&& data): data_(std::move(data)) { }
+
+  size_t size() const override { return data_.size(); }
+  uint8_t* data() override { return data_.data(); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+} // namespace
+
+void installFrameTracerBindings(jsi::Runtime& runtime) {
+  // startFrameProcessorTrace(): void
+  auto start = [](jsi::Runtime& runtime,
+                  const jsi::Value& thisValue,
+                  const jsi::Value* arguments,
+                  size_t count) -> jsi::Value {
+    FrameTracer::shared().start();
+    return jsi::Value::undefined();
+  };
+  runtime.global().setProperty(runtime, "startFrameProcessorTrace", jsi::Function::createFromHostFunction(runtime,
+                                                                                                          jsi::PropNameID::forAscii(runtime, "startFrameProcessorTrace"),
+                                                                                                          0,
+                                                                                                          start));
+
+  // stopFrameProcessorTrace(): void
+  auto stop = [](jsi::Runtime& runtime,
+                 const jsi::Value& thisValue,
+                 const jsi::Value* arguments,
+                 size_t count) -> jsi::Value {
+    FrameTracer::shared().stop();
+    return jsi::Value::undefined();
+  };
+  runtime.global().setProperty(runtime, "stopFrameProcessorTrace", jsi::Function::createFromHostFunction(runtime,
+                                                                                                         jsi::PropNameID::forAscii(runtime, "stopFrameProcessorTrace"),
+                                                                                                         0,
+                                                                                                         stop));
+
+  // getFrameProcessorTrace(format: 'chrome' | 'perfetto'): string | ArrayBuffer
+  auto getTrace = [](jsi::Runtime& runtime,
+                     const jsi::Value& thisValue,
+                     const jsi::Value* arguments,
+                     size_t count) -> jsi::Value {
+    std::string format = "chrome";
+    if (count > 0 && arguments[0].isString()) {
+      format = arguments[0].asString(runtime).utf8(runtime);
+    }
+
+    if (format == "chrome") {
+      return jsi::String::createFromUtf8(runtime, FrameTracer::shared().toChromeTraceJSON());
+    }
+    if (format == "perfetto") {
+      auto buffer = std::make_shared<TraceBuffer>(FrameTracer::shared().toPerfettoProtobuf());
+      return jsi::ArrayBuffer(runtime, buffer);
+    }
+    throw jsi::JSError(runtime, "getFrameProcessorTrace: Unknown format \"" + format + "\"! Expected \"chrome\" or \"perfetto\".");
+  };
+  runtime.global().setProperty(runtime, "getFrameProcessorTrace", jsi::Function::createFromHostFunction(runtime,
+                                                                                                        jsi::PropNameID::forAscii(runtime, "getFrameProcessorTrace"),
+                                                                                                        1, // format
+                                                                                                        getTrace));
+}
+
+} // namespace vision
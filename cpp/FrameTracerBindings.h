@@ -0,0 +1,14 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Installs `startFrameProcessorTrace()`, `stopFrameProcessorTrace()` and `getFrameProcessorTrace(format)` into the given Runtime.
+ */
+void installFrameTracerBindings(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+} // namespace vision
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "FrameDispatcher.h"
+#include "FrameTracer.h"
+#include "TaskScheduler.h"
+
+namespace vision {
+
+/**
+ * Processes Frames on multiple worker threads, e.g. one per worklet runtime of a Frame Processor.
+ *
+ * A single thread (the one popping the FrameQueue) dispatches Frames, the FrameDispatcher decides which worker
+ * gets each of them. Every worker processes one Frame at a time, so whatever a worker owns (its worklet runtime)
+ * is never used by two threads at once.
+ */
+template <typename T>
+class FrameWorkerPool {
+ public:
+  using Process = std::function<void(size_t worker, std::unique_ptr<T> frame)>;
+  using WorkerRunner = TaskScheduler::WorkerRunner;
+
+  FrameWorkerPool(size_t workersCount, FrameDispatchPolicy policy, Process process, WorkerRunner runner = nullptr):
+    dispatcher_(workersCount, policy), process_(std::move(process)) {
+    for (size_t i = 0; i < dispatcher_.getWorkersCount(); i++) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers_.size(); i++) {
+      workers_[i]->thread = std::thread([this, runner, i]() {
+        if (runner != nullptr) {
+          runner([&]() { runWorker(i); });
+        } else {
+          runWorker(i);
+        }
+      });
+    }
+  }
+
+  /**
+   * Waits for the Frames that are being processed, then stops the workers.
+   */
+  ~FrameWorkerPool() {
+    dispatcher_.waitUntilIdle();
+    dispatcher_.close();
+    for (auto& worker : workers_) {
+      {
+        std::unique_lock lock(worker->mutex);
+        worker->isStopped = true;
+      }
+      worker->condition.notify_one();
+    }
+    for (auto& worker : workers_) {
+      worker->thread.join();
+    }
+  }
+
+  FrameWorkerPool(const FrameWorkerPool&) = delete;
+  FrameWorkerPool& operator=(const FrameWorkerPool&) = delete;
+
+  /**
+   * Hands `frame` to a worker, and waits until one can take it. Must only be called from a single thread.
+   * Returns the worker.
+   */
+  size_t dispatch(std::unique_ptr<T> frame) {
+    auto index = dispatcher_.acquire();
+    if (!index.has_value()) {
+      // closed, only happens while the pool is destroyed
+      return 0;
+    }
+    auto& worker = *workers_[*index];
+    {
+      std::unique_lock lock(worker.mutex);
+      worker.frame = std::move(frame);
+    }
+    worker.condition.notify_one();
+    return *index;
+  }
+
+  size_t size() const { return workers_.size(); }
+  FrameDispatchPolicy getPolicy() const { return dispatcher_.getPolicy(); }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::unique_ptr<T> frame;
+    bool isStopped = false;
+    std::thread thread;
+  };
+
+  void runWorker(size_t index) {
+    FrameTracer::shared().setThreadName("Frame Processor " + std::to_string(index + 1));
+    auto& worker = *workers_[index];
+    while (true) {
+      std::unique_ptr<T> frame;
+      {
+        std::unique_lock lock(worker.mutex);
+        worker.condition.wait(lock, [&]() { return worker.frame != nullptr || worker.isStopped; });
+        if (worker.frame == nullptr) {
+          return;
+        }
+        frame = std::move(worker.frame);
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      process_(index, std::move(frame));
+      dispatcher_.release(index, std::chrono::steady_clock::now() - start);
+    }
+  }
+
+ private:
+  FrameDispatcher dispatcher_;
+  Process process_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace vision
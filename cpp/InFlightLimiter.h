@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace vision {
+
+/**
+ * Bounds how many tasks are in flight (queued or running) at once. A task that would exceed the limit is refused
+ * instead of queued, so a slow consumer never builds up a backlog of stale work.
+ *
+ * Lock-free, tasks can be acquired and released from any thread.
+ */
+class InFlightLimiter {
+ public:
+  explicit InFlightLimiter(size_t maxInFlight = 1): maxInFlight_(maxInFlight) { }
+
+  /**
+   * Counts a new task and returns true, or returns false if `maxInFlight` tasks are already in flight.
+   */
+  bool tryAcquire() {
+    auto inFlight = inFlight_.load(std::memory_order_relaxed);
+    do {
+      if (inFlight >= maxInFlight_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+    } while (!inFlight_.compare_exchange_weak(inFlight, inFlight + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return true;
+  }
+
+  /**
+   * Marks a task that was acquired with tryAcquire() as done.
+   */
+  void release() {
+    inFlight_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  /**
+   * Changes the limit. Tasks that are already in flight are not affected, even if there are more of them.
+   */
+  void setMaxInFlight(size_t maxInFlight) { maxInFlight_.store(maxInFlight, std::memory_order_relaxed); }
+  size_t getMaxInFlight() const { return maxInFlight_.load(std::memory_order_relaxed); }
+  size_t getInFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<size_t> maxInFlight_;
+  std::atomic<size_t> inFlight_ { 0 };
+};
+
+} // namespace vision
@@ -0,0 +1,116 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace vision {
+
+namespace {
+
+int getMostSignificantBit(uint64_t value) {
+  return 63 - __builtin_clzll(value);
+}
+
+} // namespace
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+  if (value < kSubBucketCount) {
+    // the first power of twos are recorded exactly
+    return static_cast<size_t>(value);
+  }
+  // `top` is the value's highest kSubBucketBits + 1 bits, so it is in [kSubBucketCount, 2 * kSubBucketCount).
+  auto shift = getMostSignificantBit(value) - kSubBucketBits;
+  auto top = value >> shift;
+  return static_cast<size_t>(shift * kSubBucketCount + top);
+}
+
+uint64_t LatencyHistogram::getHighestValueInBucket(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  auto shift = index / kSubBucketCount - 1;
+  auto top = index - shift * kSubBucketCount;
+  return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+  auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  recordMicroseconds(static_cast<uint64_t>(std::max<int64_t>(microseconds, 0)));
+}
+
+void LatencyHistogram::recordMicroseconds(uint64_t value) {
+  value = std::min(value, kMaxValue);
+  buckets_[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  auto max = max_.load(std::memory_order_relaxed);
+  while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) { }
+}
+
+std::array<uint64_t, LatencyHistogram::kBucketCount> LatencyHistogram::getCounts() const {
+  std::array<uint64_t, kBucketCount> counts;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  return counts;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(const std::array<uint64_t, kBucketCount>& counts, uint64_t total,
+                                                uint64_t max, double percentile) {
+  if (total == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(total)));
+  target = std::max<uint64_t>(target, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += counts[i];
+    if (seen >= target) {
+      // a bucket's highest value might be higher than anything that was actually recorded.
+      return std::min(getHighestValueInBucket(i), max);
+    }
+  }
+  return max;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+  auto counts = getCounts();
+  uint64_t total = 0;
+  for (auto count : counts) total += count;
+  return getValueAtPercentile(counts, total, max_.load(std::memory_order_relaxed), percentile);
+}
+
+LatencySummary LatencyHistogram::getSummary() const {
+  auto counts = getCounts();
+  // the total is summed up from the buckets we read, so the percentiles are consistent with each other.
+  uint64_t total = 0;
+  for (auto count : counts) total += count;
+  auto max = max_.load(std::memory_order_relaxed);
+
+  constexpr double kMillisecondsPerMicrosecond = 1.0 / 1000.0;
+  LatencySummary summary;
+  summary.count = total;
+  if (total > 0) {
+    summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(total) * kMillisecondsPerMicrosecond;
+  }
+  summary.p50 = getValueAtPercentile(counts, total, max, 0.5) * kMillisecondsPerMicrosecond;
+  summary.p90 = getValueAtPercentile(counts, total, max, 0.9) * kMillisecondsPerMicrosecond;
+  summary.p99 = getValueAtPercentile(counts, total, max, 0.99) * kMillisecondsPerMicrosecond;
+  summary.max = max * kMillisecondsPerMicrosecond;
+  return summary;
+}
+
+void LatencyHistogram::reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace vision
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vision {
+
+/**
+ * A summary of a LatencyHistogram, all durations are in milliseconds.
+ */
+struct LatencySummary {
+  uint64_t count = 0;
+  double mean = 0;
+  double p50 = 0;
+  double p90 = 0;
+  double p99 = 0;
+  double max = 0;
+};
+
+/**
+ * A fixed-size, HDR-style latency histogram with microsecond resolution.
+ *
+ * Values are bucketed log-linearly: every power of two is split into 32 linear sub-buckets, so a recorded value is off by at most ~3%,
+ * no matter if it is 50µs or 80ms. Durations from 1µs up to ~71 minutes fit into 896 buckets.
+ *
+ * Recording is lock-free (a few relaxed atomic increments), so the Frame Processor thread never blocks on a reader.
+ * A summary that is computed while values are being recorded might be off by those values.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr uint64_t kSubBucketCount = 1 << kSubBucketBits;
+  static constexpr int kMaxValueBits = 32;
+  static constexpr uint64_t kMaxValue = (uint64_t(1) << kMaxValueBits) - 1;
+  static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+  void record(std::chrono::nanoseconds duration);
+  /**
+   * Records a duration in microseconds. Values beyond kMaxValue are clamped.
+   */
+  void recordMicroseconds(uint64_t value);
+
+  uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+  /**
+   * Returns the value (in microseconds) that `percentile` (0...1) of all recorded values are less than or equal to,
+   * or 0 if nothing has been recorded.
+   */
+  uint64_t getValueAtPercentile(double percentile) const;
+
+  LatencySummary getSummary() const;
+
+  /**
+   * Removes all recorded values. Values that are recorded concurrently might be partially kept.
+   */
+  void reset();
+
+  static size_t getBucketIndex(uint64_t value);
+  /**
+   * Returns the highest value that is recorded into the bucket at `index`.
+   */
+  static uint64_t getHighestValueInBucket(size_t index);
+
+ private:
+  std::array<uint64_t, kBucketCount> getCounts() const;
+  static uint64_t getValueAtPercentile(const std::array<uint64_t, kBucketCount>& counts, uint64_t total, uint64_t max, double percentile);
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_ {};
+  std::atomic<uint64_t> count_ { 0 };
+  std::atomic<uint64_t> sum_ { 0 };
+  std::atomic<uint64_t> max_ { 0 };
+};
+
+} // namespace vision
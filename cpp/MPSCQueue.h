@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace vision {
+
+/**
+ * An unbounded, lock-free multi-producer/single-consumer queue (Dmitry Vyukov's intrusive MPSC queue).
+ *
+ * Producers push from any thread with a single atomic exchange, and never wait for each other or for the consumer.
+ * Only one thread may pop at a time.
+ *
+ * A push is published in two steps (swing `head_`, then link the previous node), so for a short moment the consumer can see
+ * a queue that is neither empty nor poppable. pop() then returns nothing and isEmpty() returns false, the consumer simply tries again.
+ */
+template <typename T>
+class MPSCQueue {
+ public:
+  MPSCQueue(): head_(&stub_), tail_(&stub_) { }
+
+  ~MPSCQueue() {
+    while (pop().has_value()) { }
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  /**
+   * Enqueues `value`. Can be called from any thread.
+   */
+  void push(T value) {
+    pushNode(new Node(std::move(value)));
+  }
+
+  /**
+   * Dequeues the oldest value, or returns nothing if the queue is empty (or a push is still being published).
+   * Must only be called from the consumer thread.
+   */
+  std::optional<T> pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return std::nullopt;
+      }
+      // skip the stub
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next == nullptr) {
+      if (tail != head_.load(std::memory_order_acquire)) {
+        // a producer swung `head_` but did not link its node yet
+        return std::nullopt;
+      }
+      // `tail` is the last node - put the stub behind it, so `tail` can be removed.
+      pushNode(&stub_);
+      next = tail->next.load(std::memory_order_acquire);
+      if (next == nullptr) {
+        return std::nullopt;
+      }
+    }
+    tail_ = next;
+    std::optional<T> value(std::move(tail->value));
+    delete tail;
+    return value;
+  }
+
+  /**
+   * Whether nothing has been pushed that was not popped yet. Must only be called from the consumer thread.
+   */
+  bool isEmpty() const {
+    return head_.load(std::memory_order_seq_cst) == tail_;
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(T&& value): value(std::move(value)) { }
+
+    std::atomic<Node*> next { nullptr };
+    T value;
+  };
+
+  void pushNode(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* previous = head_.exchange(node, std::memory_order_seq_cst);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+ private:
+  // the most recently pushed node, producers swing it
+  std::atomic<Node*> head_;
+  // the oldest node, only touched by the consumer
+  Node* tail_;
+  // keeps the queue non-empty, so producers never have to touch `tail_`
+  Node stub_;
+};
+
+} // namespace vision
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * One call of a Frame Processor Plugin in `runParallel()`, split at the points where it touches JS.
+ *
+ * It is prepared (arguments converted) on the Frame Processor thread, run() on a worker of the WorkStealingPool,
+ * and its result is converted back on the Frame Processor thread.
+ */
+class ParallelPluginCall {
+ public:
+  virtual ~ParallelPluginCall() = default;
+
+  /**
+   * Whether run() can be called on another thread. If not, the call does all of its work in getResult(), on the
+   * Frame Processor thread, while the parallel calls run on the workers.
+   */
+  virtual bool isParallel() const { return true; }
+  /**
+   * Calls the plugin. Runs on a worker thread, so it must not touch the jsi::Runtime. Must not throw,
+   * an error is kept and thrown by getResult().
+   */
+  virtual void run() = 0;
+  /**
+   * Converts the result of run() to a JS value, or throws the error it failed with. Called on the Frame Processor thread.
+   */
+  virtual jsi::Value getResult(jsi::Runtime& runtime) = 0; // NOLINT(runtime/references)
+};
+
+} // namespace vision
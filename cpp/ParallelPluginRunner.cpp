@@ -0,0 +1,230 @@
+#include "ParallelPluginRunner.h"
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "FrameProcessorPluginRegistryNative.h"
+#include "FrameProcessorStats.h"
+#include "FrameTracer.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+// a runParallel() rarely calls more plugins than this, and the calling thread helps as well.
+constexpr size_t kMaxWorkersCount = 4;
+
+/**
+ * Calls a plugin that can't run on another thread through its installed `__<name>` function, on the Frame Processor thread.
+ */
+class InlinePluginCall : public ParallelPluginCall {
+ public:
+  InlinePluginCall(jsi::Runtime& runtime, // NOLINT(runtime/references)
+                   const std::string& name,
+                   const jsi::Value& frame,
+                   std::vector<jsi::Value> arguments): arguments_(std::move(arguments)) {
+    auto function = runtime.global().getProperty(runtime, ("__" + name).c_str());
+    if (!function.isObject() || !function.asObject(runtime).isFunction(runtime)) {
+      throw jsi::JSError(runtime, "runParallel(): There is no Frame Processor Plugin named \"" + name + "\"!");
+    }
+    function_ = std::make_unique<jsi::Function>(function.asObject(runtime).asFunction(runtime));
+    arguments_.insert(arguments_.begin(), jsi::Value(runtime, frame));
+  }
+
+  bool isParallel() const override { return false; }
+  void run() override { }
+  jsi::Value getResult(jsi::Runtime& runtime) override {
+    return function_->call(runtime, static_cast<const jsi::Value*>(arguments_.data()), arguments_.size());
+  }
+
+ private:
+  std::unique_ptr<jsi::Function> function_;
+  std::vector<jsi::Value> arguments_;
+};
+
+struct PreparedCall {
+  std::string name;
+  const char* traceName;
+  std::unique_ptr<ParallelPluginCall> call;
+};
+
+} // namespace
+
+ParallelPluginRunner& ParallelPluginRunner::shared() {
+  // never destroyed, like the plugin registry: plugins might still be called while static destructors run.
+  static auto runner = new ParallelPluginRunner();
+  return *runner;
+}
+
+void ParallelPluginRunner::addPlatformPlugin(const std::string& name, PrepareCall prepare) {
+  auto traceName = FrameTracer::shared().intern("plugin __" + name);
+  std::unique_lock lock(mutex_);
+  platformPlugins_[name] = PluginEntry { std::move(prepare), traceName };
+}
+
+void ParallelPluginRunner::setWorkerRunner(WorkStealingPool::WorkerRunner runner) {
+  std::unique_lock lock(mutex_);
+  workerRunner_ = std::move(runner);
+}
+
+WorkStealingPool& ParallelPluginRunner::getPool() {
+  std::unique_lock lock(mutex_);
+  if (pool_ == nullptr) {
+    auto cores = static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 2u));
+    pool_ = std::make_unique<WorkStealingPool>(std::min(cores - 1, kMaxWorkersCount), workerRunner_);
+  }
+  return *pool_;
+}
+
+bool ParallelPluginRunner::findPlugin(const std::string& name, PluginEntry& entry) {
+  std::unique_lock lock(mutex_);
+  auto native = nativePlugins_.find(name);
+  if (native != nativePlugins_.end()) {
+    entry = native->second;
+    return true;
+  }
+  // a native plugin replaces a platform plugin with the same name.
+  auto plugin = FrameProcessorPluginRegistryNative::shared().findPlugin(name);
+  if (plugin != nullptr) {
+    auto prepare = [plugin](jsi::Runtime& runtime,
+                            FrameHostObjectBase& frame,
+                            const jsi::Value* arguments,
+                            size_t count) {
+      return plugin->prepareParallelCall(runtime, frame.descriptor, arguments, count);
+    };
+    entry = PluginEntry { prepare, FrameTracer::shared().intern("plugin __" + name) };
+    nativePlugins_[name] = entry;
+    return true;
+  }
+  auto platform = platformPlugins_.find(name);
+  if (platform != platformPlugins_.end()) {
+    entry = platform->second;
+    return true;
+  }
+  return false;
+}
+
+void ParallelPluginRunner::installJSIBindings(jsi::Runtime& runtime) {
+  // __runParallel(frame: Frame, calls: (string | [string, ...unknown[]])[]): Record<string, unknown>
+  auto runParallel = [this](jsi::Runtime& runtime,
+                            const jsi::Value& thisValue,
+                            const jsi::Value* arguments,
+                            size_t count) -> jsi::Value {
+    if (count < 2 || !arguments[0].isObject() || !arguments[0].asObject(runtime).isHostObject(runtime)) {
+      throw jsi::JSError(runtime, "runParallel(): First argument ('frame') must be a Frame!");
+    }
+    auto frame = std::dynamic_pointer_cast<FrameHostObjectBase>(arguments[0].asObject(runtime).asHostObject(runtime));
+    if (frame == nullptr) {
+      throw jsi::JSError(runtime, "runParallel(): First argument ('frame') must be a Frame!");
+    }
+    if (!frame->descriptor.isValid) {
+      throw jsi::JSError(runtime, "runParallel() was called with a Frame that has already been released!");
+    }
+    if (!arguments[1].isObject() || !arguments[1].asObject(runtime).isArray(runtime)) {
+      throw jsi::JSError(runtime, "runParallel(): Second argument ('plugins') must be an array!");
+    }
+    auto timestamp = frame->descriptor.timestamp;
+    auto stats = frame->getSourceFrame().stats.get();
+    TraceScope trace("runParallel", timestamp);
+    PluginStageScope argumentsStage(stats, PluginStage::ArgumentsConversion);
+
+    // 1. convert all arguments on this thread, nothing runs yet.
+    auto calls = arguments[1].asObject(runtime).asArray(runtime);
+    auto callsCount = calls.size(runtime);
+    std::vector<PreparedCall> prepared;
+    prepared.reserve(callsCount);
+    for (size_t i = 0; i < callsCount; i++) {
+      auto element = calls.getValueAtIndex(runtime, i);
+      std::string name;
+      std::vector<jsi::Value> callArguments;
+      if (element.isString()) {
+        name = element.asString(runtime).utf8(runtime);
+      } else if (element.isObject() && element.asObject(runtime).isArray(runtime)) {
+        auto tuple = element.asObject(runtime).asArray(runtime);
+        auto tupleSize = tuple.size(runtime);
+        auto first = tupleSize > 0 ? tuple.getValueAtIndex(runtime, 0) : jsi::Value::undefined();
+        if (!first.isString()) {
+          throw jsi::JSError(runtime, "runParallel(): Expected [name, ...arguments], but the plugin name is missing!");
+        }
+        name = first.asString(runtime).utf8(runtime);
+        for (size_t j = 1; j < tupleSize; j++) {
+          callArguments.push_back(tuple.getValueAtIndex(runtime, j));
+        }
+      } else {
+        throw jsi::JSError(runtime, "runParallel(): Expected a plugin name or [name, ...arguments]!");
+      }
+      for (const auto& other : prepared) {
+        if (other.name == name) {
+          throw jsi::JSError(runtime, "runParallel(): The plugin \"" + name + "\" is called twice, but the results are keyed by plugin name!");
+        }
+      }
+
+      std::unique_ptr<ParallelPluginCall> call;
+      const char* traceName = nullptr;
+      PluginEntry entry;
+      if (findPlugin(name, entry)) {
+        call = entry.prepare(runtime, *frame, callArguments.data(), callArguments.size());
+        traceName = entry.traceName;
+      }
+      if (call == nullptr) {
+        call = std::make_unique<InlinePluginCall>(runtime, name, arguments[0], std::move(callArguments));
+      }
+      prepared.push_back(PreparedCall { std::move(name), traceName, std::move(call) });
+    }
+
+    argumentsStage.end();
+
+    // 2. run the parallel calls on the pool, and the others on this thread in the meantime.
+    std::vector<WorkStealingPool::Task> tasks;
+    for (auto& preparedCall : prepared) {
+      if (preparedCall.call->isParallel()) {
+        tasks.push_back([call = preparedCall.call.get(), traceName = preparedCall.traceName, timestamp, stats]() {
+          TraceScope pluginTrace(traceName, timestamp);
+          PluginStageScope callStage(stats, PluginStage::Call);
+          call->run();
+        });
+      }
+    }
+    auto result = jsi::Object(runtime);
+    getPool().run(std::move(tasks), [&]() {
+      for (auto& preparedCall : prepared) {
+        if (!preparedCall.call->isParallel()) {
+          result.setProperty(runtime, preparedCall.name.c_str(), preparedCall.call->getResult(runtime));
+        }
+      }
+    });
+
+    // 3. convert the results of the parallel calls on this thread.
+    TraceScope resultsTrace("convertResults", timestamp);
+    PluginStageScope resultsStage(stats, PluginStage::ResultConversion);
+    for (auto& preparedCall : prepared) {
+      if (preparedCall.call->isParallel()) {
+        try {
+          result.setProperty(runtime, preparedCall.name.c_str(), preparedCall.call->getResult(runtime));
+        } catch (...) {
+          if (stats != nullptr) {
+            stats->recordPluginError();
+          }
+          throw;
+        }
+      }
+    }
+    return result;
+  };
+
+  runtime.global().setProperty(runtime, "__runParallel", jsi::Function::createFromHostFunction(runtime,
+                                                                                             jsi::PropNameID::forAscii(runtime, "__runParallel"),
+                                                                                             2, // frame, plugins
+                                                                                             runParallel));
+}
+
+} // namespace vision
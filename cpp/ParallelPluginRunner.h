@@ -0,0 +1,77 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "FrameHostObjectBase.h"
+#include "ParallelPluginCall.h"
+#include "WorkStealingPool.h"
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Installs `__runParallel(frame, calls)`, which calls multiple Frame Processor Plugins with the same Frame at once and returns
+ * their results as one object, keyed by plugin name. A Frame then takes as long as its slowest plugin instead of all of them combined.
+ *
+ * Native plugins take part with FrameProcessorPluginNative::prepareParallelCall(), platform plugins (Java) are added with addPlatformPlugin().
+ * Every other plugin is called on the Frame Processor thread while the others run.
+ */
+class ParallelPluginRunner {
+ public:
+  /**
+   * Prepares a call of a plugin with the given Frame and the arguments after it. Called on the Frame Processor thread.
+   */
+  using PrepareCall = std::function<std::unique_ptr<ParallelPluginCall>(jsi::Runtime& runtime, // NOLINT(runtime/references)
+                                                                        FrameHostObjectBase& frame, // NOLINT(runtime/references)
+                                                                        const jsi::Value* arguments,
+                                                                        size_t count)>;
+
+  /**
+   * Get the runner shared by all Cameras.
+   */
+  static ParallelPluginRunner& shared();
+
+  /**
+   * Adds a platform (Java/Objective-C) plugin that can be called in parallel. A native plugin with the same name replaces it.
+   */
+  void addPlatformPlugin(const std::string& name, PrepareCall prepare);
+  /**
+   * Runs the pool's workers through `runner`, e.g. to attach them to the JVM. Must be called before the first `runParallel()`.
+   */
+  void setWorkerRunner(WorkStealingPool::WorkerRunner runner);
+
+  /**
+   * Installs `__runParallel` into the given (worklet) Runtime. Plugins are looked up when they are called, so plugins added later work as well.
+   */
+  void installJSIBindings(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+ private:
+  struct PluginEntry {
+    PrepareCall prepare;
+    const char* traceName;
+  };
+
+  WorkStealingPool& getPool();
+  /**
+   * Finds the plugin with the given name, a native plugin first. Returns false if neither kind of plugin has that name.
+   */
+  bool findPlugin(const std::string& name, PluginEntry& entry); // NOLINT(runtime/references)
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, PluginEntry> platformPlugins_;
+  // native plugins that have been called in runParallel() before, native plugins are never replaced.
+  std::unordered_map<std::string, PluginEntry> nativePlugins_;
+  WorkStealingPool::WorkerRunner workerRunner_;
+  // created on the first runParallel(), so apps that don't use it don't pay for the threads.
+  std::unique_ptr<WorkStealingPool> pool_;
+};
+
+} // namespace vision
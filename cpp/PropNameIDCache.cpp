@@ -0,0 +1,37 @@
+#include "PropNameIDCache.h"
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+
+#include "RuntimeCache.h"
+
+namespace vision {
+
+using namespace facebook;
+
+namespace {
+
+constexpr auto kCacheGlobalName = "__visionCameraPropNameIDCache";
+
+} // namespace
+
+std::shared_ptr<PropNameIDCache> PropNameIDCache::forRuntime(jsi::Runtime& runtime) {
+  return RuntimeCache<PropNameIDCache>::get(runtime, kCacheGlobalName, []() { return std::make_shared<PropNameIDCache>(); });
+}
+
+jsi::PropNameID PropNameIDCache::get(jsi::Runtime& runtime, const std::string& key) {
+  auto cached = names_.find(key);
+  if (cached != names_.end()) {
+    return jsi::PropNameID(runtime, cached->second);
+  }
+
+  auto name = jsi::PropNameID::forUtf8(runtime, key);
+  if (names_.size() < kMaxKeys) {
+    names_.emplace(key, jsi::PropNameID(runtime, name));
+  }
+  return name;
+}
+
+} // namespace vision
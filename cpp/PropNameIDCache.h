@@ -0,0 +1,38 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Interns the jsi::PropNameIDs of object keys that are converted from native values (e.g. Frame Processor Plugin results),
+ * so a key like `"x"` is only created once per Runtime instead of once for every object in every Frame.
+ *
+ * Like the FramePropertyCache, the cache is owned by the Runtime it was created for (it's stored in a hidden global).
+ */
+class PropNameIDCache : public jsi::HostObject {
+ public:
+  // results are mostly arrays of the same few objects, so a small cache covers every key. Keys beyond it are not cached.
+  static constexpr size_t kMaxKeys = 512;
+
+  /**
+   * Get the cache for the given Runtime, or create it if this is the first time a key is interned in that Runtime.
+   */
+  static std::shared_ptr<PropNameIDCache> forRuntime(jsi::Runtime& runtime); // NOLINT(runtime/references)
+
+  /**
+   * Get the interned PropNameID for `key`, creating it if it is not cached yet.
+   */
+  jsi::PropNameID get(jsi::Runtime& runtime, const std::string& key); // NOLINT(runtime/references)
+
+ private:
+  std::unordered_map<std::string, jsi::PropNameID> names_;
+};
+
+} // namespace vision
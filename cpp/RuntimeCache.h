@@ -0,0 +1,60 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <utility>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Gets a per-Runtime cache of type `T` (a jsi::HostObject), or creates it if this is the first time it is used in that Runtime.
+ *
+ * The cache is owned by the Runtime it was created for (it's stored in a hidden global), so all jsi::Values it holds are
+ * released before the Runtime is destroyed. Caches are almost always used from the same Runtime on the same Thread
+ * (the Frame Processor), so the last one is remembered per Thread to avoid going through the global object.
+ */
+template <typename T>
+class RuntimeCache {
+ public:
+  template <typename Create>
+  static std::shared_ptr<T> get(jsi::Runtime& runtime, const char* globalName, Create&& create) { // NOLINT(runtime/references)
+    auto& last = getLastUsed();
+    if (last.runtime == &runtime) {
+      auto cache = last.cache.lock();
+      if (cache != nullptr) {
+        return cache;
+      }
+    }
+
+    auto global = runtime.global();
+    auto value = global.getProperty(runtime, globalName);
+    std::shared_ptr<T> cache;
+    if (value.isObject() && value.getObject(runtime).isHostObject<T>(runtime)) {
+      cache = value.getObject(runtime).getHostObject<T>(runtime);
+    } else {
+      cache = std::forward<Create>(create)();
+      global.setProperty(runtime, globalName, jsi::Object::createFromHostObject(runtime, cache));
+    }
+
+    last.runtime = &runtime;
+    last.cache = cache;
+    return cache;
+  }
+
+ private:
+  struct LastUsed {
+    jsi::Runtime* runtime = nullptr;
+    // weak, the Runtime owns the cache.
+    std::weak_ptr<T> cache;
+  };
+
+  static LastUsed& getLastUsed() {
+    static thread_local LastUsed last;
+    return last;
+  }
+};
+
+} // namespace vision
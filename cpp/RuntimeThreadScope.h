@@ -0,0 +1,41 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * Marks `runtime` as the Runtime the current thread is executing, while the Scope lives.
+ *
+ * A jsi::Runtime is not thread-safe, so native code that modifies a worklet runtime (e.g. installing plugins into its globals)
+ * has to run on the thread that runs the runtime, while no JS executes on any other. The Frame Processor and runAsync() open a
+ * Scope around the work they do on their runtime, and isCurrent() checks that a call happens inside one.
+ */
+class RuntimeThreadScope {
+ public:
+  explicit RuntimeThreadScope(jsi::Runtime& runtime): previous_(getCurrent()) { // NOLINT(runtime/references)
+    getCurrent() = &runtime;
+  }
+  ~RuntimeThreadScope() { getCurrent() = previous_; }
+
+  RuntimeThreadScope(const RuntimeThreadScope&) = delete;
+  RuntimeThreadScope& operator=(const RuntimeThreadScope&) = delete;
+
+  /**
+   * Whether the current thread is executing `runtime`.
+   */
+  static bool isCurrent(jsi::Runtime& runtime) { return getCurrent() == &runtime; } // NOLINT(runtime/references)
+
+ private:
+  static jsi::Runtime*& getCurrent() {
+    static thread_local jsi::Runtime* current = nullptr;
+    return current;
+  }
+
+ private:
+  jsi::Runtime* previous_;
+};
+
+} // namespace vision
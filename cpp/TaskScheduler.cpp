@@ -0,0 +1,150 @@
+#include "TaskScheduler.h"
+
+#include <pthread.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined(__APPLE__)
+#include <pthread/qos.h>
+#endif
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "FrameTracer.h"
+
+namespace vision {
+
+namespace {
+
+// a worker yields this often before it goes to sleep, so tasks that are scheduled back-to-back don't pay for a wake-up.
+constexpr int kSpinCount = 64;
+
+struct LaneInfo {
+  // at most 15 characters, the limit of pthread names on Linux
+  const char* threadName;
+  // Android's THREAD_PRIORITY_DISPLAY, THREAD_PRIORITY_BACKGROUND and THREAD_PRIORITY_DEFAULT
+  int niceness;
+#if defined(__APPLE__)
+  qos_class_t qos;
+#endif
+};
+
+LaneInfo getLaneInfo(TaskLane lane) {
+  switch (lane) {
+    case TaskLane::Frame:
+#if defined(__APPLE__)
+      return { "VisionFrame", -4, QOS_CLASS_USER_INTERACTIVE };
+#else
+      return { "VisionFrame", -4 };
+#endif
+    case TaskLane::Plugin:
+#if defined(__APPLE__)
+      return { "VisionPlugin", 10, QOS_CLASS_UTILITY };
+#else
+      return { "VisionPlugin", 10 };
+#endif
+    case TaskLane::Callback:
+    default:
+#if defined(__APPLE__)
+      return { "VisionCallback", 0, QOS_CLASS_DEFAULT };
+#else
+      return { "VisionCallback", 0 };
+#endif
+  }
+}
+
+void configureWorkerThread(TaskLane lane) {
+  auto info = getLaneInfo(lane);
+  FrameTracer::shared().setThreadName(info.threadName);
+  // both are best-effort, e.g. a process might not be allowed to raise its priority.
+#if defined(__linux__)
+  pthread_setname_np(pthread_self(), info.threadName);
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), info.niceness);
+#elif defined(__APPLE__)
+  pthread_setname_np(info.threadName);
+  pthread_set_qos_class_self_np(info.qos, 0);
+#endif
+}
+
+} // namespace
+
+TaskScheduler::TaskScheduler(WorkerRunner runner) {
+  for (size_t i = 0; i < kLanesCount; i++) {
+    lanes_[i] = std::make_unique<Lane>();
+    auto lane = static_cast<TaskLane>(i);
+    auto& state = *lanes_[i];
+    state.worker = std::thread([this, runner, lane, &state]() {
+      if (runner != nullptr) {
+        runner([&]() { runWorker(lane, state); });
+      } else {
+        runWorker(lane, state);
+      }
+    });
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  for (auto& lane : lanes_) {
+    lane->isStopped.store(true, std::memory_order_seq_cst);
+    wake(*lane);
+  }
+  for (auto& lane : lanes_) {
+    lane->worker.join();
+  }
+}
+
+void TaskScheduler::schedule(TaskLane lane, Task task) {
+  auto& state = *lanes_[static_cast<size_t>(lane)];
+  state.tasks.push(std::move(task));
+  wake(state);
+}
+
+void TaskScheduler::wake(Lane& lane) {
+  // pairs with the increment in runWorker(): either the worker sees the new task, or we see the worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (lane.waiters.load(std::memory_order_seq_cst) > 0) {
+    std::unique_lock lock(lane.mutex);
+    lane.condition.notify_one();
+  }
+}
+
+void TaskScheduler::runWorker(TaskLane lane, Lane& state) {
+  configureWorkerThread(lane);
+  while (true) {
+    auto task = state.tasks.pop();
+    if (task.has_value()) {
+      (*task)();
+      continue;
+    }
+    if (!state.tasks.isEmpty()) {
+      // a push is still being published
+      std::this_thread::yield();
+      continue;
+    }
+    if (state.isStopped.load(std::memory_order_seq_cst)) {
+      return;
+    }
+
+    bool hasTask = false;
+    for (int i = 0; i < kSpinCount && !hasTask; i++) {
+      std::this_thread::yield();
+      hasTask = !state.tasks.isEmpty();
+    }
+    if (hasTask) {
+      continue;
+    }
+
+    std::unique_lock lock(state.mutex);
+    state.waiters.fetch_add(1, std::memory_order_seq_cst);
+    state.condition.wait(lock, [&]() { return !state.tasks.isEmpty() || state.isStopped.load(std::memory_order_seq_cst); });
+    state.waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace vision
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "MPSCQueue.h"
+
+namespace vision {
+
+/**
+ * The lanes of the TaskScheduler, from the most to the least urgent.
+ */
+enum class TaskLane {
+  // work on a Frame that the Camera waits for
+  Frame,
+  // background work of Frame Processor Plugins
+  Plugin,
+  // callbacks into JS or the platform, e.g. events
+  Callback,
+  // not a lane, marks the amount of lanes.
+  Count,
+};
+
+/**
+ * Runs tasks on VisionCamera's own worker threads instead of a shared platform executor.
+ *
+ * Every lane has its own worker thread and its own lock-free MPSCQueue, so Frame work never queues behind plugin
+ * background work or callbacks, and tasks of one lane run one after another in the order they were scheduled.
+ * The workers run with lower OS priorities the less urgent their lane is.
+ *
+ * Scheduling never locks: a task is pushed with one atomic exchange, and the mutex is only taken to wake up a worker
+ * that went to sleep because its lane was empty.
+ */
+class TaskScheduler {
+ public:
+  using Task = std::function<void()>;
+  /**
+   * Runs a worker's loop, e.g. to attach the worker thread to the JVM first.
+   */
+  using WorkerRunner = std::function<void(const std::function<void()>& loop)>;
+
+  explicit TaskScheduler(WorkerRunner runner = nullptr);
+  /**
+   * Runs all tasks that have been scheduled so far, then stops the workers.
+   */
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  /**
+   * Schedules `task` to run on the worker of `lane`. Can be called from any thread, including the workers.
+   * `task` must not throw, it runs outside of any JS or platform error handling.
+   */
+  void schedule(TaskLane lane, Task task);
+
+ private:
+  struct Lane {
+    MPSCQueue<Task> tasks;
+    std::atomic<bool> isStopped { false };
+    std::atomic<int> waiters { 0 };
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::thread worker;
+  };
+  static constexpr size_t kLanesCount = static_cast<size_t>(TaskLane::Count);
+
+  void runWorker(TaskLane lane, Lane& state); // NOLINT(runtime/references)
+  void wake(Lane& lane); // NOLINT(runtime/references)
+
+ private:
+  std::array<std::unique_ptr<Lane>, kLanesCount> lanes_;
+};
+
+} // namespace vision
@@ -0,0 +1,33 @@
+#include "TypedArrays.h"
+
+#include <jsi/jsi.h>
+
+#include <utility>
+
+namespace vision {
+
+using namespace facebook;
+
+jsi::Value createTypedArray(jsi::Runtime& runtime, const char* typedArrayName, jsi::ArrayBuffer arrayBuffer) {
+  auto constructor = runtime.global().getPropertyAsFunction(runtime, typedArrayName);
+  return constructor.callAsConstructor(runtime, std::move(arrayBuffer));
+}
+
+bool isArrayBufferView(jsi::Runtime& runtime, const jsi::Object& object) {
+  // cheap check first, so plain objects don't have to call into JS.
+  auto buffer = object.getProperty(runtime, "buffer");
+  if (!buffer.isObject() || !buffer.getObject(runtime).isArrayBuffer(runtime)) {
+    return false;
+  }
+  auto isView = runtime.global().getPropertyAsObject(runtime, "ArrayBuffer").getPropertyAsFunction(runtime, "isView");
+  return isView.call(runtime, object).getBool();
+}
+
+ArrayBufferViewRange getArrayBufferViewRange(jsi::Runtime& runtime, const jsi::Object& view) {
+  auto arrayBuffer = view.getPropertyAsObject(runtime, "buffer").getArrayBuffer(runtime);
+  auto byteOffset = static_cast<size_t>(view.getProperty(runtime, "byteOffset").asNumber());
+  auto byteLength = static_cast<size_t>(view.getProperty(runtime, "byteLength").asNumber());
+  return ArrayBufferViewRange { arrayBuffer.data(runtime) + byteOffset, byteLength };
+}
+
+} // namespace vision
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vision {
+
+using namespace facebook;
+
+/**
+ * The memory a typed array or DataView covers within its ArrayBuffer.
+ */
+struct ArrayBufferViewRange {
+  uint8_t* data = nullptr;
+  size_t size = 0;
+};
+
+/**
+ * Wraps `arrayBuffer` in a new JS typed array, e.g. `new Float32Array(arrayBuffer)`.
+ */
+jsi::Value createTypedArray(jsi::Runtime& runtime, const char* typedArrayName, jsi::ArrayBuffer arrayBuffer); // NOLINT(runtime/references)
+
+/**
+ * Whether `object` is a typed array or a DataView (`ArrayBuffer.isView(object)`).
+ */
+bool isArrayBufferView(jsi::Runtime& runtime, const jsi::Object& object); // NOLINT(runtime/references)
+
+/**
+ * Returns the range of the underlying ArrayBuffer that the typed array or DataView `view` covers.
+ * The memory is owned by the JS ArrayBuffer.
+ */
+ArrayBufferViewRange getArrayBufferViewRange(jsi::Runtime& runtime, const jsi::Object& view); // NOLINT(runtime/references)
+
+} // namespace vision
@@ -0,0 +1,43 @@
+# The platform-independent sources of the Frame Processor pipeline, shared by the Android library (android/CMakeLists.txt)
+# and the host build (cpp/CMakeLists.txt). iOS compiles the same files through the podspec's `cpp/**/*.cpp` glob.
+
+# plain C++, no JSI
+set(
+        VISION_CAMERA_CORE_SOURCES
+        ${CMAKE_CURRENT_LIST_DIR}/BufferPool.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameChangeDetector.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameCrop.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameDispatcher.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameProcessorStats.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameProperties.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameRateController.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameRecording.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameRetentionBudget.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameRetentionMonitor.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameSequencer.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameTracer.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/LatencyHistogram.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/TaskScheduler.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/WorkStealingPool.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/FrameToTensor.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/LumaChange.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/LumaStatistics.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/YUVToRGB.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/YUVToRGBx86.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/kernels/YUVToRGBNEON.cpp
+)
+
+# the Frame HostObject, JSI bindings and conversions
+set(
+        VISION_CAMERA_JSI_SOURCES
+        ${CMAKE_CURRENT_LIST_DIR}/BufferPoolBindings.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/CroppedFrameHostObject.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameHostObjectBase.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameProcessorPluginRegistryNative.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameProcessorStatsBindings.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FramePropertyCache.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/ParallelPluginRunner.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/FrameTracerBindings.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/PropNameIDCache.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/TypedArrays.cpp
+)
@@ -0,0 +1,154 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "FrameTracer.h"
+
+namespace vision {
+
+namespace {
+
+struct Batch {
+  std::mutex mutex;
+  std::condition_variable condition;
+  // only changed while holding `mutex`, so the waiting thread can't return (and destroy the Batch) while a worker still notifies it.
+  size_t remaining;
+};
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t workersCount, WorkerRunner runner) {
+  for (size_t i = 0; i < std::max(workersCount, static_cast<size_t>(1)); i++) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < workers_.size(); i++) {
+    workers_[i]->thread = std::thread([this, runner, i]() {
+      if (runner != nullptr) {
+        runner([&]() { runWorker(i); });
+      } else {
+        runWorker(i);
+      }
+    });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::unique_lock lock(mutex_);
+    isStopped_ = true;
+  }
+  condition_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void WorkStealingPool::run(std::vector<Task> tasks, const std::function<void()>& onCallingThread) {
+  Batch batch;
+  batch.remaining = tasks.size();
+
+  if (!tasks.empty()) {
+    {
+      // counted before they are pushed, so a worker that takes one never sees the count drop below 0.
+      // Pairs with the wait in runWorker(): a worker either sees the new tasks, or is woken up.
+      std::unique_lock lock(mutex_);
+      queued_.fetch_add(tasks.size(), std::memory_order_seq_cst);
+    }
+    // spread the batch across the deques, starting at a different worker every time so concurrent batches don't pile up on worker 0.
+    auto first = nextWorker_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < tasks.size(); i++) {
+      auto& worker = *workers_[(first + i) % workers_.size()];
+      std::unique_lock lock(worker.mutex);
+      worker.tasks.push_back([task = std::move(tasks[i]), &batch]() {
+        task();
+        std::unique_lock batchLock(batch.mutex);
+        if (--batch.remaining == 0) {
+          batch.condition.notify_all();
+        }
+      });
+    }
+    condition_.notify_all();
+  }
+
+  std::exception_ptr error;
+  if (onCallingThread != nullptr) {
+    try {
+      onCallingThread();
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  // help instead of waiting. This might also run a task of another batch, which is fine: it has to run anyways.
+  Task task;
+  auto start = nextWorker_.load(std::memory_order_relaxed);
+  while (true) {
+    {
+      std::unique_lock lock(batch.mutex);
+      if (batch.remaining == 0) {
+        break;
+      }
+    }
+    if (!tryTake(start, task)) {
+      // everything of this batch is running on the workers already.
+      std::unique_lock lock(batch.mutex);
+      batch.condition.wait(lock, [&]() { return batch.remaining == 0; });
+      break;
+    }
+    task();
+    task = nullptr;
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool WorkStealingPool::tryTake(size_t index, Task& task) {
+  for (size_t i = 0; i < workers_.size(); i++) {
+    auto& worker = *workers_[(index + i) % workers_.size()];
+    std::unique_lock lock(worker.mutex);
+    if (worker.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      // our own deque, newest first: it's the most likely to still be in the cache.
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    } else {
+      // steal the oldest one, the owner keeps working on its newest.
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+    }
+    queued_.fetch_sub(1, std::memory_order_seq_cst);
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingPool::runWorker(size_t index) {
+  FrameTracer::shared().setThreadName("Plugin Worker " + std::to_string(index + 1));
+  Task task;
+  while (true) {
+    if (tryTake(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [&]() { return queued_.load(std::memory_order_seq_cst) > 0 || isStopped_; });
+    if (isStopped_ && queued_.load(std::memory_order_seq_cst) == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace vision
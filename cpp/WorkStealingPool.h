@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TaskScheduler.h"
+
+namespace vision {
+
+/**
+ * Runs batches of independent tasks (e.g. the plugin calls of one `runParallel()`) on a fixed set of worker threads,
+ * and returns once the whole batch ran.
+ *
+ * Every worker has its own deque: a batch is spread across the deques, a worker takes its own tasks from the back
+ * and steals from the front of the others once its deque is empty. The thread that waits for a batch steals too,
+ * so a batch of n tasks keeps n threads busy with n - 1 workers, and never waits behind an idle pool.
+ */
+class WorkStealingPool {
+ public:
+  using Task = std::function<void()>;
+  using WorkerRunner = TaskScheduler::WorkerRunner;
+
+  explicit WorkStealingPool(size_t workersCount, WorkerRunner runner = nullptr);
+  /**
+   * Runs all tasks that have been submitted so far, then stops the workers.
+   */
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  /**
+   * Runs all `tasks` on the workers and returns once every one of them ran. Can be called from multiple threads at once.
+   *
+   * `onCallingThread` (if given) runs on the calling thread while the workers are busy with `tasks`, e.g. for work that must
+   * stay on the calling thread. Afterwards the calling thread helps with the tasks that are still queued.
+   * If `onCallingThread` throws, the error is rethrown once all `tasks` ran. `tasks` must not throw.
+   */
+  void run(std::vector<Task> tasks, const std::function<void()>& onCallingThread = nullptr);
+
+  size_t size() const { return workers_.size(); }
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void runWorker(size_t index);
+  /**
+   * Takes a task from the back of the deque of `index`, or steals one from the front of another deque.
+   */
+  bool tryTake(size_t index, Task& task); // NOLINT(runtime/references)
+
+ private:
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // tasks in all deques, the workers sleep while it is 0.
+  std::atomic<size_t> queued_ { 0 };
+  std::atomic<size_t> nextWorker_ { 0 };
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool isStopped_ = false;
+};
+
+} // namespace vision
@@ -0,0 +1,233 @@
+#include "FrameToTensor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "YUVToRGBRow.h"
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+/**
+ * The two source pixels (and the weight of the second one) a target pixel is interpolated from, along one axis.
+ */
+struct BilinearTap {
+  int first;
+  int second;
+  float weight;
+};
+
+/**
+ * The range of source pixels [begin, end) a target pixel is averaged from, along one axis.
+ */
+struct AreaTap {
+  int begin;
+  int end;
+};
+
+// `subsampling` is 2 for the chroma planes of a 4:2:0 Frame. Taps are computed in (sub-sampled) plane coordinates.
+void buildTaps(int cropBegin, int cropSize, int dstSize, int subsampling, std::vector<BilinearTap>& taps) { // NOLINT(runtime/references)
+  float scale = static_cast<float>(cropSize) / dstSize;
+  float low = static_cast<float>(cropBegin / subsampling);
+  int high = (cropBegin + cropSize - 1) / subsampling;
+
+  taps.resize(dstSize);
+  for (int i = 0; i < dstSize; i++) {
+    // sample at the center of the target pixel, pixel centers are at +0.5.
+    float center = cropBegin + (i + 0.5f) * scale;
+    float position = std::min(std::max(center / subsampling - 0.5f, low), static_cast<float>(high));
+    int first = static_cast<int>(position);
+    taps[i] = { first, std::min(first + 1, high), position - first };
+  }
+}
+
+void buildTaps(int cropBegin, int cropSize, int dstSize, int subsampling, std::vector<AreaTap>& taps) { // NOLINT(runtime/references)
+  double scale = static_cast<double>(cropSize) / dstSize;
+
+  taps.resize(dstSize);
+  for (int i = 0; i < dstSize; i++) {
+    int begin = static_cast<int>(i * scale);
+    // when upscaling, a target pixel covers less than one source pixel - it still has to sample one.
+    int end = std::min(std::max(static_cast<int>((i + 1) * scale), begin + 1), cropSize);
+    taps[i] = { (cropBegin + begin) / subsampling, (cropBegin + end + subsampling - 1) / subsampling };
+  }
+}
+
+inline float sample(const uint8_t* plane, size_t rowStride, int pixelStride, const BilinearTap& x, const BilinearTap& y) {
+  const uint8_t* row0 = plane + y.first * rowStride;
+  const uint8_t* row1 = plane + y.second * rowStride;
+  float top = row0[x.first * pixelStride] + (row0[x.second * pixelStride] - row0[x.first * pixelStride]) * x.weight;
+  float bottom = row1[x.first * pixelStride] + (row1[x.second * pixelStride] - row1[x.first * pixelStride]) * x.weight;
+  return top + (bottom - top) * y.weight;
+}
+
+inline float sample(const uint8_t* plane, size_t rowStride, int pixelStride, const AreaTap& x, const AreaTap& y) {
+  uint64_t sum = 0;
+  for (int row = y.begin; row < y.end; row++) {
+    const uint8_t* pixel = plane + row * rowStride + x.begin * pixelStride;
+    for (int column = x.begin; column < x.end; column++) {
+      sum += *pixel;
+      pixel += pixelStride;
+    }
+  }
+  return static_cast<float>(sum) / ((x.end - x.begin) * (y.end - y.begin));
+}
+
+inline float clampToChannel(float value) {
+  return std::min(std::max(value, 0.0f), 255.0f);
+}
+
+template <typename T>
+inline T quantize(float value);
+
+template <>
+inline float quantize<float>(float value) {
+  return value;
+}
+
+template <>
+inline uint8_t quantize<uint8_t>(float value) {
+  return static_cast<uint8_t>(std::min(std::max(std::nearbyint(value), 0.0f), 255.0f));
+}
+
+template <>
+inline int8_t quantize<int8_t>(float value) {
+  return static_cast<int8_t>(std::min(std::max(std::nearbyint(value), -128.0f), 127.0f));
+}
+
+/**
+ * Normalizes and writes RGB pixels into the tensor's layout.
+ */
+template <typename T>
+class TensorWriter {
+ public:
+  TensorWriter(void* dst, const TensorOptions& options): data_(static_cast<T*>(dst)) {
+    size_t pixelsCount = static_cast<size_t>(options.width) * options.height;
+    bool isInterleaved = options.layout == TensorLayout::NHWC;
+    pixelStride_ = isInterleaved ? kTensorChannels : 1;
+    channelStride_ = isInterleaved ? 1 : pixelsCount;
+    swapRedBlue_ = options.channelOrder == RGBFormat::BGR;
+    for (size_t i = 0; i < kTensorChannels; i++) {
+      mean_[i] = options.mean[i];
+      scale_[i] = 1.0f / options.std[i];
+    }
+  }
+
+  inline void write(size_t pixelIndex, float r, float g, float b) {
+    if (swapRedBlue_) {
+      std::swap(r, b);
+    }
+    T* out = data_ + pixelIndex * pixelStride_;
+    out[0] = quantize<T>((r - mean_[0]) * scale_[0]);
+    out[channelStride_] = quantize<T>((g - mean_[1]) * scale_[1]);
+    out[2 * channelStride_] = quantize<T>((b - mean_[2]) * scale_[2]);
+  }
+
+ private:
+  T* data_;
+  size_t pixelStride_;
+  size_t channelStride_;
+  bool swapRedBlue_;
+  float mean_[kTensorChannels];
+  float scale_[kTensorChannels];
+};
+
+template <typename Tap, typename T>
+void convertYUVToTensor(const YUVImage& image, const TensorOptions& options, TensorWriter<T>& writer) { // NOLINT(runtime/references)
+  const auto& crop = options.crop;
+  std::vector<Tap> xTaps, yTaps, chromaXTaps, chromaYTaps;
+  buildTaps(crop.x, crop.width, options.width, 1, xTaps);
+  buildTaps(crop.y, crop.height, options.height, 1, yTaps);
+  buildTaps(crop.x, crop.width, options.width, 2, chromaXTaps);
+  buildTaps(crop.y, crop.height, options.height, 2, chromaYTaps);
+
+  // the same coefficients as toRGB(), so both produce the same colors.
+  auto c = getYUVCoefficients(image.colorRange);
+  constexpr float kScale = 1.0f / (1 << kYUVShift);
+  const float yScale = c.yScale * kScale, vr = c.vr * kScale, ug = c.ug * kScale, vg = c.vg * kScale, ub = c.ub * kScale;
+
+  size_t pixelIndex = 0;
+  for (int row = 0; row < options.height; row++) {
+    const auto& yTap = yTaps[row];
+    const auto& chromaYTap = chromaYTaps[row];
+    for (int column = 0; column < options.width; column++) {
+      float Y = sample(image.y, image.yRowStride, 1, xTaps[column], yTap);
+      float U = sample(image.u, image.uvRowStride, image.uvPixelStride, chromaXTaps[column], chromaYTap) - 128.0f;
+      float V = sample(image.v, image.uvRowStride, image.uvPixelStride, chromaXTaps[column], chromaYTap) - 128.0f;
+
+      float luma = (Y - c.yOffset) * yScale;
+      writer.write(pixelIndex++, clampToChannel(luma + vr * V), clampToChannel(luma - ug * U - vg * V), clampToChannel(luma + ub * U));
+    }
+  }
+}
+
+template <typename Tap, typename T>
+void convertPackedToTensor(const PlaneDescriptor& plane, bool isBGRA, const TensorOptions& options,
+                           TensorWriter<T>& writer) { // NOLINT(runtime/references)
+  const auto& crop = options.crop;
+  std::vector<Tap> xTaps, yTaps;
+  buildTaps(crop.x, crop.width, options.width, 1, xTaps);
+  buildTaps(crop.y, crop.height, options.height, 1, yTaps);
+
+  const uint8_t* red = plane.data + (isBGRA ? 2 : 0);
+  const uint8_t* green = plane.data + 1;
+  const uint8_t* blue = plane.data + (isBGRA ? 0 : 2);
+  const size_t rowStride = plane.rowStride;
+
+  size_t pixelIndex = 0;
+  for (int row = 0; row < options.height; row++) {
+    const auto& yTap = yTaps[row];
+    for (int column = 0; column < options.width; column++) {
+      const auto& xTap = xTaps[column];
+      writer.write(pixelIndex++, sample(red, rowStride, 4, xTap, yTap), sample(green, rowStride, 4, xTap, yTap),
+                   sample(blue, rowStride, 4, xTap, yTap));
+    }
+  }
+}
+
+template <typename Tap, typename T>
+bool convert(const FrameDescriptor& descriptor, const TensorOptions& options, void* dst) {
+  TensorWriter<T> writer(dst, options);
+
+  YUVImage image;
+  if (describeYUVImage(descriptor, image)) {
+    convertYUVToTensor<Tap>(image, options, writer);
+    return true;
+  }
+  if ((descriptor.pixelFormat == PixelFormat::RGBA_8888 || descriptor.pixelFormat == PixelFormat::BGRA_8888) &&
+      descriptor.planesCount > 0) {
+    convertPackedToTensor<Tap>(descriptor.planes[0], descriptor.pixelFormat == PixelFormat::BGRA_8888, options, writer);
+    return true;
+  }
+  return false;
+}
+
+template <typename Tap>
+bool convert(const FrameDescriptor& descriptor, const TensorOptions& options, void* dst) {
+  switch (options.dataType) {
+    case TensorDataType::UInt8:
+      return convert<Tap, uint8_t>(descriptor, options, dst);
+    case TensorDataType::Int8:
+      return convert<Tap, int8_t>(descriptor, options, dst);
+    case TensorDataType::Float32:
+    default:
+      return convert<Tap, float>(descriptor, options, dst);
+  }
+}
+
+} // namespace
+
+bool convertFrameToTensor(const FrameDescriptor& descriptor, const TensorOptions& options, void* dst) {
+  if (options.resizeMode == ResizeMode::Area) {
+    return convert<AreaTap>(descriptor, options, dst);
+  }
+  return convert<BilinearTap>(descriptor, options, dst);
+}
+
+} // namespace kernels
+} // namespace vision
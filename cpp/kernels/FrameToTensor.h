@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../FrameDescriptor.h"
+#include "YUVToRGB.h"
+
+namespace vision {
+namespace kernels {
+
+enum class TensorLayout {
+  // [height][width][channels]
+  NHWC,
+  // [channels][height][width]
+  NCHW,
+};
+
+enum class TensorDataType {
+  Float32,
+  UInt8,
+  Int8,
+};
+
+enum class ResizeMode {
+  // samples the 2x2 nearest source pixels, best for upscaling and small downscales
+  Bilinear,
+  // averages all source pixels covered by the target pixel, avoids aliasing for large downscales
+  Area,
+};
+
+struct CropRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+struct TensorOptions {
+  // the size of the output tensor, in pixels
+  int width = 0;
+  int height = 0;
+  // the region of the source Frame to use, in source pixels
+  CropRect crop;
+  TensorLayout layout = TensorLayout::NHWC;
+  TensorDataType dataType = TensorDataType::Float32;
+  // only RGB and BGR are supported, tensors never have an alpha channel
+  RGBFormat channelOrder = RGBFormat::RGB;
+  ResizeMode resizeMode = ResizeMode::Bilinear;
+  // every channel is written as (value - mean) / std, where value is in the range 0...255.
+  // the values are in the order of the output channels.
+  std::array<float, 3> mean = { 0.0f, 0.0f, 0.0f };
+  std::array<float, 3> std = { 1.0f, 1.0f, 1.0f };
+};
+
+constexpr size_t kTensorChannels = 3;
+
+inline size_t bytesPerElement(TensorDataType dataType) {
+  return dataType == TensorDataType::Float32 ? sizeof(float) : 1;
+}
+
+inline size_t getTensorByteSize(const TensorOptions& options) {
+  return static_cast<size_t>(options.width) * options.height * kTensorChannels * bytesPerElement(options.dataType);
+}
+
+/**
+ * Crops, resizes, converts and normalizes the Frame into a tensor in a single pass over the source planes.
+ *
+ * `dst` must hold at least `getTensorByteSize(options)` bytes, and the crop rect must lie within the Frame.
+ * Integer tensors are rounded and saturated to their range after normalization.
+ * Returns false if the Frame's pixel format is not supported.
+ */
+bool convertFrameToTensor(const FrameDescriptor& descriptor, const TensorOptions& options, void* dst);
+
+} // namespace kernels
+} // namespace vision
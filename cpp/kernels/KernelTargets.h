@@ -0,0 +1,16 @@
+#pragma once
+
+// Which SIMD kernels are compiled in, shared by all kernels.
+//
+// The x86 kernels are compiled with target attributes instead of global -m flags, so the rest of the library
+// still runs on CPUs without SSE4.1/AVX2. They are only called after a runtime CPU check, see isKernelImplementationSupported().
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VISION_KERNELS_X86 1
+#define VISION_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define VISION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VISION_KERNELS_NEON 1
+#endif
@@ -0,0 +1,168 @@
+#include "LumaChange.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "KernelTargets.h"
+
+#if VISION_KERNELS_X86
+#include <immintrin.h>
+#endif
+#if VISION_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+/**
+ * The first pixel of the cell at grid column `column`, so that the cell is centered but stays within the row.
+ */
+inline int getCellStart(int column, int gridWidth, int width) {
+  int center = static_cast<int>((2LL * column + 1) * width / (2LL * gridWidth));
+  return std::clamp(center - kLumaGridCellWidth / 2, 0, width - kLumaGridCellWidth);
+}
+
+inline const uint8_t* getGridRow(const uint8_t* y, int yRowStride, int height, int row, int gridHeight) {
+  auto sourceRow = static_cast<int>((2LL * row + 1) * height / (2LL * gridHeight));
+  return y + static_cast<size_t>(sourceRow) * yRowStride;
+}
+
+void sampleLumaGridScalar(const uint8_t* y, int yRowStride, int width, int height, int gridWidth, int gridHeight, uint8_t* grid) {
+  for (int row = 0; row < gridHeight; row++) {
+    const uint8_t* source = getGridRow(y, yRowStride, height, row, gridHeight);
+    for (int column = 0; column < gridWidth; column++) {
+      const uint8_t* cell = source + getCellStart(column, gridWidth, width);
+      int sum = 0;
+      for (int i = 0; i < kLumaGridCellWidth; i++) {
+        sum += cell[i];
+      }
+      *grid++ = static_cast<uint8_t>((sum + kLumaGridCellWidth / 2) / kLumaGridCellWidth);
+    }
+  }
+}
+
+uint64_t sumOfAbsoluteDifferencesScalar(const uint8_t* a, const uint8_t* b, size_t size) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < size; i++) {
+    sum += static_cast<uint64_t>(std::abs(a[i] - b[i]));
+  }
+  return sum;
+}
+
+#if VISION_KERNELS_X86
+
+VISION_TARGET_SSE41 void sampleLumaGridSSE41(const uint8_t* y, int yRowStride, int width, int height, int gridWidth, int gridHeight,
+                                             uint8_t* grid) {
+  const __m128i zero = _mm_setzero_si128();
+  for (int row = 0; row < gridHeight; row++) {
+    const uint8_t* source = getGridRow(y, yRowStride, height, row, gridHeight);
+    for (int column = 0; column < gridWidth; column++) {
+      __m128i cell = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + getCellStart(column, gridWidth, width)));
+      // the SAD against zero sums up each half of the 16 bytes into a 64-bit lane
+      __m128i sums = _mm_sad_epu8(cell, zero);
+      int sum = _mm_cvtsi128_si32(sums) + _mm_extract_epi32(sums, 2);
+      *grid++ = static_cast<uint8_t>((sum + kLumaGridCellWidth / 2) / kLumaGridCellWidth);
+    }
+  }
+}
+
+VISION_TARGET_SSE41 uint64_t sumOfAbsoluteDifferencesSSE41(const uint8_t* a, const uint8_t* b, size_t size) {
+  __m128i sums = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    sums = _mm_add_epi64(sums, _mm_sad_epu8(va, vb));
+  }
+  auto sum = static_cast<uint64_t>(_mm_cvtsi128_si64(sums)) + static_cast<uint64_t>(_mm_extract_epi64(sums, 1));
+  return sum + sumOfAbsoluteDifferencesScalar(a + i, b + i, size - i);
+}
+
+VISION_TARGET_AVX2 uint64_t sumOfAbsoluteDifferencesAVX2(const uint8_t* a, const uint8_t* b, size_t size) {
+  __m256i sums = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(va, vb));
+  }
+  __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+  auto sum = static_cast<uint64_t>(_mm_cvtsi128_si64(halves)) + static_cast<uint64_t>(_mm_extract_epi64(halves, 1));
+  return sum + sumOfAbsoluteDifferencesScalar(a + i, b + i, size - i);
+}
+
+#endif
+
+#if VISION_KERNELS_NEON
+
+inline uint64_t addLanes(uint32x4_t value) {
+  uint64x2_t pairs = vpaddlq_u32(value);
+  return vgetq_lane_u64(pairs, 0) + vgetq_lane_u64(pairs, 1);
+}
+
+void sampleLumaGridNEON(const uint8_t* y, int yRowStride, int width, int height, int gridWidth, int gridHeight, uint8_t* grid) {
+  for (int row = 0; row < gridHeight; row++) {
+    const uint8_t* source = getGridRow(y, yRowStride, height, row, gridHeight);
+    for (int column = 0; column < gridWidth; column++) {
+      uint8x16_t cell = vld1q_u8(source + getCellStart(column, gridWidth, width));
+      auto sum = static_cast<int>(addLanes(vpaddlq_u16(vpaddlq_u8(cell))));
+      *grid++ = static_cast<uint8_t>((sum + kLumaGridCellWidth / 2) / kLumaGridCellWidth);
+    }
+  }
+}
+
+uint64_t sumOfAbsoluteDifferencesNEON(const uint8_t* a, const uint8_t* b, size_t size) {
+  uint32x4_t sums = vdupq_n_u32(0);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    uint8x16_t differences = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+    sums = vpadalq_u16(sums, vpaddlq_u8(differences));
+  }
+  return addLanes(sums) + sumOfAbsoluteDifferencesScalar(a + i, b + i, size - i);
+}
+
+#endif
+
+} // namespace
+
+void sampleLumaGrid(const uint8_t* y, int yRowStride, int width, int height, int gridWidth, int gridHeight, uint8_t* grid,
+                    KernelImplementation implementation) {
+  switch (resolveKernelImplementation(implementation)) {
+#if VISION_KERNELS_X86
+    // a cell is exactly one 16-byte vector, so AVX2 has nothing to add here.
+    case KernelImplementation::AVX2:
+    case KernelImplementation::SSE41:
+      return sampleLumaGridSSE41(y, yRowStride, width, height, gridWidth, gridHeight, grid);
+#endif
+#if VISION_KERNELS_NEON
+    case KernelImplementation::NEON:
+      return sampleLumaGridNEON(y, yRowStride, width, height, gridWidth, gridHeight, grid);
+#endif
+    default:
+      return sampleLumaGridScalar(y, yRowStride, width, height, gridWidth, gridHeight, grid);
+  }
+}
+
+uint64_t sumOfAbsoluteDifferences(const uint8_t* a, const uint8_t* b, size_t size, KernelImplementation implementation) {
+  switch (resolveKernelImplementation(implementation)) {
+#if VISION_KERNELS_X86
+    case KernelImplementation::AVX2:
+      return sumOfAbsoluteDifferencesAVX2(a, b, size);
+    case KernelImplementation::SSE41:
+      return sumOfAbsoluteDifferencesSSE41(a, b, size);
+#endif
+#if VISION_KERNELS_NEON
+    case KernelImplementation::NEON:
+      return sumOfAbsoluteDifferencesNEON(a, b, size);
+#endif
+    default:
+      return sumOfAbsoluteDifferencesScalar(a, b, size);
+  }
+}
+
+} // namespace kernels
+} // namespace vision
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "YUVToRGB.h"
+
+namespace vision {
+namespace kernels {
+
+// every cell of a luma grid is the average of this many horizontally adjacent pixels
+constexpr int kLumaGridCellWidth = 16;
+
+/**
+ * Samples a `gridWidth` x `gridHeight` grid of luma values from a Y plane, e.g. to compare two Frames cheaply.
+ *
+ * Every cell is the average of kLumaGridCellWidth horizontally adjacent pixels at the cell's center, which averages out
+ * most of the sensor noise while only reading a fraction of the plane.
+ * `grid` must hold `gridWidth * gridHeight` bytes. The plane must be at least kLumaGridCellWidth pixels wide.
+ */
+void sampleLumaGrid(const uint8_t* y, int yRowStride, int width, int height, int gridWidth, int gridHeight, uint8_t* grid,
+                    KernelImplementation implementation = KernelImplementation::Auto);
+
+/**
+ * Returns the sum of absolute differences of two byte arrays of `size` bytes each.
+ */
+uint64_t sumOfAbsoluteDifferences(const uint8_t* a, const uint8_t* b, size_t size,
+                                  KernelImplementation implementation = KernelImplementation::Auto);
+
+} // namespace kernels
+} // namespace vision
@@ -0,0 +1,331 @@
+#include "LumaStatistics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "KernelTargets.h"
+
+#if VISION_KERNELS_X86
+#include <immintrin.h>
+#endif
+#if VISION_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+struct PixelSums {
+  uint64_t sum = 0;
+  uint64_t squares = 0;
+};
+
+struct LaplacianSums {
+  int64_t sum = 0;
+  uint64_t squares = 0;
+};
+
+using SumRowFunction = PixelSums (*)(const uint8_t* row, int count);
+// sums up the Laplacian of the inner pixels of `row`, with `above` and `below` being its neighbouring rows.
+using LaplacianRowFunction = void (*)(const uint8_t* above, const uint8_t* row, const uint8_t* below, int width, LaplacianSums& sums);
+
+PixelSums sumRowScalar(const uint8_t* row, int count) {
+  PixelSums sums;
+  for (int i = 0; i < count; i++) {
+    sums.sum += row[i];
+    sums.squares += static_cast<uint32_t>(row[i]) * row[i];
+  }
+  return sums;
+}
+
+inline void laplacianScalar(const uint8_t* above, const uint8_t* row, const uint8_t* below, int from, int to, LaplacianSums& sums) {
+  for (int x = from; x < to; x++) {
+    int laplacian = above[x] + below[x] + row[x - 1] + row[x + 1] - 4 * row[x];
+    sums.sum += laplacian;
+    sums.squares += static_cast<uint64_t>(laplacian * laplacian);
+  }
+}
+
+void laplacianRowScalar(const uint8_t* above, const uint8_t* row, const uint8_t* below, int width, LaplacianSums& sums) {
+  laplacianScalar(above, row, below, 1, width - 1, sums);
+}
+
+/**
+ * Scattered increments don't vectorize, so the histogram stays scalar - but every 4th pixel goes into its own histogram,
+ * so runs of equal pixels don't stall on incrementing the same counter over and over.
+ */
+void countRow(const uint8_t* row, int width, uint32_t (*histograms)[kLumaHistogramBins]) {
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    histograms[0][row[x]]++;
+    histograms[1][row[x + 1]]++;
+    histograms[2][row[x + 2]]++;
+    histograms[3][row[x + 3]]++;
+  }
+  for (; x < width; x++) {
+    histograms[0][row[x]]++;
+  }
+}
+
+#if VISION_KERNELS_X86
+
+VISION_TARGET_SSE41 PixelSums sumRowSSE41(const uint8_t* row, int count) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sums = _mm_setzero_si128();
+  // a lane grows by at most 4 * 255^2 per iteration, so 32 bits are enough for 65536 pixels.
+  __m128i squares = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+    sums = _mm_add_epi64(sums, _mm_sad_epu8(pixels, zero));
+    __m128i low = _mm_cvtepu8_epi16(pixels);
+    __m128i high = _mm_unpackhi_epi8(pixels, zero);
+    squares = _mm_add_epi32(squares, _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high)));
+  }
+  squares = _mm_add_epi32(squares, _mm_srli_si128(squares, 8));
+  squares = _mm_add_epi32(squares, _mm_srli_si128(squares, 4));
+  PixelSums result = sumRowScalar(row + i, count - i);
+  result.sum += static_cast<uint64_t>(_mm_cvtsi128_si64(sums)) + static_cast<uint64_t>(_mm_extract_epi64(sums, 1));
+  result.squares += static_cast<uint32_t>(_mm_cvtsi128_si32(squares));
+  return result;
+}
+
+VISION_TARGET_SSE41 void laplacianRowSSE41(const uint8_t* above, const uint8_t* row, const uint8_t* below, int width,
+                                           LaplacianSums& sums) {
+  const __m128i ones = _mm_set1_epi16(1);
+  __m128i laplacianSums = _mm_setzero_si128();
+  __m128i squares = _mm_setzero_si128();
+  int x = 1;
+  // 8 pixels per iteration, the last one reads its right neighbour at x + 8.
+  for (; x + 9 <= width; x += 8) {
+    __m128i center = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x)));
+    __m128i left = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x - 1)));
+    __m128i right = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x + 1)));
+    __m128i up = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(above + x)));
+    __m128i down = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(below + x)));
+    __m128i neighbours = _mm_add_epi16(_mm_add_epi16(left, right), _mm_add_epi16(up, down));
+    __m128i laplacian = _mm_sub_epi16(neighbours, _mm_slli_epi16(center, 2));
+    laplacianSums = _mm_add_epi32(laplacianSums, _mm_madd_epi16(laplacian, ones));
+    // a squared pair can reach 2 * 1020^2, so the squares are widened to 64 bits right away.
+    __m128i squared = _mm_madd_epi16(laplacian, laplacian);
+    squares = _mm_add_epi64(squares, _mm_add_epi64(_mm_cvtepu32_epi64(squared), _mm_cvtepu32_epi64(_mm_srli_si128(squared, 8))));
+  }
+  laplacianSums = _mm_add_epi32(laplacianSums, _mm_srli_si128(laplacianSums, 8));
+  laplacianSums = _mm_add_epi32(laplacianSums, _mm_srli_si128(laplacianSums, 4));
+  sums.sum += _mm_cvtsi128_si32(laplacianSums);
+  sums.squares += static_cast<uint64_t>(_mm_cvtsi128_si64(squares)) + static_cast<uint64_t>(_mm_extract_epi64(squares, 1));
+  laplacianScalar(above, row, below, x, width - 1, sums);
+}
+
+VISION_TARGET_AVX2 PixelSums sumRowAVX2(const uint8_t* row, int count) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sums = _mm256_setzero_si256();
+  __m256i squares = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(pixels, zero));
+    __m256i low = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(pixels));
+    __m256i high = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(pixels, 1));
+    squares = _mm256_add_epi32(squares, _mm256_add_epi32(_mm256_madd_epi16(low, low), _mm256_madd_epi16(high, high)));
+  }
+  __m128i sumHalves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+  __m128i squareHalves = _mm_add_epi32(_mm256_castsi256_si128(squares), _mm256_extracti128_si256(squares, 1));
+  squareHalves = _mm_add_epi32(squareHalves, _mm_srli_si128(squareHalves, 8));
+  squareHalves = _mm_add_epi32(squareHalves, _mm_srli_si128(squareHalves, 4));
+  PixelSums result = sumRowScalar(row + i, count - i);
+  result.sum += static_cast<uint64_t>(_mm_cvtsi128_si64(sumHalves)) + static_cast<uint64_t>(_mm_extract_epi64(sumHalves, 1));
+  result.squares += static_cast<uint32_t>(_mm_cvtsi128_si32(squareHalves));
+  return result;
+}
+
+VISION_TARGET_AVX2 void laplacianRowAVX2(const uint8_t* above, const uint8_t* row, const uint8_t* below, int width,
+                                         LaplacianSums& sums) {
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i laplacianSums = _mm256_setzero_si256();
+  __m256i squares = _mm256_setzero_si256();
+  int x = 1;
+  for (; x + 17 <= width; x += 16) {
+    __m256i center = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x)));
+    __m256i left = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x - 1)));
+    __m256i right = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x + 1)));
+    __m256i up = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x)));
+    __m256i down = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(below + x)));
+    __m256i neighbours = _mm256_add_epi16(_mm256_add_epi16(left, right), _mm256_add_epi16(up, down));
+    __m256i laplacian = _mm256_sub_epi16(neighbours, _mm256_slli_epi16(center, 2));
+    laplacianSums = _mm256_add_epi32(laplacianSums, _mm256_madd_epi16(laplacian, ones));
+    __m256i squared = _mm256_madd_epi16(laplacian, laplacian);
+    squares = _mm256_add_epi64(squares, _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(squared)),
+                                                         _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squared, 1))));
+  }
+  __m128i sumHalves = _mm_add_epi32(_mm256_castsi256_si128(laplacianSums), _mm256_extracti128_si256(laplacianSums, 1));
+  sumHalves = _mm_add_epi32(sumHalves, _mm_srli_si128(sumHalves, 8));
+  sumHalves = _mm_add_epi32(sumHalves, _mm_srli_si128(sumHalves, 4));
+  __m128i squareHalves = _mm_add_epi64(_mm256_castsi256_si128(squares), _mm256_extracti128_si256(squares, 1));
+  sums.sum += _mm_cvtsi128_si32(sumHalves);
+  sums.squares += static_cast<uint64_t>(_mm_cvtsi128_si64(squareHalves)) + static_cast<uint64_t>(_mm_extract_epi64(squareHalves, 1));
+  laplacianScalar(above, row, below, x, width - 1, sums);
+}
+
+#endif
+
+#if VISION_KERNELS_NEON
+
+inline uint64_t addLanes(uint32x4_t value) {
+  uint64x2_t pairs = vpaddlq_u32(value);
+  return vgetq_lane_u64(pairs, 0) + vgetq_lane_u64(pairs, 1);
+}
+
+PixelSums sumRowNEON(const uint8_t* row, int count) {
+  uint32x4_t sums = vdupq_n_u32(0);
+  uint32x4_t squares = vdupq_n_u32(0);
+  int i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint8x16_t pixels = vld1q_u8(row + i);
+    sums = vpadalq_u16(sums, vpaddlq_u8(pixels));
+    // 255^2 still fits into 16 bits
+    squares = vpadalq_u16(squares, vmull_u8(vget_low_u8(pixels), vget_low_u8(pixels)));
+    squares = vpadalq_u16(squares, vmull_u8(vget_high_u8(pixels), vget_high_u8(pixels)));
+  }
+  PixelSums result = sumRowScalar(row + i, count - i);
+  result.sum += addLanes(sums);
+  result.squares += addLanes(squares);
+  return result;
+}
+
+void laplacianRowNEON(const uint8_t* above, const uint8_t* row, const uint8_t* below, int width, LaplacianSums& sums) {
+  int32x4_t laplacianSums = vdupq_n_s32(0);
+  int64x2_t squares = vdupq_n_s64(0);
+  int x = 1;
+  for (; x + 9 <= width; x += 8) {
+    int16x8_t center = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row + x)));
+    uint16x8_t horizontal = vaddl_u8(vld1_u8(row + x - 1), vld1_u8(row + x + 1));
+    uint16x8_t vertical = vaddl_u8(vld1_u8(above + x), vld1_u8(below + x));
+    int16x8_t neighbours = vreinterpretq_s16_u16(vaddq_u16(horizontal, vertical));
+    int16x8_t laplacian = vsubq_s16(neighbours, vshlq_n_s16(center, 2));
+    laplacianSums = vpadalq_s16(laplacianSums, laplacian);
+    squares = vpadalq_s32(squares, vmull_s16(vget_low_s16(laplacian), vget_low_s16(laplacian)));
+    squares = vpadalq_s32(squares, vmull_s16(vget_high_s16(laplacian), vget_high_s16(laplacian)));
+  }
+  int64x2_t pairs = vpaddlq_s32(laplacianSums);
+  sums.sum += vgetq_lane_s64(pairs, 0) + vgetq_lane_s64(pairs, 1);
+  sums.squares += static_cast<uint64_t>(vgetq_lane_s64(squares, 0) + vgetq_lane_s64(squares, 1));
+  laplacianScalar(above, row, below, x, width - 1, sums);
+}
+
+#endif
+
+struct RowKernels {
+  SumRowFunction sumRow;
+  LaplacianRowFunction laplacianRow;
+};
+
+RowKernels getRowKernels(KernelImplementation implementation) {
+  switch (resolveKernelImplementation(implementation)) {
+#if VISION_KERNELS_X86
+    case KernelImplementation::AVX2:
+      return {sumRowAVX2, laplacianRowAVX2};
+    case KernelImplementation::SSE41:
+      return {sumRowSSE41, laplacianRowSSE41};
+#endif
+#if VISION_KERNELS_NEON
+    case KernelImplementation::NEON:
+      return {sumRowNEON, laplacianRowNEON};
+#endif
+    default:
+      return {sumRowScalar, laplacianRowScalar};
+  }
+}
+
+inline double getVariance(double sum, double squares, double count) {
+  double mean = sum / count;
+  // rounding can make a flat region's variance slightly negative
+  return std::max(squares / count - mean * mean, 0.0);
+}
+
+} // namespace
+
+LumaStatistics computeLumaStatistics(const uint8_t* y, int yRowStride, int width, int height, const LumaStatisticsOptions& options,
+                                     KernelImplementation implementation) {
+  RowKernels kernels = getRowKernels(implementation);
+  bool hasGrid = options.gridMean != nullptr || options.gridVariance != nullptr;
+  int columns = hasGrid ? options.gridColumns : 1;
+  int rows = hasGrid ? options.gridRows : 1;
+
+  std::vector<int> cellStarts(columns + 1);
+  for (int column = 0; column <= columns; column++) {
+    cellStarts[column] = static_cast<int>(static_cast<int64_t>(column) * width / columns);
+  }
+  std::vector<int> cellRowStarts(rows + 1);
+  for (int row = 0; row <= rows; row++) {
+    cellRowStarts[row] = static_cast<int>(static_cast<int64_t>(row) * height / rows);
+  }
+  std::vector<PixelSums> cells(static_cast<size_t>(columns) * rows);
+  uint32_t histograms[4][kLumaHistogramBins];
+  if (options.histogram != nullptr) {
+    std::memset(histograms, 0, sizeof(histograms));
+  }
+  LaplacianSums laplacian;
+
+  int cellRowIndex = 0;
+  for (int row = 0; row < height; row++) {
+    const uint8_t* pixels = y + static_cast<size_t>(row) * yRowStride;
+    while (row >= cellRowStarts[cellRowIndex + 1]) {
+      cellRowIndex++;
+    }
+    PixelSums* cellRow = cells.data() + static_cast<size_t>(cellRowIndex) * columns;
+    for (int column = 0; column < columns; column++) {
+      PixelSums sums = kernels.sumRow(pixels + cellStarts[column], cellStarts[column + 1] - cellStarts[column]);
+      cellRow[column].sum += sums.sum;
+      cellRow[column].squares += sums.squares;
+    }
+    if (options.histogram != nullptr) {
+      countRow(pixels, width, histograms);
+    }
+    if (options.sharpness && row >= 2) {
+      // the row above is complete now, its neighbours were just read and are still cached.
+      kernels.laplacianRow(pixels - 2 * static_cast<size_t>(yRowStride), pixels - yRowStride, pixels, width, laplacian);
+    }
+  }
+
+  LumaStatistics result;
+  PixelSums total;
+  for (size_t i = 0; i < cells.size(); i++) {
+    total.sum += cells[i].sum;
+    total.squares += cells[i].squares;
+    if (!hasGrid) {
+      continue;
+    }
+    size_t row = i / columns;
+    size_t column = i % columns;
+    double count = static_cast<double>(cellStarts[column + 1] - cellStarts[column]) *
+                   static_cast<double>(cellRowStarts[row + 1] - cellRowStarts[row]);
+    if (options.gridMean != nullptr) {
+      options.gridMean[i] = static_cast<float>(static_cast<double>(cells[i].sum) / count);
+    }
+    if (options.gridVariance != nullptr) {
+      options.gridVariance[i] = static_cast<float>(getVariance(static_cast<double>(cells[i].sum), static_cast<double>(cells[i].squares), count));
+    }
+  }
+  double count = static_cast<double>(width) * height;
+  result.mean = static_cast<double>(total.sum) / count;
+  result.variance = getVariance(static_cast<double>(total.sum), static_cast<double>(total.squares), count);
+
+  if (options.histogram != nullptr) {
+    for (size_t bin = 0; bin < kLumaHistogramBins; bin++) {
+      options.histogram[bin] = histograms[0][bin] + histograms[1][bin] + histograms[2][bin] + histograms[3][bin];
+    }
+  }
+  if (options.sharpness && width >= 3 && height >= 3) {
+    double innerCount = static_cast<double>(width - 2) * (height - 2);
+    result.sharpness = getVariance(static_cast<double>(laplacian.sum), static_cast<double>(laplacian.squares), innerCount);
+  }
+  return result;
+}
+
+} // namespace kernels
+} // namespace vision
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "YUVToRGB.h"
+
+namespace vision {
+namespace kernels {
+
+constexpr size_t kLumaHistogramBins = 256;
+
+/**
+ * Which statistics computeLumaStatistics() computes in addition to the mean and variance, and where it writes them.
+ */
+struct LumaStatisticsOptions {
+  // kLumaHistogramBins counters, or nullptr to skip the histogram
+  uint32_t* histogram = nullptr;
+  // the mean and variance of every cell of a `gridColumns` x `gridRows` grid, row-major. nullptr to skip the grid.
+  int gridColumns = 0;
+  int gridRows = 0;
+  float* gridMean = nullptr;
+  float* gridVariance = nullptr;
+  // whether to compute the variance of the Laplacian
+  bool sharpness = false;
+};
+
+struct LumaStatistics {
+  double mean = 0;
+  double variance = 0;
+  // the variance of the Laplacian (4-neighbourhood) over all inner pixels. Higher is sharper, 0 if not computed.
+  double sharpness = 0;
+};
+
+/**
+ * Computes statistics of a Y (luma) plane in a single pass over its rows, e.g. to pick the sharpest Frame or to skip dark Frames.
+ *
+ * Every row is summed up per grid cell (which also gives the global mean and variance), counted into the histogram,
+ * and the Laplacian of the row above is computed while its neighbours are still in the cache.
+ * Rows may be at most 65536 pixels wide, and the grid must not have more columns or rows than the plane.
+ */
+LumaStatistics computeLumaStatistics(const uint8_t* y, int yRowStride, int width, int height, const LumaStatisticsOptions& options,
+                                     KernelImplementation implementation = KernelImplementation::Auto);
+
+} // namespace kernels
+} // namespace vision
@@ -0,0 +1,157 @@
+#include "YUVToRGB.h"
+
+#include <cstdint>
+
+#include "YUVToRGBRow.h"
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+void convertYUVToRGBRowReference(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                                 RGBFormat format, const YUVCoefficients& c) {
+  convertYUVToRGBRowScalar(y, u, v, uvPixelStride, dst, 0, width, getRGBLayout(format), c);
+}
+
+YUVToRGBRowFunction getRowFunction(KernelImplementation implementation, int uvPixelStride) {
+  // the SIMD kernels only know how to deinterleave planar and semi-planar chroma
+  if (uvPixelStride != 1 && uvPixelStride != 2) {
+    return convertYUVToRGBRowReference;
+  }
+  switch (implementation) {
+#if VISION_KERNELS_X86
+    case KernelImplementation::AVX2:
+      return convertYUVToRGBRowAVX2;
+    case KernelImplementation::SSE41:
+      return convertYUVToRGBRowSSE41;
+#endif
+#if VISION_KERNELS_NEON
+    case KernelImplementation::NEON:
+      return convertYUVToRGBRowNEON;
+#endif
+    default:
+      return convertYUVToRGBRowReference;
+  }
+}
+
+} // namespace
+
+bool isKernelImplementationSupported(KernelImplementation implementation) {
+  switch (implementation) {
+    case KernelImplementation::Auto:
+    case KernelImplementation::Scalar:
+      return true;
+#if VISION_KERNELS_X86
+    case KernelImplementation::SSE41:
+      return __builtin_cpu_supports("sse4.1");
+    case KernelImplementation::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+#if VISION_KERNELS_NEON
+    case KernelImplementation::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+KernelImplementation resolveKernelImplementation(KernelImplementation implementation) {
+  if (implementation != KernelImplementation::Auto) {
+    return isKernelImplementationSupported(implementation) ? implementation : KernelImplementation::Scalar;
+  }
+  // the CPU doesn't change at runtime, so this only has to be checked once.
+  static const KernelImplementation fastest = [] {
+    for (auto candidate : { KernelImplementation::NEON, KernelImplementation::AVX2, KernelImplementation::SSE41 }) {
+      if (isKernelImplementationSupported(candidate)) {
+        return candidate;
+      }
+    }
+    return KernelImplementation::Scalar;
+  }();
+  return fastest;
+}
+
+bool describeYUVImage(const FrameDescriptor& descriptor, YUVImage& image) {
+  image.width = descriptor.width;
+  image.height = descriptor.height;
+  image.colorRange = descriptor.colorRange;
+
+  switch (descriptor.pixelFormat) {
+    case PixelFormat::YUV_420_888: {
+      // Android: the U and V planes either are separate (I420) or overlap in one interleaved buffer (NV12/NV21),
+      // in which case their pixelStride is 2.
+      if (descriptor.planesCount < 3) {
+        return false;
+      }
+      const auto& yPlane = descriptor.planes[0];
+      const auto& uPlane = descriptor.planes[1];
+      const auto& vPlane = descriptor.planes[2];
+      if (uPlane.pixelStride != vPlane.pixelStride || uPlane.rowStride != vPlane.rowStride || uPlane.pixelStride < 1) {
+        return false;
+      }
+      image.y = yPlane.data;
+      image.yRowStride = yPlane.rowStride;
+      image.u = uPlane.data;
+      image.v = vPlane.data;
+      image.uvRowStride = uPlane.rowStride;
+      image.uvPixelStride = uPlane.pixelStride;
+      return true;
+    }
+    case PixelFormat::YUV_420_BIPLANAR: {
+      // iOS: NV12, the second plane contains interleaved CbCr
+      if (descriptor.planesCount < 2) {
+        return false;
+      }
+      const auto& yPlane = descriptor.planes[0];
+      const auto& uvPlane = descriptor.planes[1];
+      image.y = yPlane.data;
+      image.yRowStride = yPlane.rowStride;
+      image.u = uvPlane.data;
+      image.v = uvPlane.data + 1;
+      image.uvRowStride = uvPlane.rowStride;
+      image.uvPixelStride = 2;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void convertYUVToRGB(const YUVImage& image, RGBFormat format, uint8_t* dst, size_t dstRowStride, KernelImplementation implementation) {
+  auto coefficients = getYUVCoefficients(image.colorRange);
+  auto convertRow = getRowFunction(resolveKernelImplementation(implementation), image.uvPixelStride);
+
+  for (int row = 0; row < image.height; row++) {
+    const uint8_t* y = image.y + static_cast<size_t>(row) * image.yRowStride;
+    size_t chromaOffset = static_cast<size_t>(row >> 1) * image.uvRowStride;
+    convertRow(y, image.u + chromaOffset, image.v + chromaOffset, image.uvPixelStride, dst + row * dstRowStride, image.width, format,
+               coefficients);
+  }
+}
+
+void convertPackedToRGB(const uint8_t* src, size_t srcRowStride, bool srcIsBGRA, int width, int height, RGBFormat format, uint8_t* dst,
+                        size_t dstRowStride) {
+  auto layout = getRGBLayout(format);
+  int srcR = srcIsBGRA ? 2 : 0;
+  int srcB = srcIsBGRA ? 0 : 2;
+
+  for (int row = 0; row < height; row++) {
+    const uint8_t* in = src + row * srcRowStride;
+    uint8_t* out = dst + row * dstRowStride;
+    for (int x = 0; x < width; x++) {
+      out[layout.r] = in[srcR];
+      out[layout.g] = in[1];
+      out[layout.b] = in[srcB];
+      if (layout.a >= 0) {
+        out[layout.a] = in[3];
+      }
+      in += 4;
+      out += layout.bytesPerPixel;
+    }
+  }
+}
+
+} // namespace kernels
+} // namespace vision
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../FrameDescriptor.h"
+
+namespace vision {
+namespace kernels {
+
+enum class RGBFormat {
+  RGB,
+  RGBA,
+  BGR,
+  BGRA,
+};
+
+inline size_t bytesPerPixel(RGBFormat format) {
+  return format == RGBFormat::RGB || format == RGBFormat::BGR ? 3 : 4;
+}
+
+/**
+ * The instruction set a kernel runs on. `Auto` picks the fastest one the CPU supports,
+ * the others can be forced to compare implementations against each other.
+ */
+enum class KernelImplementation {
+  Auto,
+  Scalar,
+  SSE41,
+  AVX2,
+  NEON,
+};
+
+/**
+ * Whether the given implementation was compiled in and is supported by the CPU we are running on.
+ */
+bool isKernelImplementationSupported(KernelImplementation implementation);
+/**
+ * Resolves `Auto` to the fastest supported implementation.
+ */
+KernelImplementation resolveKernelImplementation(KernelImplementation implementation);
+
+/**
+ * A 4:2:0 subsampled YUV image.
+ *
+ * This covers planar (I420, `uvPixelStride` = 1) as well as semi-planar (NV12/NV21, `uvPixelStride` = 2) layouts,
+ * for NV12 `v` points one byte after `u`, for NV21 `u` points one byte after `v`.
+ */
+struct YUVImage {
+  int width = 0;
+  int height = 0;
+  ColorRange colorRange = ColorRange::Full;
+  const uint8_t* y = nullptr;
+  int yRowStride = 0;
+  const uint8_t* u = nullptr;
+  const uint8_t* v = nullptr;
+  int uvRowStride = 0;
+  int uvPixelStride = 0;
+};
+
+/**
+ * Describes the YUV planes of the given Frame. Returns false if the Frame is not a 4:2:0 YUV Frame.
+ */
+bool describeYUVImage(const FrameDescriptor& descriptor, YUVImage& image); // NOLINT(runtime/references)
+
+/**
+ * Converts the YUV image to interleaved 8-bit RGB(A) using BT.601 coefficients.
+ *
+ * `dst` must hold `height` rows of `dstRowStride` bytes each, and `dstRowStride` must be at least `width * bytesPerPixel(format)`.
+ * All implementations produce bit-exact identical results.
+ */
+void convertYUVToRGB(const YUVImage& image, RGBFormat format, uint8_t* dst, size_t dstRowStride,
+                     KernelImplementation implementation = KernelImplementation::Auto);
+
+/**
+ * Converts (swizzles) an interleaved 8-bit RGBA or BGRA image to the given format.
+ */
+void convertPackedToRGB(const uint8_t* src, size_t srcRowStride, bool srcIsBGRA, int width, int height, RGBFormat format, uint8_t* dst,
+                        size_t dstRowStride);
+
+} // namespace kernels
+} // namespace vision
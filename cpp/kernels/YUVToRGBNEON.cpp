@@ -0,0 +1,87 @@
+#include "YUVToRGBRow.h"
+
+#if VISION_KERNELS_NEON
+
+#include <arm_neon.h>
+
+#include <cstdint>
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+inline int16x8_t loadChroma(const uint8_t* chroma, int x, int uvPixelStride) {
+  uint8x8_t values;
+  if (uvPixelStride == 1) {
+    values = vld1_u8(chroma + x / 2);
+  } else {
+    // semi-planar: deinterleave 16 bytes, the chroma samples we need are at the even positions.
+    values = vld2_u8(chroma + x).val[0];
+  }
+  return vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(values)), vdupq_n_s16(128));
+}
+
+inline int16x8_t scaleLuma(uint8x8_t luma, const YUVCoefficients& c) {
+  int16x8_t value = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(luma)), vdupq_n_s16(c.yOffset));
+  return vaddq_s16(vmulq_n_s16(value, c.yScale), vdupq_n_s16(kYUVRound));
+}
+
+/**
+ * Adds (or subtracts) the chroma contribution of 8 chroma samples to 16 pixels of luma and narrows the result to 16 bytes.
+ */
+template <bool Subtract>
+inline uint8x16_t applyChroma(int16x8_t lumaLow, int16x8_t lumaHigh, int16x8_t chroma) {
+  // duplicate every chroma sample for its two pixels.
+  int16x8x2_t duplicated = vzipq_s16(chroma, chroma);
+  int16x8_t low = Subtract ? vqsubq_s16(lumaLow, duplicated.val[0]) : vqaddq_s16(lumaLow, duplicated.val[0]);
+  int16x8_t high = Subtract ? vqsubq_s16(lumaHigh, duplicated.val[1]) : vqaddq_s16(lumaHigh, duplicated.val[1]);
+  // arithmetic shift + saturating narrow to 0...255, same as the scalar clamp.
+  return vcombine_u8(vqshrun_n_s16(low, kYUVShift), vqshrun_n_s16(high, kYUVShift));
+}
+
+} // namespace
+
+void convertYUVToRGBRowNEON(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                            RGBFormat format, const YUVCoefficients& c) {
+  constexpr int kPixelsPerVector = 16;
+  const int bytesPerPixel = static_cast<int>(kernels::bytesPerPixel(format));
+  const int vectorizableWidth = getVectorizableWidth(width, uvPixelStride, kPixelsPerVector);
+  const bool isBGR = format == RGBFormat::BGR || format == RGBFormat::BGRA;
+  const bool hasAlpha = format == RGBFormat::RGBA || format == RGBFormat::BGRA;
+
+  int x = 0;
+  for (; x < vectorizableWidth; x += kPixelsPerVector) {
+    uint8x16_t luma = vld1q_u8(y + x);
+    int16x8_t lumaLow = scaleLuma(vget_low_u8(luma), c);
+    int16x8_t lumaHigh = scaleLuma(vget_high_u8(luma), c);
+
+    int16x8_t U = loadChroma(u, x, uvPixelStride);
+    int16x8_t V = loadChroma(v, x, uvPixelStride);
+    uint8x16_t r = applyChroma<false>(lumaLow, lumaHigh, vmulq_n_s16(V, c.vr));
+    uint8x16_t g = applyChroma<true>(lumaLow, lumaHigh, vaddq_s16(vmulq_n_s16(U, c.ug), vmulq_n_s16(V, c.vg)));
+    uint8x16_t b = applyChroma<false>(lumaLow, lumaHigh, vmulq_n_s16(U, c.ub));
+
+    uint8_t* out = dst + x * bytesPerPixel;
+    if (hasAlpha) {
+      uint8x16x4_t pixels;
+      pixels.val[0] = isBGR ? b : r;
+      pixels.val[1] = g;
+      pixels.val[2] = isBGR ? r : b;
+      pixels.val[3] = vdupq_n_u8(255);
+      vst4q_u8(out, pixels);
+    } else {
+      uint8x16x3_t pixels;
+      pixels.val[0] = isBGR ? b : r;
+      pixels.val[1] = g;
+      pixels.val[2] = isBGR ? r : b;
+      vst3q_u8(out, pixels);
+    }
+  }
+  convertYUVToRGBRowScalar(y, u, v, uvPixelStride, dst, x, width, getRGBLayout(format), c);
+}
+
+} // namespace kernels
+} // namespace vision
+
+#endif
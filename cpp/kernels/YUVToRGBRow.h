@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "KernelTargets.h"
+#include "YUVToRGB.h"
+
+// Internal to the YUV -> RGB kernels, shared between the scalar and the SIMD translation units.
+
+namespace vision {
+namespace kernels {
+
+/**
+ * BT.601 YUV -> RGB coefficients in Q6 fixed point.
+ *
+ * All intermediate values fit into a signed 16-bit integer (or saturate in a direction that gets clamped anyway),
+ * so the SIMD implementations can work on 8/16 lanes of int16 and still match the scalar implementation bit by bit.
+ */
+struct YUVCoefficients {
+  int16_t yOffset;
+  int16_t yScale;
+  int16_t vr;
+  int16_t ug;
+  int16_t vg;
+  int16_t ub;
+};
+
+inline YUVCoefficients getYUVCoefficients(ColorRange range) {
+  switch (range) {
+    case ColorRange::Video:
+      // Y' = 1.164 (Y - 16), R = Y' + 1.596 V, G = Y' - 0.391 U - 0.813 V, B = Y' + 2.018 U
+      return { 16, 74, 102, 25, 52, 129 };
+    case ColorRange::Full:
+    default:
+      // R = Y + 1.402 V, G = Y - 0.344 U - 0.714 V, B = Y + 1.772 U
+      return { 0, 64, 90, 22, 46, 113 };
+  }
+}
+
+// rounding term, added once to Y' so every channel is rounded to nearest before the shift.
+constexpr int kYUVRound = 1 << 5;
+constexpr int kYUVShift = 6;
+
+inline uint8_t clampToByte(int value) {
+  return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+}
+
+/**
+ * Byte offsets of the R, G, B (and A) channels within one output pixel.
+ */
+struct RGBLayout {
+  int r;
+  int g;
+  int b;
+  int a; // -1 if there is no alpha channel
+  int bytesPerPixel;
+};
+
+inline RGBLayout getRGBLayout(RGBFormat format) {
+  switch (format) {
+    case RGBFormat::RGBA:
+      return { 0, 1, 2, 3, 4 };
+    case RGBFormat::BGR:
+      return { 2, 1, 0, -1, 3 };
+    case RGBFormat::BGRA:
+      return { 2, 1, 0, 3, 4 };
+    case RGBFormat::RGB:
+    default:
+      return { 0, 1, 2, -1, 3 };
+  }
+}
+
+/**
+ * Converts the pixels [start, end) of a single row. `u` and `v` point to the start of the chroma row.
+ * This is the reference implementation, and the SIMD implementations use it for the pixels that don't fill a whole vector.
+ */
+inline void convertYUVToRGBRowScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int start,
+                                     int end, const RGBLayout& layout, const YUVCoefficients& c) {
+  for (int x = start; x < end; x++) {
+    int chromaOffset = (x >> 1) * uvPixelStride;
+    int U = u[chromaOffset] - 128;
+    int V = v[chromaOffset] - 128;
+    int luma = (y[x] - c.yOffset) * c.yScale + kYUVRound;
+
+    uint8_t* pixel = dst + x * layout.bytesPerPixel;
+    pixel[layout.r] = clampToByte((luma + c.vr * V) >> kYUVShift);
+    pixel[layout.g] = clampToByte((luma - (c.ug * U + c.vg * V)) >> kYUVShift);
+    pixel[layout.b] = clampToByte((luma + c.ub * U) >> kYUVShift);
+    if (layout.a >= 0) {
+      pixel[layout.a] = 255;
+    }
+  }
+}
+
+/**
+ * A row kernel converts a whole row of `width` pixels, `uvPixelStride` is either 1 (planar) or 2 (semi-planar).
+ */
+using YUVToRGBRowFunction = void (*)(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                                     RGBFormat format, const YUVCoefficients& c);
+
+#if VISION_KERNELS_X86
+void convertYUVToRGBRowSSE41(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                             RGBFormat format, const YUVCoefficients& c);
+void convertYUVToRGBRowAVX2(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                            RGBFormat format, const YUVCoefficients& c);
+#endif
+
+#if VISION_KERNELS_NEON
+void convertYUVToRGBRowNEON(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst, int width,
+                            RGBFormat format, const YUVCoefficients& c);
+#endif
+
+/**
+ * The amount of pixels a SIMD row kernel can convert with full vectors, without reading past the end of the row.
+ *
+ * Semi-planar chroma is loaded from both the `u` and the `v` pointer, one of which points one byte into the row -
+ * so for those rows the last vector must stop at least one pixel before the end of the row.
+ * (Android's chroma planes are exactly `width - 1` bytes long in the last row)
+ */
+inline int getVectorizableWidth(int width, int uvPixelStride, int pixelsPerVector) {
+  int limit = uvPixelStride == 2 ? width - 1 : width;
+  return limit < pixelsPerVector ? 0 : (limit / pixelsPerVector) * pixelsPerVector;
+}
+
+} // namespace kernels
+} // namespace vision
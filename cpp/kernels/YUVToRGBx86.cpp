@@ -0,0 +1,182 @@
+#include "YUVToRGBRow.h"
+
+#if VISION_KERNELS_X86
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace vision {
+namespace kernels {
+
+namespace {
+
+/**
+ * Interleaves 16 pixels of R, G and B into the destination format and stores them.
+ */
+VISION_TARGET_SSE41 inline void storePixels16(__m128i r, __m128i g, __m128i b, uint8_t* dst, RGBFormat format) {
+  if (format == RGBFormat::BGR || format == RGBFormat::BGRA) {
+    std::swap(r, b);
+  }
+  bool hasAlpha = format == RGBFormat::RGBA || format == RGBFormat::BGRA;
+  __m128i a = hasAlpha ? _mm_set1_epi8(static_cast<char>(0xFF)) : _mm_setzero_si128();
+
+  __m128i rgLow = _mm_unpacklo_epi8(r, g);
+  __m128i rgHigh = _mm_unpackhi_epi8(r, g);
+  __m128i baLow = _mm_unpacklo_epi8(b, a);
+  __m128i baHigh = _mm_unpackhi_epi8(b, a);
+  __m128i p0 = _mm_unpacklo_epi16(rgLow, baLow);
+  __m128i p1 = _mm_unpackhi_epi16(rgLow, baLow);
+  __m128i p2 = _mm_unpacklo_epi16(rgHigh, baHigh);
+  __m128i p3 = _mm_unpackhi_epi16(rgHigh, baHigh);
+
+  if (hasAlpha) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), p0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), p1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), p2);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), p3);
+    return;
+  }
+
+  // drop every 4th byte, so each vector holds 4 packed 3-byte pixels in its lower 12 bytes.
+  const __m128i dropAlpha = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  p0 = _mm_shuffle_epi8(p0, dropAlpha);
+  p1 = _mm_shuffle_epi8(p1, dropAlpha);
+  p2 = _mm_shuffle_epi8(p2, dropAlpha);
+  p3 = _mm_shuffle_epi8(p3, dropAlpha);
+  // the upper 4 bytes of each store are overwritten by the next one, the last store only writes 12 bytes.
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), p0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), p1);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 24), p2);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 36), p3);
+  int32_t tail = _mm_extract_epi32(p3, 2);
+  std::memcpy(dst + 44, &tail, sizeof(tail));
+}
+
+/**
+ * Computes Y' (scaled luma incl. the rounding term) for 8 Y values widened to int16.
+ */
+VISION_TARGET_SSE41 inline __m128i scaleLuma(__m128i luma, const YUVCoefficients& c) {
+  luma = _mm_sub_epi16(luma, _mm_set1_epi16(c.yOffset));
+  luma = _mm_mullo_epi16(luma, _mm_set1_epi16(c.yScale));
+  return _mm_add_epi16(luma, _mm_set1_epi16(kYUVRound));
+}
+
+VISION_TARGET_SSE41 inline __m128i loadChromaSSE(const uint8_t* chroma, int x, int uvPixelStride) {
+  __m128i values;
+  if (uvPixelStride == 1) {
+    values = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma + x / 2)));
+  } else {
+    // semi-planar: 16 bytes contain 8 chroma samples at the even positions.
+    values = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma + x)), _mm_set1_epi16(0x00FF));
+  }
+  return _mm_sub_epi16(values, _mm_set1_epi16(128));
+}
+
+VISION_TARGET_AVX2 inline __m256i scaleLuma(__m256i luma, const YUVCoefficients& c) {
+  luma = _mm256_sub_epi16(luma, _mm256_set1_epi16(c.yOffset));
+  luma = _mm256_mullo_epi16(luma, _mm256_set1_epi16(c.yScale));
+  return _mm256_add_epi16(luma, _mm256_set1_epi16(kYUVRound));
+}
+
+VISION_TARGET_AVX2 inline __m256i loadChromaAVX2(const uint8_t* chroma, int x, int uvPixelStride) {
+  __m256i values;
+  if (uvPixelStride == 1) {
+    values = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma + x / 2)));
+  } else {
+    values = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(chroma + x)), _mm256_set1_epi16(0x00FF));
+  }
+  return _mm256_sub_epi16(values, _mm256_set1_epi16(128));
+}
+
+/**
+ * Adds (or subtracts) the chroma contribution of 16 chroma samples to 32 pixels of luma and narrows the result to 32 bytes.
+ */
+template <bool Subtract>
+VISION_TARGET_AVX2 inline __m256i applyChroma(__m256i lumaLow, __m256i lumaHigh, __m256i chroma) {
+  // duplicate every chroma sample for its two pixels. unpack works within 128-bit lanes, so the halves have to be reordered.
+  __m256i duplicatedLow = _mm256_unpacklo_epi16(chroma, chroma);
+  __m256i duplicatedHigh = _mm256_unpackhi_epi16(chroma, chroma);
+  __m256i chromaLow = _mm256_permute2x128_si256(duplicatedLow, duplicatedHigh, 0x20);
+  __m256i chromaHigh = _mm256_permute2x128_si256(duplicatedLow, duplicatedHigh, 0x31);
+
+  __m256i low = Subtract ? _mm256_subs_epi16(lumaLow, chromaLow) : _mm256_adds_epi16(lumaLow, chromaLow);
+  __m256i high = Subtract ? _mm256_subs_epi16(lumaHigh, chromaHigh) : _mm256_adds_epi16(lumaHigh, chromaHigh);
+  __m256i packed = _mm256_packus_epi16(_mm256_srai_epi16(low, kYUVShift), _mm256_srai_epi16(high, kYUVShift));
+  // packus interleaves the 128-bit lanes of both inputs, restore the pixel order.
+  return _mm256_permute4x64_epi64(packed, 0xD8);
+}
+
+} // namespace
+
+VISION_TARGET_SSE41 void convertYUVToRGBRowSSE41(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst,
+                                                 int width, RGBFormat format, const YUVCoefficients& c) {
+  constexpr int kPixelsPerVector = 16;
+  const int bytesPerPixel = static_cast<int>(kernels::bytesPerPixel(format));
+  const int vectorizableWidth = getVectorizableWidth(width, uvPixelStride, kPixelsPerVector);
+
+  const __m128i vr = _mm_set1_epi16(c.vr);
+  const __m128i ug = _mm_set1_epi16(c.ug);
+  const __m128i vg = _mm_set1_epi16(c.vg);
+  const __m128i ub = _mm_set1_epi16(c.ub);
+
+  int x = 0;
+  for (; x < vectorizableWidth; x += kPixelsPerVector) {
+    __m128i luma = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x));
+    __m128i lumaLow = scaleLuma(_mm_cvtepu8_epi16(luma), c);
+    __m128i lumaHigh = scaleLuma(_mm_cvtepu8_epi16(_mm_srli_si128(luma, 8)), c);
+
+    __m128i U = loadChromaSSE(u, x, uvPixelStride);
+    __m128i V = loadChromaSSE(v, x, uvPixelStride);
+    __m128i rc = _mm_mullo_epi16(V, vr);
+    __m128i gc = _mm_add_epi16(_mm_mullo_epi16(U, ug), _mm_mullo_epi16(V, vg));
+    __m128i bc = _mm_mullo_epi16(U, ub);
+
+    __m128i r = _mm_packus_epi16(_mm_srai_epi16(_mm_adds_epi16(lumaLow, _mm_unpacklo_epi16(rc, rc)), kYUVShift),
+                                 _mm_srai_epi16(_mm_adds_epi16(lumaHigh, _mm_unpackhi_epi16(rc, rc)), kYUVShift));
+    __m128i g = _mm_packus_epi16(_mm_srai_epi16(_mm_subs_epi16(lumaLow, _mm_unpacklo_epi16(gc, gc)), kYUVShift),
+                                 _mm_srai_epi16(_mm_subs_epi16(lumaHigh, _mm_unpackhi_epi16(gc, gc)), kYUVShift));
+    __m128i b = _mm_packus_epi16(_mm_srai_epi16(_mm_adds_epi16(lumaLow, _mm_unpacklo_epi16(bc, bc)), kYUVShift),
+                                 _mm_srai_epi16(_mm_adds_epi16(lumaHigh, _mm_unpackhi_epi16(bc, bc)), kYUVShift));
+    storePixels16(r, g, b, dst + x * bytesPerPixel, format);
+  }
+  convertYUVToRGBRowScalar(y, u, v, uvPixelStride, dst, x, width, getRGBLayout(format), c);
+}
+
+VISION_TARGET_AVX2 void convertYUVToRGBRowAVX2(const uint8_t* y, const uint8_t* u, const uint8_t* v, int uvPixelStride, uint8_t* dst,
+                                               int width, RGBFormat format, const YUVCoefficients& c) {
+  constexpr int kPixelsPerVector = 32;
+  const int bytesPerPixel = static_cast<int>(kernels::bytesPerPixel(format));
+  const int vectorizableWidth = getVectorizableWidth(width, uvPixelStride, kPixelsPerVector);
+
+  const __m256i vr = _mm256_set1_epi16(c.vr);
+  const __m256i ug = _mm256_set1_epi16(c.ug);
+  const __m256i vg = _mm256_set1_epi16(c.vg);
+  const __m256i ub = _mm256_set1_epi16(c.ub);
+
+  int x = 0;
+  for (; x < vectorizableWidth; x += kPixelsPerVector) {
+    __m256i luma = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + x));
+    __m256i lumaLow = scaleLuma(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(luma)), c);
+    __m256i lumaHigh = scaleLuma(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(luma, 1)), c);
+
+    __m256i U = loadChromaAVX2(u, x, uvPixelStride);
+    __m256i V = loadChromaAVX2(v, x, uvPixelStride);
+    __m256i r = applyChroma<false>(lumaLow, lumaHigh, _mm256_mullo_epi16(V, vr));
+    __m256i g = applyChroma<true>(lumaLow, lumaHigh, _mm256_add_epi16(_mm256_mullo_epi16(U, ug), _mm256_mullo_epi16(V, vg)));
+    __m256i b = applyChroma<false>(lumaLow, lumaHigh, _mm256_mullo_epi16(U, ub));
+
+    uint8_t* out = dst + x * bytesPerPixel;
+    storePixels16(_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b), out, format);
+    storePixels16(_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1),
+                  out + 16 * bytesPerPixel, format);
+  }
+  convertYUVToRGBRowScalar(y, u, v, uvPixelStride, dst, x, width, getRGBLayout(format), c);
+}
+
+} // namespace kernels
+} // namespace vision
+
+#endif
@@ -14,6 +14,7 @@
 #import <React/RCTUIManager.h>
 
 #import "FrameProcessorCallback.h"
+#import "FrameProcessorPerformanceDataCollector.h"
 #import "FrameProcessorRuntimeManagerOld.h"
 #import "FrameOld.h"
 #import "RCTBridge+runOnJS.h"
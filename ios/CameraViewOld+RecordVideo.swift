@@ -211,54 +211,78 @@ extension CameraViewOld: AVCaptureVideoDataOutputSampleBufferDelegate, AVCapture
     }
 
     if let frameProcessor = frameProcessorCallback, captureOutput is AVCaptureVideoDataOutput {
-      // check if last frame was x nanoseconds ago, effectively throttling FPS
-      let frameTime = UInt64(CMSampleBufferGetPresentationTimeStamp(sampleBuffer).seconds * 1_000_000_000.0)
-      let lastFrameProcessorCallElapsedTime = frameTime - lastFrameProcessorCall
-      let secondsPerFrame = 1.0 / actualFrameProcessorFps
-      let nanosecondsPerFrame = secondsPerFrame * 1_000_000_000.0
-      if lastFrameProcessorCallElapsedTime >= UInt64(nanosecondsPerFrame) {
-        if !isRunningFrameProcessor {
-          // we're not in the middle of executing the Frame Processor, so prepare for next call.
-          CameraQueues.frameProcessorQueue.async {
-            self.isRunningFrameProcessor = true
-
-            let perfSample = self.frameProcessorPerformanceDataCollector.beginPerformanceSampleCollection()
-            let frame = FrameOld(buffer: sampleBuffer, orientation: self.bufferOrientation)
-            frameProcessor(frame)
-            perfSample.endPerformanceSampleCollection()
-
-            self.isRunningFrameProcessor = false
-          }
-          lastFrameProcessorCall = frameTime
-        } else {
-          // we're still in the middle of executing a Frame Processor for a previous frame, so a frame was dropped.
-          ReactLogger.log(level: .warning, message: "The Frame Processor took so long to execute that a frame was dropped.")
+      let arrivalTime = DispatchTime.now()
+      frameProcessorPerformanceDataCollector.frameDelivered()
+      // the FrameRateController decides which Frames are processed, see configureFrameRate()
+      let frameTime = Int64(CMSampleBufferGetPresentationTimeStamp(sampleBuffer).seconds * 1_000_000_000.0)
+      if !frameProcessorPerformanceDataCollector.shouldProcessFrame(frameTime) {
+        frameProcessorPerformanceDataCollector.frameThrottled()
+      } else if !frameProcessorPerformanceDataCollector.hasFrameChanged(sampleBuffer) {
+        // the scene did not change since the last processed Frame, see `frameProcessorChangeThreshold`
+        frameProcessorPerformanceDataCollector.frameUnchanged()
+      } else if !isRunningFrameProcessor {
+        // we're not in the middle of executing the Frame Processor, so prepare for next call.
+        CameraQueues.frameProcessorQueue.async {
+          self.isRunningFrameProcessor = true
+
+          let begin = DispatchTime.now()
+          let frame = FrameOld(buffer: sampleBuffer, orientation: self.bufferOrientation)
+          frameProcessor(frame)
+          let end = DispatchTime.now()
+          self.frameProcessorPerformanceDataCollector.recordExecutionTime(end.uptimeNanoseconds - begin.uptimeNanoseconds,
+                                                                          latency: end.uptimeNanoseconds - arrivalTime.uptimeNanoseconds)
+
+          self.isRunningFrameProcessor = false
         }
+      } else {
+        // we're still in the middle of executing a Frame Processor for a previous frame, so a frame was dropped.
+        frameProcessorPerformanceDataCollector.frameDropped()
+        ReactLogger.log(level: .warning, message: "The Frame Processor took so long to execute that a frame was dropped.")
       }
+    }
+  }
 
-      if isReadyForNewEvaluation {
-        // last evaluation was more than 1sec ago, evaluate again
-        evaluateNewPerformanceSamples()
+  /**
+   Configures which Frames are passed to the Frame Processor, according to `frameProcessorFps`, `frameProcessorRateMode` and `frameProcessorLatencyBudget`.
+   */
+  internal func configureFrameRate() {
+    // must be in the same order as the C++ FrameRateMode enum
+    let mode: Int
+    if frameProcessorFps.doubleValue != -1 {
+      mode = 0
+    } else {
+      switch frameProcessorRateMode {
+      case "throughput":
+        mode = 1
+      case "latency":
+        mode = 2
+      default:
+        invokeOnError(.parameter(.invalid(unionName: "frameProcessorRateMode", receivedValue: frameProcessorRateMode as String)))
+        return
       }
     }
+    frameProcessorPerformanceDataCollector.configureFrameRate(withMode: mode,
+                                                              fixedFps: frameProcessorFps.doubleValue,
+                                                              latencyBudget: frameProcessorLatencyBudget.doubleValue)
   }
 
-  private func evaluateNewPerformanceSamples() {
-    lastFrameProcessorPerformanceEvaluation = DispatchTime.now()
-    guard let videoDevice = videoDeviceInput?.device else { return }
-    guard frameProcessorPerformanceDataCollector.hasEnoughData else { return }
-
-    let maxFrameProcessorFps = Double(videoDevice.activeVideoMinFrameDuration.timescale) * Double(videoDevice.activeVideoMinFrameDuration.value)
-    let averageFps = 1.0 / frameProcessorPerformanceDataCollector.averageExecutionTimeSeconds
-    let suggestedFrameProcessorFps = max(floor(min(averageFps, maxFrameProcessorFps)), 1)
-
-    if frameProcessorFps.intValue == -1 {
-      // frameProcessorFps="auto"
-      actualFrameProcessorFps = suggestedFrameProcessorFps
-    } else {
+  /**
+   Called by the FrameRateController (on the Frame Processor Queue) when it changed the Frame Processor's rate,
+   or - if `frameProcessorFps` is fixed - when it has a new suggestion. Durations are in milliseconds.
+   */
+  internal func onFrameRateDecision(mode: Int, fps: Double, previousFps: Double, suggestedFps: Double, cameraFps: Double,
+                                    averageExecutionTime: Double, averageLatency: Double) {
+    if mode == 0 {
       // frameProcessorFps={someCustomFpsValue}
       invokeOnFrameProcessorPerformanceSuggestionAvailable(currentFps: frameProcessorFps.doubleValue,
-                                                           suggestedFps: suggestedFrameProcessorFps)
+                                                           suggestedFps: suggestedFps)
+    } else {
+      // frameProcessorFps="auto"
+      invokeOnFrameProcessorFpsChanged(fps: fps,
+                                       previousFps: previousFps,
+                                       cameraFps: cameraFps,
+                                       averageExecutionTime: averageExecutionTime,
+                                       averageLatency: averageLatency)
     }
   }
 
@@ -270,11 +294,6 @@ extension CameraViewOld: AVCaptureVideoDataOutputSampleBufferDelegate, AVCapture
     }
   }
 
-  private var isReadyForNewEvaluation: Bool {
-    let lastPerformanceEvaluationElapsedTime = DispatchTime.now().uptimeNanoseconds - lastFrameProcessorPerformanceEvaluation.uptimeNanoseconds
-    return lastPerformanceEvaluationElapsedTime > 1_000_000_000
-  }
-
   /**
    Gets the orientation of the CameraViewOld's images (CMSampleBuffers).
    */
@@ -31,6 +31,9 @@ private let propsThatRequireDeviceReconfiguration = ["fps",
                                                      "hdr",
                                                      "lowLightBoost",
                                                      "colorSpace"]
+private let propsThatRequireFrameRateReconfiguration = ["frameProcessorFps",
+                                                        "frameProcessorRateMode",
+                                                        "frameProcessorLatencyBudget"]
 
 // MARK: - CameraViewOld
 
@@ -53,6 +56,9 @@ public final class CameraViewOld: UIView {
   @objc var format: NSDictionary?
   @objc var fps: NSNumber?
   @objc var frameProcessorFps: NSNumber = -1.0 // "auto"
+  @objc var frameProcessorRateMode: NSString = "throughput"
+  @objc var frameProcessorLatencyBudget: NSNumber = 100.0 // in milliseconds
+  @objc var frameProcessorChangeThreshold: NSNumber = 0.0 // 0 = disabled
   @objc var hdr: NSNumber? // nullable bool
   @objc var lowLightBoost: NSNumber? // nullable bool
   @objc var colorSpace: NSString?
@@ -66,6 +72,7 @@ public final class CameraViewOld: UIView {
   @objc var onInitialized: RCTDirectEventBlock?
   @objc var onError: RCTDirectEventBlock?
   @objc var onFrameProcessorPerformanceSuggestionAvailable: RCTDirectEventBlock?
+  @objc var onFrameProcessorFpsChanged: RCTDirectEventBlock?
   @objc var onViewReady: RCTDirectEventBlock?
   // zoom
   @objc var enableZoomGesture = false {
@@ -94,7 +101,6 @@ public final class CameraViewOld: UIView {
   internal var isRecording = false
   internal var recordingSession: RecordingSession?
   @objc public var frameProcessorCallback: FrameProcessorCallback?
-  internal var lastFrameProcessorCall = DispatchTime.now().uptimeNanoseconds
   // CameraViewOld+TakePhoto
   internal var photoCaptureDelegates: [PhotoCaptureDelegate] = []
   // CameraViewOld+Zoom
@@ -108,9 +114,7 @@ public final class CameraViewOld: UIView {
   /// Specifies whether the frameProcessor() function is currently executing. used to drop late frames.
   internal var isRunningFrameProcessor = false
   internal let frameProcessorPerformanceDataCollector = FrameProcessorPerformanceDataCollector()
-  internal var actualFrameProcessorFps = 30.0
   internal var lastSuggestedFrameProcessorFps = 0.0
-  internal var lastFrameProcessorPerformanceEvaluation = DispatchTime.now()
 
   /// Returns whether the AVCaptureSession is currently running (reflected by isActive)
   var isRunning: Bool {
@@ -150,6 +154,16 @@ public final class CameraViewOld: UIView {
                                            selector: #selector(onOrientationChanged),
                                            name: UIDevice.orientationDidChangeNotification,
                                            object: nil)
+
+    frameProcessorPerformanceDataCollector.onFrameRateDecision = { [weak self] mode, fps, previousFps, suggestedFps, cameraFps, averageExecutionTime, averageLatency in
+      self?.onFrameRateDecision(mode: mode,
+                                fps: fps,
+                                previousFps: previousFps,
+                                suggestedFps: suggestedFps,
+                                cameraFps: cameraFps,
+                                averageExecutionTime: averageExecutionTime,
+                                averageLatency: averageLatency)
+    }
   }
 
   @available(*, unavailable)
@@ -260,16 +274,17 @@ public final class CameraViewOld: UIView {
       }
     }
 
+    // Frame Processor stats are looked up by the view's tag
+    if frameProcessorPerformanceDataCollector.viewTag != reactTag {
+      frameProcessorPerformanceDataCollector.viewTag = reactTag
+    }
+
     // Frame Processor FPS Configuration
-    if changedProps.contains("frameProcessorFps") {
-      if frameProcessorFps.doubleValue == -1 {
-        // "auto"
-        actualFrameProcessorFps = 30.0
-      } else {
-        actualFrameProcessorFps = frameProcessorFps.doubleValue
-      }
-      lastFrameProcessorPerformanceEvaluation = DispatchTime.now()
-      frameProcessorPerformanceDataCollector.clear()
+    if changedProps.contains(where: { propsThatRequireFrameRateReconfiguration.contains($0) }) {
+      configureFrameRate()
+    }
+    if changedProps.contains("frameProcessorChangeThreshold") {
+      frameProcessorPerformanceDataCollector.setChangeThreshold(frameProcessorChangeThreshold.doubleValue)
     }
   }
 
@@ -357,4 +372,18 @@ public final class CameraViewOld: UIView {
     ])
     lastSuggestedFrameProcessorFps = suggestedFps
   }
+
+  internal final func invokeOnFrameProcessorFpsChanged(fps: Double, previousFps: Double, cameraFps: Double,
+                                                       averageExecutionTime: Double, averageLatency: Double) {
+    ReactLogger.log(level: .info, message: "Frame Processor FPS changed from \(previousFps) to \(fps)!")
+    guard let onFrameProcessorFpsChanged = onFrameProcessorFpsChanged else { return }
+
+    onFrameProcessorFpsChanged([
+      "frameProcessorFps": fps,
+      "previousFrameProcessorFps": previousFps,
+      "cameraFps": cameraFps,
+      "averageExecutionTime": averageExecutionTime,
+      "averageLatency": averageLatency,
+    ])
+  }
 }
@@ -36,6 +36,9 @@ RCT_EXPORT_VIEW_PROPERTY(enableFrameProcessor, BOOL);
 RCT_EXPORT_VIEW_PROPERTY(format, NSDictionary);
 RCT_EXPORT_VIEW_PROPERTY(fps, NSNumber);
 RCT_EXPORT_VIEW_PROPERTY(frameProcessorFps, NSNumber);
+RCT_EXPORT_VIEW_PROPERTY(frameProcessorRateMode, NSString);
+RCT_EXPORT_VIEW_PROPERTY(frameProcessorLatencyBudget, NSNumber);
+RCT_EXPORT_VIEW_PROPERTY(frameProcessorChangeThreshold, NSNumber);
 RCT_EXPORT_VIEW_PROPERTY(hdr, NSNumber); // nullable bool
 RCT_EXPORT_VIEW_PROPERTY(lowLightBoost, NSNumber); // nullable bool
 RCT_EXPORT_VIEW_PROPERTY(colorSpace, NSString);
@@ -50,6 +53,7 @@ RCT_EXPORT_VIEW_PROPERTY(orientation, NSString);
 RCT_EXPORT_VIEW_PROPERTY(onError, RCTDirectEventBlock);
 RCT_EXPORT_VIEW_PROPERTY(onInitialized, RCTDirectEventBlock);
 RCT_EXPORT_VIEW_PROPERTY(onFrameProcessorPerformanceSuggestionAvailable, RCTDirectEventBlock);
+RCT_EXPORT_VIEW_PROPERTY(onFrameProcessorFpsChanged, RCTDirectEventBlock);
 RCT_EXPORT_VIEW_PROPERTY(onViewReady, RCTDirectEventBlock);
 
 // Camera View Functions
@@ -12,20 +12,28 @@
 #import <CoreMedia/CMSampleBuffer.h>
 #import "FrameOld.h"
 
+#import "../../cpp/FrameHostObjectBase.h"
+
 using namespace facebook;
 
-class JSI_EXPORT FrameHostObjectOld: public jsi::HostObject {
+class JSI_EXPORT FrameHostObjectOld: public vision::FrameHostObjectBase {
 public:
-  explicit FrameHostObjectOld(FrameOld* frame): frame(frame) {}
+  explicit FrameHostObjectOld(FrameOld* frame);
+  ~FrameHostObjectOld();
 
 public:
-  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
-  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
-  void close();
+  void close() override;
+
+  /**
+   * The FrameOld a Frame Processor Plugin receives for `frameHostObject`, which is either this Frame or a crop of it.
+   * For crops, the FrameOld shares this Frame's buffer and describes the crop's region with its `cropRect`.
+   */
+  static FrameOld* getPluginFrame(vision::FrameHostObjectBase& frameHostObject);
 
 public:
   FrameOld* frame;
 
 private:
-  void assertIsFrameStrong(jsi::Runtime& runtime, const std::string& accessedPropName);
+  // whether the CVPixelBuffer's base address is still locked for the FrameDescriptor's plane pointers
+  bool isLocked;
 };
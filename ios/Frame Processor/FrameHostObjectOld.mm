@@ -8,89 +8,91 @@
 
 #import "FrameHostObjectOld.h"
 #import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
 #import <jsi/jsi.h>
+#import <algorithm>
 
-std::vector<jsi::PropNameID> FrameHostObjectOld::getPropertyNames(jsi::Runtime& rt) {
-  std::vector<jsi::PropNameID> result;
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("toString")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("isValid")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("width")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("height")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("bytesPerRow")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("planesCount")));
-  result.push_back(jsi::PropNameID::forUtf8(rt, std::string("close")));
-  return result;
+static vision::PixelFormat toPixelFormat(OSType pixelFormatType) {
+  switch (pixelFormatType) {
+    case kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange:
+    case kCVPixelFormatType_420YpCbCr8BiPlanarFullRange:
+      return vision::PixelFormat::YUV_420_BIPLANAR;
+    case kCVPixelFormatType_32BGRA:
+      return vision::PixelFormat::BGRA_8888;
+    case kCVPixelFormatType_32RGBA:
+      return vision::PixelFormat::RGBA_8888;
+    default:
+      return vision::PixelFormat::Unknown;
+  }
 }
 
-jsi::Value FrameHostObjectOld::get(jsi::Runtime& runtime, const jsi::PropNameID& propName) {
-  auto name = propName.utf8(runtime);
+// Locks the CVPixelBuffer's base address (read-only) and describes its planes.
+static vision::FrameDescriptor lockAndDescribe(FrameOld* frame) {
+  vision::FrameDescriptor descriptor;
+  auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
+  if (imageBuffer == nil || CVPixelBufferLockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+    return descriptor;
+  }
 
-  if (name == "toString") {
-    auto toString = [this] (jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {
-      if (this->frame == nil) {
-        return jsi::String::createFromUtf8(runtime, "[closed frame]");
-      }
-      auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
-      auto width = CVPixelBufferGetWidth(imageBuffer);
-      auto height = CVPixelBufferGetHeight(imageBuffer);
+  descriptor.width = static_cast<int>(CVPixelBufferGetWidth(imageBuffer));
+  descriptor.height = static_cast<int>(CVPixelBufferGetHeight(imageBuffer));
+  auto pixelFormatType = CVPixelBufferGetPixelFormatType(imageBuffer);
+  descriptor.pixelFormat = toPixelFormat(pixelFormatType);
+  descriptor.colorRange = pixelFormatType == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ? vision::ColorRange::Video : vision::ColorRange::Full;
+  descriptor.timestamp = static_cast<int64_t>(CMTimeGetSeconds(CMSampleBufferGetPresentationTimeStamp(frame.buffer)) * 1'000'000'000);
 
-      NSMutableString* string = [NSMutableString stringWithFormat:@"%lu x %lu Frame", width, height];
-      return jsi::String::createFromUtf8(runtime, string.UTF8String);
-    };
-    return jsi::Function::createFromHostFunction(runtime, jsi::PropNameID::forUtf8(runtime, "toString"), 0, toString);
-  }
-  if (name == "close") {
-    auto close = [this] (jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {
-      if (this->frame == nil) {
-        throw jsi::JSError(runtime, "Trying to close an already closed frame! Did you call frame.close() twice?");
-      }
-      this->close();
-      return jsi::Value::undefined();
-    };
-    return jsi::Function::createFromHostFunction(runtime, jsi::PropNameID::forUtf8(runtime, "close"), 0, close);
+  if (CVPixelBufferIsPlanar(imageBuffer)) {
+    descriptor.planesCount = std::min(static_cast<size_t>(CVPixelBufferGetPlaneCount(imageBuffer)), vision::FrameDescriptor::kMaxPlanes);
+    for (size_t i = 0; i < descriptor.planesCount; i++) {
+      auto& plane = descriptor.planes[i];
+      auto width = CVPixelBufferGetWidthOfPlane(imageBuffer, i);
+      plane.data = static_cast<uint8_t*>(CVPixelBufferGetBaseAddressOfPlane(imageBuffer, i));
+      plane.rowStride = static_cast<int>(CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, i));
+      plane.size = plane.rowStride * CVPixelBufferGetHeightOfPlane(imageBuffer, i);
+      // e.g. the interleaved CbCr plane of 420YpCbCr8BiPlanar has two bytes per pixel
+      plane.pixelStride = static_cast<int>(width > 0 ? std::max(plane.rowStride / static_cast<int>(width), 1) : 1);
+    }
+  } else {
+    auto& plane = descriptor.planes[0];
+    descriptor.planesCount = 1;
+    plane.data = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(imageBuffer));
+    plane.rowStride = static_cast<int>(CVPixelBufferGetBytesPerRow(imageBuffer));
+    plane.size = CVPixelBufferGetDataSize(imageBuffer);
+    plane.pixelStride = 4;
   }
 
-  if (name == "isValid") {
-    auto isValid = frame != nil && CMSampleBufferIsValid(frame.buffer);
-    return jsi::Value(isValid);
-  }
-  if (name == "width") {
-    this->assertIsFrameStrong(runtime, name);
-    auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
-    auto width = CVPixelBufferGetWidth(imageBuffer);
-    return jsi::Value((double) width);
-  }
-  if (name == "height") {
-    this->assertIsFrameStrong(runtime, name);
-    auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
-    auto height = CVPixelBufferGetHeight(imageBuffer);
-    return jsi::Value((double) height);
-  }
-  if (name == "bytesPerRow") {
-    this->assertIsFrameStrong(runtime, name);
-    auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
-    auto bytesPerRow = CVPixelBufferGetBytesPerRow(imageBuffer);
-    return jsi::Value((double) bytesPerRow);
-  }
-  if (name == "planesCount") {
-    this->assertIsFrameStrong(runtime, name);
-    auto imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
-    auto planesCount = CVPixelBufferGetPlaneCount(imageBuffer);
-    return jsi::Value((double) planesCount);
-  }
+  descriptor.isValid = true;
+  return descriptor;
+}
 
-  return jsi::Value::undefined();
+FrameHostObjectOld::FrameHostObjectOld(FrameOld* frame): vision::FrameHostObjectBase(lockAndDescribe(frame)), frame(frame) {
+  isLocked = descriptor.isValid;
+}
+
+FrameHostObjectOld::~FrameHostObjectOld() {
+  if (isLocked && frame != nil) {
+    CVPixelBufferUnlockBaseAddress(CMSampleBufferGetImageBuffer(frame.buffer), kCVPixelBufferLock_ReadOnly);
+  }
 }
 
-void FrameHostObjectOld::assertIsFrameStrong(jsi::Runtime &runtime, const std::string &accessedPropName) {
-  if (frame == nil) {
-    auto message = "Cannot get `" + accessedPropName + "`, frame is already closed!";
-    throw jsi::JSError(runtime, message.c_str());
+FrameOld* FrameHostObjectOld::getPluginFrame(vision::FrameHostObjectBase& frameHostObject) {
+  auto& source = static_cast<FrameHostObjectOld&>(frameHostObject.getSourceFrame());
+  if (&source == &frameHostObject) {
+    return source.frame;
   }
+  auto rect = frameHostObject.getSourceRect();
+  return [[FrameOld alloc] initWithBuffer:source.frame.buffer
+                              orientation:source.frame.orientation
+                                 cropRect:CGRectMake(rect.x, rect.y, rect.width, rect.height)];
 }
 
 void FrameHostObjectOld::close() {
+  invalidate();
   if (frame != nil) {
+    if (isLocked) {
+      CVPixelBufferUnlockBaseAddress(CMSampleBufferGetImageBuffer(frame.buffer), kCVPixelBufferLock_ReadOnly);
+      isLocked = false;
+    }
     CMSampleBufferInvalidate(frame.buffer);
     // ARC will hopefully delete it lol
     this->frame = nil;
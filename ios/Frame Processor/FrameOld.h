@@ -10,13 +10,20 @@
 
 #import <Foundation/Foundation.h>
 #import <CoreMedia/CMSampleBuffer.h>
+#import <CoreGraphics/CGGeometry.h>
 #import <UIKit/UIImage.h>
 
 @interface FrameOld : NSObject
 
 - (instancetype) initWithBuffer:(CMSampleBufferRef)buffer orientation:(UIImageOrientation)orientation;
+- (instancetype) initWithBuffer:(CMSampleBufferRef)buffer orientation:(UIImageOrientation)orientation cropRect:(CGRect)cropRect;
 
 @property (nonatomic, readonly) CMSampleBufferRef buffer;
 @property (nonatomic, readonly) UIImageOrientation orientation;
+/**
+ * The region of the buffer a Frame Processor Plugin should process, in pixels.
+ * This is the whole buffer, unless the plugin was called with a `frame.crop(...)`.
+ */
+@property (nonatomic, readonly) CGRect cropRect;
 
 @end
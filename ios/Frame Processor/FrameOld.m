@@ -9,22 +9,35 @@
 #import "FrameOld.h"
 #import <Foundation/Foundation.h>
 #import <CoreMedia/CMSampleBuffer.h>
+#import <CoreVideo/CoreVideo.h>
 
 @implementation FrameOld {
   CMSampleBufferRef buffer;
   UIImageOrientation orientation;
+  CGRect cropRect;
 }
 
 - (instancetype) initWithBuffer:(CMSampleBufferRef)buffer orientation:(UIImageOrientation)orientation {
+  CVImageBufferRef imageBuffer = CMSampleBufferGetImageBuffer(buffer);
+  CGRect cropRect = CGRectZero;
+  if (imageBuffer != nil) {
+    cropRect = CGRectMake(0, 0, CVPixelBufferGetWidth(imageBuffer), CVPixelBufferGetHeight(imageBuffer));
+  }
+  return [self initWithBuffer:buffer orientation:orientation cropRect:cropRect];
+}
+
+- (instancetype) initWithBuffer:(CMSampleBufferRef)buffer orientation:(UIImageOrientation)orientation cropRect:(CGRect)cropRect {
   self = [super init];
   if (self) {
     _buffer = buffer;
     _orientation = orientation;
+    _cropRect = cropRect;
   }
   return self;
 }
 
 @synthesize buffer = _buffer;
 @synthesize orientation = _orientation;
+@synthesize cropRect = _cropRect;
 
 @end
@@ -0,0 +1,61 @@
+//
+//  FrameProcessorPerformanceDataCollector.h
+//  VisionCameraOld
+//
+//  Created by Marc Rousavy on 30.08.21.
+//  Copyright © 2021 mrousavy. All rights reserved.
+//
+
+#pragma once
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+
+/**
+ * Called when the Frame Processor's rate changed, or - if `frameProcessorFps` is fixed - when there is a new suggestion.
+ * `mode` is the C++ FrameRateMode, durations are in milliseconds.
+ */
+typedef void (^FrameRateDecisionCallback)(NSInteger mode, double fps, double previousFps, double suggestedFps, double cameraFps,
+                                          double averageExecutionTime, double averageLatency);
+
+/**
+ * Collects the Frame Processor's latency histograms and Frame counters of a single Camera in native code (see cpp/FrameProcessorStats.h),
+ * so they can be read from JS with `getFrameProcessorStats(viewTag)`.
+ *
+ * Also decides which Frames are processed according to `frameProcessorFps` (see cpp/FrameRateController.h)
+ * and `frameProcessorChangeThreshold` (see cpp/FrameChangeDetector.h).
+ */
+@interface FrameProcessorPerformanceDataCollector : NSObject
+
+/**
+ * The Camera's React view tag. Once set, the stats are available through `getFrameProcessorStats(viewTag)`.
+ */
+@property (nonatomic, strong, nullable) NSNumber* viewTag;
+@property (nonatomic, copy, nullable) FrameRateDecisionCallback onFrameRateDecision;
+
+- (void) frameDelivered;
+- (void) frameThrottled;
+- (void) frameUnchanged;
+- (void) frameDropped;
+- (void) recordExecutionTime:(uint64_t)executionTimeNanoseconds latency:(uint64_t)latencyNanoseconds;
+
+/**
+ * Configures which Frames are processed. `mode` must be in the same order as the C++ FrameRateMode enum.
+ */
+- (void) configureFrameRateWithMode:(NSInteger)mode fixedFps:(double)fixedFps latencyBudget:(double)latencyBudgetMilliseconds;
+/**
+ * Returns whether the Frame with the given presentation timestamp should be processed. Must be called for every Frame.
+ */
+- (BOOL) shouldProcessFrame:(int64_t)timestampNanoseconds;
+
+/**
+ * Sets the mean absolute luma difference a Frame needs to be processed. 0 disables the change detection.
+ */
+- (void) setChangeThreshold:(double)threshold;
+/**
+ * Returns whether the Frame differs enough from the last processed Frame. Always true if the change detection is disabled.
+ * Must be called from a single thread (the Camera's video queue).
+ */
+- (BOOL) hasFrameChanged:(CMSampleBufferRef _Nonnull)sampleBuffer;
+
+@end
@@ -0,0 +1,130 @@
+//
+//  FrameProcessorPerformanceDataCollector.mm
+//  VisionCameraOld
+//
+//  Created by Marc Rousavy on 30.08.21.
+//  Copyright © 2021 mrousavy. All rights reserved.
+//
+
+#import "FrameProcessorPerformanceDataCollector.h"
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+
+#import <algorithm>
+#import <chrono>
+#import <memory>
+
+#import "../../cpp/FrameChangeDetector.h"
+#import "../../cpp/FrameProcessorStats.h"
+#import "../../cpp/FrameRateController.h"
+
+@implementation FrameProcessorPerformanceDataCollector {
+  std::shared_ptr<vision::FrameProcessorStats> stats;
+  vision::FrameRateController rateController;
+  vision::FrameChangeDetector changeDetector;
+}
+
+- (instancetype) init {
+  self = [super init];
+  if (self) {
+    stats = std::make_shared<vision::FrameProcessorStats>();
+  }
+  return self;
+}
+
+- (void) dealloc {
+  if (_viewTag != nil) {
+    vision::FrameProcessorStats::unregisterView(_viewTag.intValue);
+  }
+}
+
+- (void) setViewTag:(NSNumber*)viewTag {
+  if (_viewTag != nil) {
+    vision::FrameProcessorStats::unregisterView(_viewTag.intValue);
+  }
+  _viewTag = viewTag;
+  if (viewTag != nil) {
+    vision::FrameProcessorStats::registerView(viewTag.intValue, stats);
+  }
+}
+
+- (void) frameDelivered {
+  stats->recordFrameDelivered();
+}
+
+- (void) frameThrottled {
+  stats->recordFrameThrottled();
+}
+
+- (void) frameUnchanged {
+  stats->recordFrameUnchanged();
+}
+
+- (void) frameDropped {
+  stats->recordFrameDropped();
+}
+
+- (void) recordExecutionTime:(uint64_t)executionTimeNanoseconds latency:(uint64_t)latencyNanoseconds {
+  auto executionTime = std::chrono::nanoseconds(executionTimeNanoseconds);
+  auto latency = std::chrono::nanoseconds(latencyNanoseconds);
+  stats->recordExecutionTime(executionTime);
+  stats->recordLatency(latency);
+
+  auto decision = rateController.recordFrame(executionTime, latency);
+  auto onFrameRateDecision = _onFrameRateDecision;
+  if (decision.has_value() && onFrameRateDecision != nil) {
+    auto toMilliseconds = [](std::chrono::nanoseconds duration) {
+      return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    onFrameRateDecision(static_cast<NSInteger>(decision->mode), decision->fps, decision->previousFps, decision->suggestedFps,
+                        decision->cameraFps, toMilliseconds(decision->averageExecutionTime), toMilliseconds(decision->averageLatency));
+  }
+}
+
+- (void) configureFrameRateWithMode:(NSInteger)mode fixedFps:(double)fixedFps latencyBudget:(double)latencyBudgetMilliseconds {
+  vision::FrameRateConfig config;
+  config.mode = static_cast<vision::FrameRateMode>(std::clamp<NSInteger>(mode, 0, static_cast<NSInteger>(vision::FrameRateMode::LatencyBudget)));
+  config.fixedFps = fixedFps;
+  config.latencyBudget = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::milli>(latencyBudgetMilliseconds));
+  rateController.configure(config);
+}
+
+- (BOOL) shouldProcessFrame:(int64_t)timestampNanoseconds {
+  return rateController.shouldProcess(timestampNanoseconds);
+}
+
+- (void) setChangeThreshold:(double)threshold {
+  changeDetector.setThreshold(threshold);
+}
+
+- (BOOL) hasFrameChanged:(CMSampleBufferRef)sampleBuffer {
+  if (!changeDetector.isEnabled()) {
+    return YES;
+  }
+  auto imageBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
+  // only the luma plane of 420YpCbCr8BiPlanar is compared, other Frames always count as changed.
+  if (imageBuffer == nil || !CVPixelBufferIsPlanar(imageBuffer) || CVPixelBufferGetPlaneCount(imageBuffer) != 2 ||
+      CVPixelBufferLockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+    return YES;
+  }
+
+  vision::FrameDescriptor descriptor;
+  descriptor.width = static_cast<int>(CVPixelBufferGetWidth(imageBuffer));
+  descriptor.height = static_cast<int>(CVPixelBufferGetHeight(imageBuffer));
+  descriptor.pixelFormat = vision::PixelFormat::YUV_420_BIPLANAR;
+  descriptor.planesCount = 2;
+  for (size_t i = 0; i < descriptor.planesCount; i++) {
+    auto& plane = descriptor.planes[i];
+    plane.data = static_cast<uint8_t*>(CVPixelBufferGetBaseAddressOfPlane(imageBuffer, i));
+    plane.rowStride = static_cast<int>(CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, i));
+    plane.size = plane.rowStride * CVPixelBufferGetHeightOfPlane(imageBuffer, i);
+    plane.pixelStride = i == 0 ? 1 : 2;
+  }
+  descriptor.isValid = true;
+
+  auto hasChanged = changeDetector.hasChanged(descriptor);
+  CVPixelBufferUnlockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
+  return hasChanged ? YES : NO;
+}
+
+@end
@@ -9,6 +9,73 @@
 #import "FrameProcessorPluginRegistryOld.h"
 #import <Foundation/Foundation.h>
 
+#import <jsi/jsi.h>
+#import <string>
+
+#import "FrameHostObjectOld.h"
+#import "../React Utils/JSIUtils.h"
+#import "../../cpp/FrameProcessorPluginRegistryNative.h"
+#import "../../cpp/FrameProcessorStats.h"
+#import "../../cpp/FrameTracer.h"
+
+using namespace facebook;
+
+/**
+ * Creates the `__<name>` function of an Objective-C plugin, which converts the arguments, calls the plugin and converts its result.
+ */
+static jsi::Function createPluginFunction(jsi::Runtime& runtime, const std::string& pluginName, FrameProcessorPlugin callback) {
+  auto traceName = vision::FrameTracer::shared().intern("plugin " + pluginName);
+
+  auto function = [callback, traceName](jsi::Runtime& runtime,
+                                        const jsi::Value& thisValue,
+                                        const jsi::Value* arguments,
+                                        size_t count) -> jsi::Value {
+    auto frameHostObject = arguments[0].asObject(runtime).asHostObject(runtime);
+    auto frame = dynamic_cast<vision::FrameHostObjectBase*>(frameHostObject.get());
+    if (frame == nullptr) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin must be called with a Frame as its first argument!");
+    }
+    if (!frame->descriptor.isValid) {
+      throw jsi::JSError(runtime, "Frame Processor Plugin was called with a Frame that has already been released!");
+    }
+
+    auto timestamp = frame->descriptor.timestamp;
+    auto stats = frame->getSourceFrame().stats.get();
+
+    vision::TraceScope argumentsTrace("convertArguments", timestamp);
+    vision::PluginStageScope argumentsStage(stats, vision::PluginStage::ArgumentsConversion);
+    auto args = convertJSICStyleArrayToNSArray(runtime,
+                                               arguments + 1, // start at index 1 since first arg = Frame
+                                               count - 1, // use smaller count
+                                               nullptr);
+    argumentsStage.end();
+    argumentsTrace.end();
+
+    vision::TraceScope pluginTrace(traceName, timestamp);
+    vision::PluginStageScope callStage(stats, vision::PluginStage::Call);
+    id result;
+    try {
+      result = callback(FrameHostObjectOld::getPluginFrame(*frame), args);
+    } catch (...) {
+      if (stats != nullptr) {
+        stats->recordPluginError();
+      }
+      throw;
+    }
+    callStage.end();
+    pluginTrace.end();
+
+    vision::TraceScope resultTrace("convertResult", timestamp);
+    vision::PluginStageScope resultStage(stats, vision::PluginStage::ResultConversion);
+    return convertObjCObjectToJSIValue(runtime, result);
+  };
+
+  return jsi::Function::createFromHostFunction(runtime,
+                                               jsi::PropNameID::forAscii(runtime, pluginName),
+                                               1, // frame
+                                               function);
+}
+
 @implementation FrameProcessorPluginRegistryOld
 
 + (NSMutableDictionary<NSString*, FrameProcessorPlugin>*)frameProcessorPlugins {
@@ -24,6 +91,14 @@
   NSAssert(!alreadyExists, @"Tried to two Frame Processor Plugins with the same name! Either choose unique names, or remove the unused plugin.");
 
   [[FrameProcessorPluginRegistryOld frameProcessorPlugins] setValue:callback forKey:name];
+
+  // installed into every worklet runtime with its next Frame Processor, and created there on its first use.
+  // the name already has the `__` prefix, which the native registry adds itself.
+  std::string pluginName = [name UTF8String];
+  auto registryName = pluginName.rfind("__", 0) == 0 ? pluginName.substr(2) : pluginName;
+  vision::FrameProcessorPluginRegistryNative::shared().addPlatformPlugin(registryName, [pluginName, callback](jsi::Runtime& runtime) {
+    return createPluginFunction(runtime, pluginName, callback);
+  });
 }
 
 @end
@@ -12,6 +12,7 @@
 #import "FrameHostObjectOld.h"
 
 #import <memory>
+#import <optional>
 
 #import <React/RCTBridge.h>
 #import <ReactCommon/RCTTurboModule.h>
@@ -35,6 +36,15 @@
 
 #import "FrameProcessorCallback.h"
 #import "../React Utils/JSIUtils.h"
+#import "../../cpp/BufferPoolBindings.h"
+#import "../../cpp/FrameProcessorPluginRegistryNative.h"
+#import "../../cpp/FrameProcessorStats.h"
+#import "../../cpp/FrameProcessorStatsBindings.h"
+#import "../../cpp/FrameRetentionMonitor.h"
+#import "../../cpp/FrameTracer.h"
+#import "../../cpp/FrameTracerBindings.h"
+#import "../../cpp/ParallelPluginRunner.h"
+#import "../../cpp/RuntimeThreadScope.h"
 
 // Forward declarations for the Swift classes
 __attribute__((objc_runtime_name("_TtC12VisionCameraOld12CameraQueues")))
@@ -46,6 +56,23 @@ __attribute__((objc_runtime_name("_TtC12VisionCameraOld10CameraViewOld")))
 @property (nonatomic, copy) FrameProcessorCallback _Nullable frameProcessorCallback;
 @end
 
+#ifdef ENABLE_FRAME_PROCESSORS
+/**
+ * Installs the plugins the runtime doesn't have yet, and the bindings plugins rely on.
+ * Must be called on the runtime's own thread (the Frame Processor queue), inside a RuntimeThreadScope.
+ */
+static void installPlugins(jsi::Runtime& visionRuntime) {
+  // plugins are resolved on their first use, this only adds the ones the runtime doesn't know yet.
+  vision::FrameProcessorPluginRegistryNative::shared().installPlugins(visionRuntime);
+  if (!vision::FrameProcessorPluginRegistryNative::arePluginsInstalled(visionRuntime)) {
+    // TODO: call reanimated::RuntimeDecorator::decorateRuntime(*runtime, "FRAME_PROCESSOR");
+    visionRuntime.global().setProperty(visionRuntime, "_FRAME_PROCESSOR", jsi::Value(true));
+    vision::ParallelPluginRunner::shared().installJSIBindings(visionRuntime);
+    vision::FrameProcessorPluginRegistryNative::markPluginsInstalled(visionRuntime);
+  }
+}
+#endif
+
 @implementation FrameProcessorRuntimeManagerOld {
 #ifdef ENABLE_FRAME_PROCESSORS
   std::shared_ptr<reanimated::WorkletRuntime> workletRuntime;
@@ -88,39 +115,8 @@ __attribute__((objc_runtime_name("_TtC12VisionCameraOld10CameraViewOld")))
                                   const jsi::Value& thisValue,
                                   const jsi::Value* arguments,
                                   size_t count) -> jsi::Value {
+    // the runtime is only modified on the Frame Processor queue, where it runs - the plugins are installed with its first Frame.
     self->workletRuntime = reanimated::extractWorkletRuntime(rnRuntime, arguments[2].asObject(rnRuntime));
-    jsi::Runtime &visionRuntime = self->workletRuntime->getJSIRuntime();
-
-    // TODO: call reanimated::RuntimeDecorator::decorateRuntime(*runtime, "FRAME_PROCESSOR");
-    visionRuntime.global().setProperty(visionRuntime, "_FRAME_PROCESSOR", jsi::Value(true));
-
-    for (NSString* pluginKey in [FrameProcessorPluginRegistryOld frameProcessorPlugins]) {
-      auto pluginName = [pluginKey UTF8String];
-
-      NSLog(@"FrameProcessorBindings: Installing Frame Processor plugin \"%s\"...", pluginName);
-      FrameProcessorPlugin callback = [[FrameProcessorPluginRegistryOld frameProcessorPlugins] valueForKey:pluginKey];
-
-      auto function = [callback](jsi::Runtime& runtime,
-                                              const jsi::Value& thisValue,
-                                              const jsi::Value* arguments,
-                                              size_t count) -> jsi::Value {
-        auto frameHostObject = arguments[0].asObject(runtime).asHostObject(runtime);
-        auto frame = static_cast<FrameHostObjectOld*>(frameHostObject.get());
-
-        auto args = convertJSICStyleArrayToNSArray(runtime,
-                                                   arguments + 1, // start at index 1 since first arg = Frame
-                                                   count - 1, // use smaller count
-                                                   nullptr);
-        id result = callback(frame->frame, args);
-
-        return convertObjCObjectToJSIValue(runtime, result);
-      };
-
-      visionRuntime.global().setProperty(visionRuntime, pluginName, jsi::Function::createFromHostFunction(visionRuntime,
-                                                                                                jsi::PropNameID::forAscii(visionRuntime, pluginName),
-                                                                                                1, // frame
-                                                                                                function));
-    }
 
     NSLog(@"FrameProcessorBindings: Setting new frame processor...");
     if (!arguments[0].isNumber()) throw jsi::JSError(rnRuntime, "Camera::setFrameProcessor: First argument ('viewTag') must be a number!");
@@ -142,6 +138,8 @@ __attribute__((objc_runtime_name("_TtC12VisionCameraOld10CameraViewOld")))
 
         std::weak_ptr<reanimated::WorkletRuntime> weakWorkletRuntime = workletRuntime;
         std::weak_ptr<reanimated::ShareableWorklet> weakShareableWorklet = worklet;
+        // the registry version the plugins have been installed at, only used on the Frame Processor queue.
+        auto installedVersion = std::make_shared<std::optional<uint64_t>>();
 
         view.frameProcessorCallback = ^(FrameOld* frame) {
           auto workletRuntime = weakWorkletRuntime.lock();
@@ -150,16 +148,39 @@ __attribute__((objc_runtime_name("_TtC12VisionCameraOld10CameraViewOld")))
             return;
           }
 
-          auto frameHostObject = std::make_shared<FrameHostObjectOld>(frame);
           jsi::Runtime &runtime = workletRuntime->getJSIRuntime();
+          vision::RuntimeThreadScope runtimeScope(runtime);
+          // before the first Frame, and whenever plugins have been added since.
+          auto pluginsVersion = vision::FrameProcessorPluginRegistryNative::shared().getVersion();
+          if (*installedVersion != pluginsVersion) {
+            installPlugins(runtime);
+            *installedVersion = pluginsVersion;
+          }
+
+          vision::TraceScope callbackTrace("frameProcessorCallback");
+          vision::TraceScope createTrace("createHostObject");
+          auto frameHostObject = std::make_shared<FrameHostObjectOld>(frame);
+          // plugin calls with this Frame are recorded into the Camera's stats
+          frameHostObject->stats = vision::FrameProcessorStats::get(static_cast<int>(viewTag));
           auto hostObject = jsi::Object::createFromHostObject(runtime, frameHostObject);
-          workletRuntime->runGuarded(shareableWorklet, hostObject);
+          createTrace.end();
+          {
+            vision::TraceScope trace("runGuarded", frameHostObject->descriptor.timestamp);
+            try {
+              workletRuntime->runGuarded(shareableWorklet, hostObject);
+            } catch (...) {
+              if (frameHostObject->stats != nullptr) {
+                frameHostObject->stats->recordFrameProcessorError();
+              }
+              throw;
+            }
+          }
 
-          // Manually free the buffer because:
-          //  1. we are sure we don't need it anymore, the frame processor worklet has finished executing.
-          //  2. we don't know when the JS runtime garbage collects this object, it might be holding it for a few more frames
-          //     which then blocks the camera queue from pushing new frames (memory limit)
-          frameHostObject->close();
+          // Release the frame processor's reference instead of waiting for the garbage collector, because
+          // the JS runtime might hold it for a few more frames, which then blocks the camera queue from pushing new frames (memory limit).
+          // If the worklet retained the frame (incrementRefCount()), it is closed once its last reference is released.
+          frameHostObject->decrementRefCount();
+          vision::FrameRetentionMonitor::shared().check();
         };
 
         NSLog(@"FrameProcessorBindings: Frame processor set!");
@@ -201,6 +222,18 @@ __attribute__((objc_runtime_name("_TtC12VisionCameraOld10CameraViewOld")))
                                                                                                            1,  // viewTag
                                                                                                            unsetFrameProcessor));
 
+  vision::installBufferPoolBindings(jsiRuntime);
+  vision::installFrameTracerBindings(jsiRuntime);
+  vision::installFrameProcessorStatsBindings(jsiRuntime, [](int viewTag) {
+    return vision::FrameProcessorStats::get(viewTag);
+  });
+
+  vision::FrameRetentionMonitor::shared().setListener([](const vision::FrameRetentionReport& report) {
+    NSLog(@"FrameProcessorBindings: Frame %lld has been held for %lld ms (%zu Frames held in total)! "
+          "The Camera stalls once all of its buffers are held, did you forget to call frame.decrementRefCount()?",
+          static_cast<long long>(report.timestamp), static_cast<long long>(report.heldFor.count()), report.framesHeld);
+  });
+
   NSLog(@"FrameProcessorBindings: Finished installing bindings.");
 #endif
 }
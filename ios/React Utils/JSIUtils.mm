@@ -159,9 +159,9 @@ id convertJSIValueToObjCObject(jsi::Runtime &runtime, const jsi::Value &value, s
     }
     if (o.isHostObject(runtime)) {
       auto hostObject = o.asHostObject(runtime);
-      auto frame = dynamic_cast<FrameHostObjectOld*>(hostObject.get());
+      auto frame = dynamic_cast<vision::FrameHostObjectBase*>(hostObject.get());
       if (frame != nullptr) {
-        return frame->frame;
+        return FrameHostObjectOld::getPluginFrame(*frame);
       }
     }
     return convertJSIObjectToNSDictionary(runtime, o, jsInvoker);
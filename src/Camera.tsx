@@ -1,6 +1,14 @@
 import React from 'react';
 import { requireNativeComponent, NativeModules, NativeSyntheticEvent, findNodeHandle, NativeMethods, Platform } from 'react-native';
-import type { FrameProcessorPerformanceSuggestion, VideoFileType } from '.';
+import type {
+  FrameProcessorFpsChange,
+  FrameProcessorPerformanceSuggestion,
+  FrameProcessorQueueStats,
+  FrameProcessorStats,
+  FrameRecordingStats,
+  FrameReplayOptions,
+  VideoFileType,
+} from '.';
 import type { CameraDevice } from './CameraDevice';
 import type { ErrorWithCause } from './CameraError';
 import { CameraCaptureError, CameraRuntimeError, tryParseNativeCameraError, isErrorWithCause } from './CameraError';
@@ -23,7 +31,13 @@ interface OnErrorEvent {
 }
 type NativeCameraViewOldProps = Omit<
   CameraProps,
-  'device' | 'onInitialized' | 'onError' | 'onFrameProcessorPerformanceSuggestionAvailable' | 'frameProcessor' | 'frameProcessorFps'
+  | 'device'
+  | 'onInitialized'
+  | 'onError'
+  | 'onFrameProcessorPerformanceSuggestionAvailable'
+  | 'onFrameProcessorFpsChanged'
+  | 'frameProcessor'
+  | 'frameProcessorFps'
 > & {
   cameraId: string;
   frameProcessorFps?: number; // native cannot use number | string, so we use '-1' for 'auto'
@@ -31,6 +45,7 @@ type NativeCameraViewOldProps = Omit<
   onInitialized?: (event: NativeSyntheticEvent<void>) => void;
   onError?: (event: NativeSyntheticEvent<OnErrorEvent>) => void;
   onFrameProcessorPerformanceSuggestionAvailable?: (event: NativeSyntheticEvent<FrameProcessorPerformanceSuggestion>) => void;
+  onFrameProcessorFpsChanged?: (event: NativeSyntheticEvent<FrameProcessorFpsChange>) => void;
   onViewReady: () => void;
 };
 type RefType = React.Component<NativeCameraViewOldProps> & Readonly<NativeMethods>;
@@ -88,6 +103,7 @@ export class Camera extends React.PureComponent<CameraProps> {
     this.onInitialized = this.onInitialized.bind(this);
     this.onError = this.onError.bind(this);
     this.onFrameProcessorPerformanceSuggestionAvailable = this.onFrameProcessorPerformanceSuggestionAvailable.bind(this);
+    this.onFrameProcessorFpsChanged = this.onFrameProcessorFpsChanged.bind(this);
     this.ref = React.createRef<RefType>();
     this.lastFrameProcessor = undefined;
   }
@@ -315,6 +331,116 @@ export class Camera extends React.PureComponent<CameraProps> {
     }
   }
 
+  /**
+   * Get the counters of the queue between the Camera and the Frame Processor, see {@linkcode CameraProps.frameProcessorDropPolicy}.
+   * The counters are reset whenever the Camera session is re-configured.
+   *
+   * @example
+   * ```ts
+   * const stats = camera.current.getFrameProcessorQueueStats()
+   * console.log(`Dropped ${stats.dropped} of ${stats.enqueued + stats.dropped} Frames`)
+   * ```
+   * @platform Android
+   */
+  public getFrameProcessorQueueStats(): FrameProcessorQueueStats {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    if (global.getFrameProcessorQueueStats == null) {
+      throw new CameraRuntimeError('parameter/unsupported-os', 'Frame Processor queue stats are only available on Android.');
+    }
+    // @ts-expect-error JSI functions aren't typed
+    return global.getFrameProcessorQueueStats(this.handle);
+  }
+
+  /**
+   * Get latency histograms and counters of the Frame Processor, e.g. to spot stalls that an average execution time hides.
+   * Execution time and latency are recorded in a log-linear histogram, so percentiles are accurate to ~3%.
+   *
+   * @example
+   * ```ts
+   * const stats = camera.current.getFrameProcessorStats()
+   * console.log(`p99 latency: ${stats.latency.p99}ms, dropped ${stats.framesDropped} of ${stats.framesDelivered} Frames`)
+   * ```
+   */
+  public getFrameProcessorStats(): FrameProcessorStats {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    return global.getFrameProcessorStats(this.handle);
+  }
+
+  /**
+   * Record every Frame that is passed to the Frame Processor (planes, strides, pixel format and timestamp) into a file at `path`,
+   * until {@linkcode Camera.stopFrameRecording | stopFrameRecording()} is called.
+   *
+   * The recording can be replayed through the Frame Processor with {@linkcode Camera.startFrameReplay | startFrameReplay(...)},
+   * or on a computer with the benchmarks in the repository. Recordings are uncompressed, so they grow by ~1.5 bytes per pixel per Frame.
+   *
+   * @example
+   * ```ts
+   * camera.current.startFrameRecording(`${cachesDirectory}/frames.vcframes`)
+   * ```
+   * @platform Android
+   */
+  public startFrameRecording(path: string): void {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    if (global.startFrameRecording == null) {
+      throw new CameraRuntimeError('parameter/unsupported-os', 'Frame recordings are only available on Android.');
+    }
+    // @ts-expect-error JSI functions aren't typed
+    global.startFrameRecording(this.handle, path);
+  }
+
+  /**
+   * Stop the Frame recording started with {@linkcode Camera.startFrameRecording | startFrameRecording(...)} and write the remaining Frames.
+   * @platform Android
+   */
+  public stopFrameRecording(): FrameRecordingStats {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    if (global.stopFrameRecording == null) {
+      throw new CameraRuntimeError('parameter/unsupported-os', 'Frame recordings are only available on Android.');
+    }
+    // @ts-expect-error JSI functions aren't typed
+    return global.stopFrameRecording(this.handle);
+  }
+
+  /**
+   * Replay the Frames recorded at `path` through the Frame Processor instead of the Camera's Frames, e.g. to reproduce a performance problem.
+   * The Camera's Frames are skipped until all Frames have been replayed or {@linkcode Camera.stopFrameReplay | stopFrameReplay()} is called.
+   *
+   * Replayed Frames have no native Camera image, so Java Frame Processor Plugins cannot be called with them - C++ Frame Processor Plugins can.
+   *
+   * @example
+   * ```ts
+   * camera.current.startFrameReplay(path, { speed: 'maximum', loop: true })
+   * ```
+   * @platform Android
+   */
+  public startFrameReplay(path: string, options?: FrameReplayOptions): void {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    if (global.startFrameReplay == null) {
+      throw new CameraRuntimeError('parameter/unsupported-os', 'Frame replays are only available on Android.');
+    }
+    // @ts-expect-error JSI functions aren't typed
+    global.startFrameReplay(this.handle, path, options);
+  }
+
+  /**
+   * Stop the replay started with {@linkcode Camera.startFrameReplay | startFrameReplay(...)}, and go back to the Camera's Frames.
+   * @platform Android
+   */
+  public stopFrameReplay(): void {
+    this.assertFrameProcessorsEnabled();
+    // @ts-expect-error JSI functions aren't typed
+    if (global.stopFrameReplay == null) {
+      throw new CameraRuntimeError('parameter/unsupported-os', 'Frame replays are only available on Android.');
+    }
+    // @ts-expect-error JSI functions aren't typed
+    global.stopFrameReplay(this.handle);
+  }
+
   //#region Static Functions (NativeModule)
   /**
    * Get a list of all available camera devices on the current phone.
@@ -420,6 +546,10 @@ export class Camera extends React.PureComponent<CameraProps> {
     if (this.props.onFrameProcessorPerformanceSuggestionAvailable != null)
       this.props.onFrameProcessorPerformanceSuggestionAvailable(event.nativeEvent);
   }
+
+  private onFrameProcessorFpsChanged(event: NativeSyntheticEvent<FrameProcessorFpsChange>): void {
+    this.props.onFrameProcessorFpsChanged?.(event.nativeEvent);
+  }
   //#endregion
 
   //#region Lifecycle
@@ -436,8 +566,23 @@ export class Camera extends React.PureComponent<CameraProps> {
 
   private setFrameProcessor(frameProcessor: (frame: FrameOld) => void): void {
     this.assertFrameProcessorsEnabled();
+    const {
+      frameProcessorRuntimes = 1,
+      frameProcessorDispatch = 'least-loaded',
+      frameProcessorInOrder = false,
+      frameProcessorMaxAsyncTasks = 0,
+    } = this.props;
+    const workletRuntime =
+      Platform.OS === 'android' && frameProcessorRuntimes > 1
+        ? FrameProcessorContext.getWorkletRuntimes(frameProcessorRuntimes)
+        : FrameProcessorContext.workletRuntime;
     // @ts-expect-error JSI functions aren't typed
-    global.setFrameProcessor(this.handle, FrameProcessorContext.createWorklet(frameProcessor), FrameProcessorContext.workletRuntime);
+    global.setFrameProcessor(this.handle, FrameProcessorContext.createWorklet(frameProcessor), workletRuntime, {
+      dispatch: frameProcessorDispatch,
+      inOrder: frameProcessorInOrder,
+      maxAsyncTasks: frameProcessorMaxAsyncTasks,
+      asyncRuntime: Platform.OS === 'android' && frameProcessorMaxAsyncTasks > 0 ? FrameProcessorContext.getAsyncWorkletRuntime() : undefined,
+    });
   }
 
   private unsetFrameProcessor(): void {
@@ -456,11 +601,16 @@ export class Camera extends React.PureComponent<CameraProps> {
   }
 
   /** @internal */
-  componentDidUpdate(): void {
+  componentDidUpdate(prevProps: CameraProps): void {
     if (!this.isNativeViewMounted) return;
     const frameProcessor = this.props.frameProcessor;
-    if (frameProcessor !== this.lastFrameProcessor) {
-      // frameProcessor argument identity changed. Update native to reflect the change.
+    const hasFrameProcessorOptionsChanged =
+      this.props.frameProcessorRuntimes !== prevProps.frameProcessorRuntimes ||
+      this.props.frameProcessorDispatch !== prevProps.frameProcessorDispatch ||
+      this.props.frameProcessorInOrder !== prevProps.frameProcessorInOrder ||
+      this.props.frameProcessorMaxAsyncTasks !== prevProps.frameProcessorMaxAsyncTasks;
+    if (frameProcessor !== this.lastFrameProcessor || (frameProcessor != null && hasFrameProcessorOptionsChanged)) {
+      // frameProcessor argument identity or the runtimes it runs on changed. Update native to reflect the change.
       if (frameProcessor != null) this.setFrameProcessor(frameProcessor);
       else this.unsetFrameProcessor();
 
@@ -472,7 +622,14 @@ export class Camera extends React.PureComponent<CameraProps> {
   /** @internal */
   public render(): React.ReactNode {
     // We remove the big `device` object from the props because we only need to pass `cameraId` to native.
-    const { device, frameProcessor, frameProcessorFps, ...props } = this.props;
+    const {
+      device,
+      frameProcessor,
+      frameProcessorFps,
+      frameProcessorDispatch,
+      frameProcessorInOrder,
+      ...props
+    } = this.props;
     return (
       <NativeCameraViewOld
         {...props}
@@ -483,6 +640,7 @@ export class Camera extends React.PureComponent<CameraProps> {
         onInitialized={this.onInitialized}
         onError={this.onError}
         onFrameProcessorPerformanceSuggestionAvailable={this.onFrameProcessorPerformanceSuggestionAvailable}
+        onFrameProcessorFpsChanged={this.onFrameProcessorFpsChanged}
         enableFrameProcessor={frameProcessor != null}
       />
     );
@@ -9,6 +9,159 @@ export interface FrameProcessorPerformanceSuggestion {
   suggestedFrameProcessorFps: number;
 }
 
+export interface FrameProcessorFpsChange {
+  /**
+   * The rate the Frame Processor is called at from now on.
+   */
+  frameProcessorFps: number;
+  /**
+   * The rate that was reported in the previous event.
+   */
+  previousFrameProcessorFps: number;
+  /**
+   * The rate the Camera actually delivers Frames at, which is the upper limit for {@linkcode frameProcessorFps}.
+   */
+  cameraFps: number;
+  /**
+   * The moving average of the Frame Processor's execution time, in milliseconds.
+   */
+  averageExecutionTime: number;
+  /**
+   * The moving average of the time from the Camera delivering a Frame until the Frame Processor returned, in milliseconds.
+   */
+  averageLatency: number;
+}
+
+export interface FrameProcessorQueueStats {
+  /**
+   * The amount of Frames that entered the Frame Processor queue.
+   */
+  enqueued: number;
+  /**
+   * The amount of Frames that were dropped according to the {@linkcode CameraProps.frameProcessorDropPolicy}.
+   */
+  dropped: number;
+  /**
+   * The amount of Frames the Frame Processor was called with.
+   */
+  processed: number;
+}
+
+export interface FrameRecordingStats {
+  /**
+   * The amount of Frames that have been written to the recording.
+   */
+  framesRecorded: number;
+  /**
+   * The amount of Frames that could not be recorded because writing the file fell behind the Camera.
+   */
+  framesDropped: number;
+  /**
+   * The size of the recording, in bytes.
+   */
+  bytesWritten: number;
+}
+
+export interface FrameReplayOptions {
+  /**
+   * * `'recorded'`: Replay the Frames with the intervals they were recorded at, like the Camera delivered them.
+   * * `'maximum'`: Replay the next Frame as soon as the Frame Processor is ready for it, without dropping any Frames.
+   *
+   * @default 'recorded'
+   */
+  speed?: 'recorded' | 'maximum';
+  /**
+   * Start over after the last Frame, until {@linkcode Camera.stopFrameReplay | stopFrameReplay()} is called.
+   *
+   * @default false
+   */
+  loop?: boolean;
+}
+
+export interface LatencyStats {
+  /**
+   * The amount of samples, since the Frame Processor was set.
+   */
+  count: number;
+  /**
+   * The mean, in milliseconds.
+   */
+  mean: number;
+  /**
+   * The median, in milliseconds.
+   */
+  p50: number;
+  /**
+   * The 90th percentile, in milliseconds.
+   */
+  p90: number;
+  /**
+   * The 99th percentile, in milliseconds.
+   */
+  p99: number;
+  /**
+   * The highest sample, in milliseconds.
+   */
+  max: number;
+}
+
+export interface FrameProcessorStats {
+  /**
+   * How long the Frame Processor took to execute, per Frame.
+   */
+  executionTime: LatencyStats;
+  /**
+   * How long it took from the Camera delivering a Frame until the Frame Processor finished executing with it.
+   * This includes the time the Frame waited in the queue.
+   */
+  latency: LatencyStats;
+  /**
+   * The amount of Frames the Camera delivered to the Frame Processor pipeline.
+   */
+  framesDelivered: number;
+  /**
+   * The amount of Frames that were skipped because of the {@linkcode CameraProps.frameProcessorFps} limit.
+   */
+  framesThrottled: number;
+  /**
+   * The amount of Frames that were skipped because they did not differ enough from the last processed Frame,
+   * see {@linkcode CameraProps.frameProcessorChangeThreshold}.
+   */
+  framesUnchanged: number;
+  /**
+   * The amount of Frames that were dropped because the Frame Processor was still busy with a previous Frame.
+   */
+  framesDropped: number;
+  /**
+   * The amount of Frame Processor calls that threw an error.
+   */
+  frameProcessorErrors: number;
+  /**
+   * The amount of Frame Processor Plugin calls with this Camera's Frames that threw an error.
+   */
+  pluginErrors: number;
+  /**
+   * How long Frame Processor Plugin calls took to convert their arguments from JS to native values.
+   */
+  pluginArgumentsConversion: LatencyStats;
+  /**
+   * How long the Frame Processor Plugins themselves took to execute, per call.
+   */
+  pluginCall: LatencyStats;
+  /**
+   * How long Frame Processor Plugin calls took to convert their results from native to JS values.
+   */
+  pluginResultConversion: LatencyStats;
+  /**
+   * The amount of {@linkcode runAsync} tasks that ran.
+   */
+  asyncTasksRun: number;
+  /**
+   * The amount of {@linkcode runAsync} tasks that were skipped because {@linkcode CameraProps.frameProcessorMaxAsyncTasks} were still in flight.
+   */
+  asyncTasksSkipped: number;
+}
+
 export interface CameraProps extends ViewProps {
   /**
    * The Camera Device to use.
@@ -174,6 +327,11 @@ export interface CameraProps extends ViewProps {
    * Called when a new performance suggestion for a Frame Processor is available - either if your Frame Processor is running too fast and frames are being dropped, or because it is able to run faster. Optionally, you can adjust your `frameProcessorFps` accordingly.
    */
   onFrameProcessorPerformanceSuggestionAvailable?: (suggestion: FrameProcessorPerformanceSuggestion) => void;
+  /**
+   * Called when {@linkcode frameProcessorFps} is `'auto'` and the Frame Processor's rate was adjusted to how long it takes to execute.
+   * Called at most once per second, and only if the rate changed noticeably.
+   */
+  onFrameProcessorFpsChanged?: (change: FrameProcessorFpsChange) => void;
   /**
    * A worklet which will be called for every frame the Camera "sees". Throttle the Frame Processor's frame rate with {@linkcode frameProcessorFps}.
    *
@@ -196,7 +354,7 @@ export interface CameraProps extends ViewProps {
   /**
    * Specifies the maximum frame rate the frame processor can use, independent of the Camera's frame rate (`fps` property).
    *
-   * * A value of `'auto'` (default) indicates that the frame processor should execute as fast as it can, without dropping frames. This is achieved by collecting historical data for previous frame processor calls and adjusting frame rate accordingly.
+   * * A value of `'auto'` (default) indicates that the frame processor should execute as fast as it can, without dropping frames. This is achieved by tracking the moving average of the frame processor's execution time and adjusting the frame rate accordingly, up to the Camera's actual frame rate. See {@linkcode frameProcessorRateMode} and {@linkcode onFrameProcessorFpsChanged}.
    * * A value of `1` indicates that the frame processor gets executed once per second, perfect for code scanning.
    * * A value of `10` indicates that the frame processor gets executed 10 times per second, perfect for more realtime use-cases.
    * * A value of `25` indicates that the frame processor gets executed 25 times per second, perfect for high-speed realtime use-cases.
@@ -208,5 +366,112 @@ export interface CameraProps extends ViewProps {
    * @default 'auto'
    */
   frameProcessorFps?: number | 'auto';
+  /**
+   * What the frame rate is adjusted for if {@linkcode frameProcessorFps} is `'auto'`:
+   *
+   * * `'throughput'`: Process as many Frames as possible without building up a backlog.
+   * * `'latency'`: Leave enough room between Frames that even slower ones finish before the next one arrives, and lower the frame rate further if Frames take longer than {@linkcode frameProcessorLatencyBudget} from the Camera to the end of the Frame Processor.
+   *
+   * @default 'throughput'
+   */
+  frameProcessorRateMode?: 'throughput' | 'latency';
+  /**
+   * The time (in milliseconds) a Frame may take from the Camera until the Frame Processor returned, if {@linkcode frameProcessorRateMode} is `'latency'`.
+   *
+   * @default 100
+   */
+  frameProcessorLatencyBudget?: number;
+  /**
+   * Skips Frames that did not change since the last Frame that was passed to the Frame Processor, e.g. while the Camera points at a static scene.
+   *
+   * The change is measured as the mean absolute difference of a subsampled grid of luma (brightness) values, ranging from `0` (identical) to `255`.
+   * Frames below this threshold are skipped before the Frame Processor is called, and counted as `framesUnchanged` in the Frame Processor stats.
+   * Sensor noise alone usually stays below `1`, a value around `2` skips static scenes while still reacting to small movements.
+   *
+   * @default 0 (disabled)
+   */
+  frameProcessorChangeThreshold?: number;
+  /**
+   * The amount of Frames that can wait for the Frame Processor while it is still busy with a previous Frame.
+   *
+   * A deeper queue trades latency for throughput: short spikes in the Frame Processor's execution time no longer drop Frames,
+   * but every queued Frame is older by the time it is processed. The Camera holds on to the queued Frames, so keep this small.
+   *
+   * @platform Android
+   * @default 1
+   */
+  frameProcessorQueueDepth?: number;
+  /**
+   * What happens when a new Frame arrives while the Frame Processor queue (see {@linkcode frameProcessorQueueDepth}) is full:
+   *
+   * * `'keep-latest'`: Drop all queued Frames, so the Frame Processor always gets the most recent Frame (lowest latency)
+   * * `'drop-oldest'`: Drop the oldest queued Frame
+   * * `'drop-newest'`: Drop the new Frame
+   * * `'block'`: Wait up to {@linkcode frameProcessorBlockTimeout} milliseconds for the Frame Processor to make room, then drop the new Frame. This stalls the Camera while waiting.
+   *
+   * @platform Android
+   * @default 'keep-latest'
+   */
+  frameProcessorDropPolicy?: 'keep-latest' | 'drop-oldest' | 'drop-newest' | 'block';
+  /**
+   * The maximum time (in milliseconds) to wait for room in the Frame Processor queue if {@linkcode frameProcessorDropPolicy} is `'block'`.
+   *
+   * @platform Android
+   * @default 100
+   */
+  frameProcessorBlockTimeout?: number;
+  /**
+   * The amount of worklet runtimes the Frame Processor runs on. Every runtime has its own thread, so with more than one, Frames are processed in parallel
+   * (one Frame per runtime at a time) and a Frame Processor that takes 100ms can keep up with `10 * frameProcessorRuntimes` Frames per second.
+   *
+   * Every runtime has its own globals, so state kept by the Frame Processor (e.g. an object tracker) is not shared between Frames that run on different runtimes,
+   * and Frames finish out of order (see {@linkcode frameProcessorInOrder}). Each runtime costs memory (and a Camera buffer for the Frame it processes), so don't use more than there are idle CPU cores.
+   *
+   * @platform Android
+   * @default 1
+   */
+  frameProcessorRuntimes?: number;
+  /**
+   * How Frames are spread across the {@linkcode frameProcessorRuntimes}:
+   *
+   * * `'least-loaded'`: The idle runtime that was the fastest recently processes the next Frame.
+   * * `'round-robin'`: The runtimes process Frames in turn. The next Frame waits for its runtime, even if another one is idle.
+   *
+   * @platform Android
+   * @default 'least-loaded'
+   */
+  frameProcessorDispatch?: 'least-loaded' | 'round-robin';
+  /**
+   * If the Frame Processor returns a function, it is called once the Frame Processors of all earlier Frames are done, so results are published in the
+   * order the Frames arrived in - even if they are processed in parallel on multiple {@linkcode frameProcessorRuntimes}.
+   *
+   * The function runs on the same runtime as the Frame Processor that returned it, after the Frame has been released.
+   *
+   * @platform Android
+   * @default false
+   */
+  frameProcessorInOrder?: boolean;
+  /**
+   * The maximum amount of {@linkcode runAsync} tasks that can be queued or running at the same time. While that many are in flight,
+   * `runAsync()` skips new tasks (and returns `false`), so expensive work runs at whatever rate it can sustain instead of building up a backlog of old Frames.
+   *
+   * Every queued task holds on to its Frame, so the Camera allocates one more buffer per task - keep this small, every buffer costs memory.
+   * `runAsync()` is only available if this is at least `1`.
+   *
+   * @platform Android
+   * @default 0
+   */
+  frameProcessorMaxAsyncTasks?: number;
+  /**
+   * The maximum amount of Frames the Frame Processor can retain past its call at the same time, with {@linkcode FrameOld.incrementRefCount | frame.incrementRefCount()}.
+   *
+   * The Camera allocates one more buffer per retained Frame, so retaining Frames never stalls it - keep this small, every buffer costs memory.
+   * Once this many Frames are retained, `incrementRefCount()` throws until one of them is released with `decrementRefCount()`.
+   * Zero-copy ArrayBuffers from `getPlane()` and `toArrayBuffer()` retain their Frame as well, while no Frame can be retained they are copies instead.
+   *
+   * @platform Android
+   * @default 1
+   */
+  frameProcessorMaxRetainedFrames?: number;
   //#endregion
 }
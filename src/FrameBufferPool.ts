@@ -0,0 +1,76 @@
+import { CameraRuntimeError } from './CameraError';
+
+export interface FrameBufferPoolConfig {
+  /**
+   * The maximum amount of bytes idle buffers may hold in total. Buffers released beyond that are freed.
+   *
+   * @default 67108864 (64 MB)
+   */
+  maxBytesHeld?: number;
+  /**
+   * The maximum amount of idle buffers kept per buffer size.
+   *
+   * @default 4
+   */
+  maxBuffersPerSize?: number;
+}
+
+export interface FrameBufferPoolStats {
+  /**
+   * The amount of buffers that were reused from the pool.
+   */
+  hits: number;
+  /**
+   * The amount of buffers that had to be newly allocated.
+   */
+  misses: number;
+  /**
+   * The amount of released buffers that were freed because the pool was full.
+   */
+  evictions: number;
+  /**
+   * The amount of bytes held by idle buffers in the pool.
+   */
+  bytesHeld: number;
+  /**
+   * The amount of bytes of buffers that are currently in use (e.g. by an `ArrayBuffer` returned from {@linkcode FrameOld.toRGB}).
+   */
+  bytesInUse: number;
+  /**
+   * The amount of idle buffers in the pool.
+   */
+  buffersHeld: number;
+}
+
+interface FrameBufferPoolGlobals {
+  getFrameBufferPoolStats?: () => FrameBufferPoolStats;
+  configureFrameBufferPool?: (config: FrameBufferPoolConfig) => void;
+}
+
+function getGlobals(): Required<FrameBufferPoolGlobals> {
+  const globals = global as unknown as FrameBufferPoolGlobals;
+  if (globals.getFrameBufferPoolStats == null || globals.configureFrameBufferPool == null) {
+    throw new CameraRuntimeError(
+      'frame-processor/unavailable',
+      'Frame Processors are not enabled. See https://react-native-vision-camera-old.com/docs/guides/troubleshooting',
+    );
+  }
+  return globals as Required<FrameBufferPoolGlobals>;
+}
+
+/**
+ * Returns the counters of the buffer pool that backs all `ArrayBuffer`s created from Frames
+ * ({@linkcode FrameOld.toArrayBuffer}, {@linkcode FrameOld.toRGB}, {@linkcode FrameOld.toTensor}).
+ *
+ * Buffers return to the pool once their `ArrayBuffer` is garbage collected, so a high `misses` count in a steady state means buffers are kept alive for too long, or the pool's caps are too small.
+ */
+export function getFrameBufferPoolStats(): FrameBufferPoolStats {
+  return getGlobals().getFrameBufferPoolStats();
+}
+
+/**
+ * Configures the caps of the Frame buffer pool. Idle buffers that exceed the new caps are freed immediately.
+ */
+export function configureFrameBufferPool(config: FrameBufferPoolConfig): void {
+  getGlobals().configureFrameBufferPool(config);
+}
@@ -1,9 +1,147 @@
+/**
+ * A single plane of a frame's pixel data.
+ */
+export interface FramePlane {
+  /**
+   * The plane's pixel data. This is a zero-copy view into the Camera's memory, which keeps the frame open until it is garbage collected.
+   */
+  buffer: ArrayBuffer;
+  /**
+   * The amount of bytes between the start of two consecutive rows.
+   */
+  rowStride: number;
+  /**
+   * The amount of bytes between two consecutive pixels in a row.
+   */
+  pixelStride: number;
+}
+
+/**
+ * The pixel layout of the buffer returned by {@linkcode FrameOld.toRGB}.
+ */
+export type RGBFormat = 'rgb' | 'rgba' | 'bgr' | 'bgra';
+
+export interface ToRGBOptions {
+  /**
+   * The channel order of each pixel.
+   *
+   * @default 'rgb'
+   */
+  format?: RGBFormat;
+}
+
+/**
+ * A rectangle in frame pixels.
+ */
+export interface FrameRect {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+export interface LumaStatisticsOptions {
+  /**
+   * Whether to count the luma values into a 256 bin histogram.
+   *
+   * @default false
+   */
+  histogram?: boolean;
+  /**
+   * Splits the frame into a grid of `columns` x `rows` cells, and computes the mean and variance of every cell.
+   */
+  grid?: { columns: number; rows: number };
+  /**
+   * Whether to compute the variance of the Laplacian, a measure of how sharp (in focus and not motion blurred) the frame is.
+   *
+   * @default false
+   */
+  sharpness?: boolean;
+}
+
+export interface LumaStatistics {
+  /**
+   * The mean luma value of the frame, from 0 to 255.
+   */
+  mean: number;
+  /**
+   * The variance of the luma values, a measure of the frame's contrast.
+   */
+  variance: number;
+  /**
+   * How many pixels have each luma value, if {@linkcode LumaStatisticsOptions.histogram} was requested.
+   */
+  histogram?: Uint32Array;
+  /**
+   * The mean and variance of every grid cell, row by row, if {@linkcode LumaStatisticsOptions.grid} was requested.
+   */
+  grid?: { columns: number; rows: number; mean: Float32Array; variance: Float32Array };
+  /**
+   * The variance of the Laplacian, if {@linkcode LumaStatisticsOptions.sharpness} was requested. Higher values are sharper.
+   * The value depends on the scene's content, so compare it between frames of the same scene instead of against a fixed threshold.
+   */
+  sharpness?: number;
+}
+
+export interface TensorOptions {
+  /**
+   * The width of the tensor, in pixels.
+   */
+  width: number;
+  /**
+   * The height of the tensor, in pixels.
+   */
+  height: number;
+  /**
+   * The region of the frame to use, in frame pixels. Defaults to the whole frame.
+   */
+  crop?: FrameRect;
+  /**
+   * The memory layout of the tensor, either `[height][width][channels]` (`NHWC`) or `[channels][height][width]` (`NCHW`).
+   *
+   * @default 'NHWC'
+   */
+  layout?: 'NHWC' | 'NCHW';
+  /**
+   * The type of each value in the tensor. `uint8` and `int8` values are rounded and clamped to their range after normalization.
+   *
+   * @default 'float32'
+   */
+  dtype?: 'float32' | 'uint8' | 'int8';
+  /**
+   * The order of the 3 channels.
+   *
+   * @default 'rgb'
+   */
+  format?: 'rgb' | 'bgr';
+  /**
+   * How the frame is scaled to the tensor's size. Defaults to `area` when downscaling by a factor of 2 or more, and to `bilinear` otherwise.
+   */
+  resize?: 'bilinear' | 'area';
+  /**
+   * Every channel value (0...255) is normalized to `(value - mean) / std`.
+   * Either a single number for all channels, or one number per channel (in the order of `format`).
+   *
+   * @default 0
+   */
+  mean?: number | [number, number, number];
+  /**
+   * @see {@linkcode mean}
+   * @default 1
+   */
+  std?: number | [number, number, number];
+  /**
+   * An `ArrayBuffer` to write the tensor into instead of allocating a new one. It must be at least `width * height * 3 * bytesPerElement` bytes large.
+   */
+  output?: ArrayBuffer;
+}
+
 /**
  * A single frame, as seen by the camera.
  */
 export interface FrameOld {
   /**
-   * Whether the underlying buffer is still valid or not. The buffer will be released after the frame processor returns, or `close()` is called.
+   * Whether the underlying buffer is still valid or not. The buffer will be released after the frame processor returns and all references acquired with `incrementRefCount()` have been released, or `close()` is called.
    */
   isValid: boolean;
   /**
@@ -23,6 +161,99 @@ export interface FrameOld {
    */
   planesCount: number;
 
+  /**
+   * Returns the plane at the given index without copying its pixel data.
+   *
+   * The returned {@linkcode FramePlane.buffer} points directly into the Camera's memory. It retains the frame (like {@linkcode incrementRefCount}),
+   * so the frame is only closed - and its memory given back to the Camera - once the buffer has been garbage collected. Don't keep planes around for longer
+   * than you need them, the Camera stalls once all of its buffers are held. Writing to the buffer modifies the frame.
+   * If no more frames can be retained (see {@linkcode CameraProps.frameProcessorMaxRetainedFrames}), the buffer is a copy instead.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   const yPlane = frame.getPlane(0)
+   *   const luma = new Uint8Array(yPlane.buffer)
+   *   const centerLuma = luma[(frame.height / 2) * yPlane.rowStride + (frame.width / 2) * yPlane.pixelStride]
+   * }, [])
+   * ```
+   */
+  getPlane(planeIndex: number): FramePlane;
+  /**
+   * Returns the pixel data of all planes back-to-back in one `ArrayBuffer`.
+   *
+   * If the planes already are back-to-back in memory, the buffer points directly into the Camera's memory and retains the frame until it is
+   * garbage collected, like {@linkcode getPlane}. Otherwise (e.g. Android's interleaved U/V planes) the planes are copied into a new buffer.
+   */
+  toArrayBuffer(): ArrayBuffer;
+  /**
+   * Converts the frame to tightly packed 8-bit RGB(A) pixels (`width * height * 3` or `* 4` bytes) and returns them in a new `ArrayBuffer`.
+   *
+   * YUV frames are converted natively with SIMD (NEON/SSE4.1/AVX2) kernels using BT.601 coefficients, which is a lot faster than converting them in a plugin.
+   * The returned buffer stays valid after the frame has been closed.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   const pixels = new Uint8Array(frame.toRGB({ format: 'rgba' }))
+   * }, [])
+   * ```
+   */
+  toRGB(options?: ToRGBOptions): ArrayBuffer;
+  /**
+   * Crops, resizes, converts and normalizes the frame into a model input tensor in a single native pass.
+   *
+   * Returns {@linkcode TensorOptions.output} if it was passed, or a new `ArrayBuffer` otherwise.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   const input = new Float32Array(frame.toTensor({ width: 224, height: 224, layout: 'NCHW', mean: 127.5, std: 127.5 }))
+   * }, [])
+   * ```
+   */
+  toTensor(options: TensorOptions): ArrayBuffer;
+  /**
+   * Returns a frame that only covers the given region of this frame, without copying any pixels.
+   *
+   * The cropped frame shares this frame's memory, so {@linkcode getPlane}, {@linkcode toRGB}, {@linkcode toTensor} and Frame Processor Plugins
+   * only process the region. Plugins receive the full native frame with the region as its crop rect (`ImageProxy.getCropRect()` on Android, `FrameOld.cropRect` on iOS).
+   *
+   * For YUV frames, the region's origin is rounded down to even coordinates so it lines up with the subsampled chroma planes,
+   * so the cropped frame can be up to one pixel larger than `rect`. Use its {@linkcode width} and {@linkcode height} instead of `rect`'s.
+   *
+   * The cropped frame is only valid as long as this frame is. Retaining it with {@linkcode incrementRefCount} retains this frame.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   const center = frame.crop({ x: frame.width / 4, y: frame.height / 4, width: frame.width / 2, height: frame.height / 2 })
+   *   const codes = scanBarcodes(center)
+   * }, [])
+   * ```
+   */
+  crop(rect: FrameRect): FrameOld;
+  /**
+   * Computes statistics of the frame's luma (Y) plane natively, in a single pass over the pixels.
+   *
+   * Use it to skip frames that are too dark or too blurry before running a heavy plugin, or to pick the sharpest frame of a burst.
+   * Only YUV frames are supported. On a cropped frame, only the cropped region is measured.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   const { mean, sharpness } = frame.getLumaStatistics({ sharpness: true })
+   *   if (mean < 30 || sharpness < 50) return // too dark or too blurry
+   *   const labels = labelImage(frame)
+   * }, [])
+   * ```
+   */
+  getLumaStatistics(options?: LumaStatisticsOptions): LumaStatistics;
   /**
    * Returns a string representation of the frame.
    * @example
@@ -31,6 +262,31 @@ export interface FrameOld {
    * ```
    */
   toString(): string;
+  /**
+   * Retains the frame so it stays valid after the frame processor returned, e.g. to hand it to background work.
+   *
+   * Every call must be balanced with a call to {@linkcode decrementRefCount}. The Camera only has a few buffers,
+   * so holding on to frames for too long stalls the Camera - frames that are held for longer than a second are logged.
+   * At most {@linkcode CameraProps.frameProcessorMaxRetainedFrames} frames can be retained at once, beyond that this throws.
+   *
+   * @example
+   * ```ts
+   * const frameProcessor = useFrameProcessor((frame) => {
+   *   'worklet'
+   *   frame.incrementRefCount()
+   *   runInBackground(() => {
+   *     'worklet'
+   *     detectFaces(frame)
+   *     frame.decrementRefCount()
+   *   })
+   * }, [])
+   * ```
+   */
+  incrementRefCount(): void;
+  /**
+   * Releases a reference acquired with {@linkcode incrementRefCount}. The frame is closed as soon as its last reference has been released.
+   */
+  decrementRefCount(): void;
   /**
    * Closes and disposes the Frame.
    * Only close frames that you have created yourself, e.g. by copying the frame you receive in a frame processor.
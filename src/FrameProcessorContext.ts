@@ -1,4 +1,5 @@
 let workletRuntime = null
+let createWorkletRuntime = null
 let createWorklet = () => {
   throw new Error("Reanimated V3 is not installed, Frame Processors are not available!")
 }
@@ -9,12 +10,40 @@ try {
     console.warn("Frame Processors are disabled because you're using an incompatible version of Reanimated.")
   }
   workletRuntime = reanimated.createWorkletRuntime('VisionCameraOld')
+  createWorkletRuntime = reanimated.createWorkletRuntime
   createWorklet = reanimated.makeShareableCloneRecursive
 } catch {
   // Frame Processors are not enabled
 }
 
+// runtimes are created once and kept, like the default one. Creating a runtime is expensive.
+const workletRuntimes = workletRuntime != null ? [workletRuntime] : []
+
+/**
+ * Returns `count` worklet runtimes for a Frame Processor that processes Frames in parallel (see `frameProcessorRuntimes`).
+ */
+const getWorkletRuntimes = (count) => {
+  while (workletRuntimes.length < count) {
+    workletRuntimes.push(createWorkletRuntime(`VisionCameraOld ${workletRuntimes.length + 1}`))
+  }
+  return workletRuntimes.slice(0, count)
+}
+
+let asyncWorkletRuntime = null
+
+/**
+ * Returns the background worklet runtime `runAsync()` runs on, and creates it the first time.
+ */
+const getAsyncWorkletRuntime = () => {
+  if (asyncWorkletRuntime == null && createWorkletRuntime != null) {
+    asyncWorkletRuntime = createWorkletRuntime('VisionCameraOld Async')
+  }
+  return asyncWorkletRuntime
+}
+
 export const FrameProcessorContext = {
   workletRuntime: workletRuntime,
+  getWorkletRuntimes: getWorkletRuntimes,
+  getAsyncWorkletRuntime: getAsyncWorkletRuntime,
   createWorklet: createWorklet
 }
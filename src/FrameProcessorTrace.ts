@@ -0,0 +1,60 @@
+import { CameraRuntimeError } from './CameraError';
+
+/**
+ * The format of an exported Frame Processor trace.
+ *
+ * * `"chrome"`: A JSON string in the Chrome trace event format, can be opened in `chrome://tracing` or https://ui.perfetto.dev
+ * * `"perfetto"`: An `ArrayBuffer` containing a Perfetto protobuf trace (`perfetto.protos.Trace`), can be opened in https://ui.perfetto.dev
+ */
+export type FrameProcessorTraceFormat = 'chrome' | 'perfetto';
+
+interface FrameProcessorTraceGlobals {
+  startFrameProcessorTrace?: () => void;
+  stopFrameProcessorTrace?: () => void;
+  getFrameProcessorTrace?: (format: FrameProcessorTraceFormat) => string | ArrayBuffer;
+}
+
+function getGlobals(): Required<FrameProcessorTraceGlobals> {
+  const globals = global as unknown as FrameProcessorTraceGlobals;
+  if (globals.startFrameProcessorTrace == null || globals.stopFrameProcessorTrace == null || globals.getFrameProcessorTrace == null) {
+    throw new CameraRuntimeError(
+      'frame-processor/unavailable',
+      'Frame Processors are not enabled. See https://react-native-vision-camera-old.com/docs/guides/troubleshooting',
+    );
+  }
+  return globals as Required<FrameProcessorTraceGlobals>;
+}
+
+/**
+ * Starts recording a trace of every stage of the Frame Processor pipeline (Camera callback, Frame creation, worklet execution,
+ * each plugin call, argument/result conversion and closing the Frame). Spans that were recorded before are discarded.
+ *
+ * Every thread keeps the last few thousand spans, so stop the trace shortly after reproducing the issue.
+ */
+export function startFrameProcessorTrace(): void {
+  getGlobals().startFrameProcessorTrace();
+}
+
+/**
+ * Stops recording the Frame Processor trace. The recorded spans can still be exported with {@linkcode getFrameProcessorTrace}.
+ */
+export function stopFrameProcessorTrace(): void {
+  getGlobals().stopFrameProcessorTrace();
+}
+
+/**
+ * Exports the spans recorded since {@linkcode startFrameProcessorTrace} was called.
+ *
+ * @example
+ * ```ts
+ * startFrameProcessorTrace()
+ * await sleep(5000)
+ * stopFrameProcessorTrace()
+ * const json = getFrameProcessorTrace('chrome')
+ * ```
+ */
+export function getFrameProcessorTrace(format: 'chrome'): string;
+export function getFrameProcessorTrace(format: 'perfetto'): ArrayBuffer;
+export function getFrameProcessorTrace(format: FrameProcessorTraceFormat = 'chrome'): string | ArrayBuffer {
+  return getGlobals().getFrameProcessorTrace(format);
+}
@@ -1,7 +1,8 @@
 import { DependencyList, useCallback } from 'react';
 import type { FrameOld } from '../FrameOld';
 
-type FrameProcessor = (frame: FrameOld) => void;
+// a Frame Processor may return a function to publish its results in Frame order, see `frameProcessorInOrder`
+type FrameProcessor = (frame: FrameOld) => void | (() => void);
 
 /**
  * Returns a memoized Frame Processor function wich you can pass to the `<Camera>`. (See ["Frame Processors"](https://react-native-vision-camera-old.com/docs/guides/frame-processors))
@@ -23,7 +24,7 @@ type FrameProcessor = (frame: FrameOld) => void;
 export function useFrameProcessor(frameProcessor: FrameProcessor, dependencies: DependencyList): FrameProcessor {
   return useCallback((frame: FrameOld) => {
     'worklet';
-    frameProcessor(frame);
+    return frameProcessor(frame);
     // eslint-disable-next-line react-hooks/exhaustive-deps
   }, dependencies);
 }
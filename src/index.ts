@@ -4,13 +4,17 @@ export * from './CameraError';
 export * from './CameraPosition';
 export * from './CameraPreset';
 export * from './CameraProps';
+export * from './FrameBufferPool';
 export * from './FrameOld';
+export * from './FrameProcessorTrace';
 export * from './CameraProps';
 export * from './PhotoFile';
 export * from './Point';
 export * from './Snapshot';
 export * from './TemporaryFile';
 export * from './VideoFile';
+export * from './runAsync';
+export * from './runParallel';
 
 export * from './hooks/useCameraDevices';
 export * from './hooks/useCameraFormat';
@@ -0,0 +1,47 @@
+import type { FrameOld } from './FrameOld';
+
+let makeShareableCloneOnUIRecursive: ((value: unknown) => unknown) | undefined;
+try {
+  makeShareableCloneOnUIRecursive = require('react-native-reanimated').makeShareableCloneOnUIRecursive;
+} catch {
+  // Frame Processors are not enabled
+}
+
+interface RunAsyncGlobals {
+  __runAsync?: (frame: FrameOld, createWorklet: () => unknown) => boolean;
+}
+
+/**
+ * Runs `func` with the given Frame on a background thread, and returns right away. Call this from inside a Frame Processor
+ * to keep cheap per-Frame work (e.g. tracking) at the Camera's frame rate, while expensive work (e.g. OCR) runs at whatever rate it can sustain.
+ *
+ * `func` must be a worklet. It runs on a separate worklet runtime (so it does not share globals with the Frame Processor), one task after another.
+ * The Frame stays valid until `func` returned.
+ *
+ * At most {@linkcode CameraProps.frameProcessorMaxAsyncTasks} tasks can be queued or running at the same time, further calls are skipped.
+ *
+ * @platform Android
+ * @returns `true` if the task was started, or `false` if it was skipped because too many tasks are still in flight.
+ * @example
+ * ```ts
+ * const frameProcessor = useFrameProcessor((frame) => {
+ *   'worklet'
+ *   trackObjects(frame)
+ *   runAsync(frame, (frame) => {
+ *     'worklet'
+ *     const text = scanText(frame)
+ *     runOnJS(setText)(text)
+ *   })
+ * }, [])
+ * ```
+ */
+export function runAsync(frame: FrameOld, func: (frame: FrameOld) => void): boolean {
+  'worklet';
+  const globals = global as unknown as RunAsyncGlobals;
+  if (globals.__runAsync == null || makeShareableCloneOnUIRecursive == null) {
+    throw new Error('runAsync() is not available! It requires Frame Processors (Reanimated 3) on Android.');
+  }
+  const makeShareable = makeShareableCloneOnUIRecursive;
+  // the worklet is only made shareable if the task is not skipped
+  return globals.__runAsync(frame, () => makeShareable(func));
+}
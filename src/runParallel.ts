@@ -0,0 +1,39 @@
+import type { FrameOld } from './FrameOld';
+
+/**
+ * A Frame Processor Plugin call in {@linkcode runParallel}: the plugin's name (without the `__` prefix), or its name followed by the arguments after the Frame.
+ */
+export type ParallelPluginCall = string | [name: string, ...args: unknown[]];
+
+interface RunParallelGlobals {
+  __runParallel?: (frame: FrameOld, plugins: ParallelPluginCall[]) => Record<string, unknown>;
+}
+
+/**
+ * Calls multiple Frame Processor Plugins with the same Frame at the same time, and returns their results keyed by plugin name.
+ * The Frame then takes as long as its slowest plugin, instead of all of them combined.
+ *
+ * Java and C++ plugins (if they implement `prepareParallelCall`) run on a pool of background threads.
+ * Every other plugin is called on the Frame Processor thread while they run.
+ * Each plugin can only be called once per `runParallel`.
+ *
+ * @returns The result of each plugin, keyed by its name. If a plugin throws, `runParallel` throws its error once all plugins returned.
+ * @example
+ * ```ts
+ * const frameProcessor = useFrameProcessor((frame) => {
+ *   'worklet'
+ *   const { scanCodes, detectFaces } = runParallel(frame, [
+ *     ['scanCodes', { formats: ['qr'] }],
+ *     'detectFaces',
+ *   ])
+ * }, [])
+ * ```
+ */
+export function runParallel(frame: FrameOld, plugins: ParallelPluginCall[]): Record<string, unknown> {
+  'worklet';
+  const globals = global as unknown as RunParallelGlobals;
+  if (globals.__runParallel == null) {
+    throw new Error('runParallel() is not available! It can only be called inside a Frame Processor.');
+  }
+  return globals.__runParallel(frame, plugins);
+}